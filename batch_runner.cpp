@@ -0,0 +1,204 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include "batch_runner.hpp"
+#include "binary_format.hpp"
+#include "bounded_queue.hpp"
+#include "result_sink.hpp"
+#include "system_solver.hpp"
+#include "matrix.hpp"
+#include "utils.hpp"
+
+namespace {
+    /**
+     * Struct representing loaded input waiting for the solving job.
+     */
+    struct BatchTask {
+        size_t index;
+        std::unique_ptr<Matrix> matrix;
+        std::unique_ptr<SparseMatrix> sparse;
+        std::string error;
+    };
+
+    std::string get_file_name(const std::string &path) {
+        size_t slash = path.find_last_of('/');
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    std::string join_path(const std::string &directory, const std::string &file) {
+        if (directory.empty() || directory.back() == '/') {
+            return directory + file;
+        }
+        return directory + "/" + file;
+    }
+}
+
+bool BatchRunner::parse_arguments(int argc, char **argv, BatchSettings &settings) {
+    bool batch = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument(argv[i]);
+        if (argument != "--batch" && argument != "--jobs" && argument != "--out") {
+            throw std::domain_error("Unknown argument " + argument + ".");
+        }
+        if (i + 1 == argc) {
+            throw std::domain_error("Missing value of the argument " + argument + ".");
+        }
+        std::string value(argv[++i]);
+        if (argument == "--batch") {
+            settings.inputs.push_back(value);
+            batch = true;
+        } else if (argument == "--out") {
+            settings.output_directory = value;
+        } else {
+            try {
+                settings.jobs = std::stoi(value);
+            } catch (std::exception &e) {
+                settings.jobs = 0;
+            }
+            if (settings.jobs < 1) {
+                throw std::domain_error("Number of jobs has to be positive integer.");
+            }
+        }
+    }
+    return batch;
+}
+
+std::vector<std::string> BatchRunner::collect_files(const BatchSettings &settings) {
+    std::vector<std::string> files;
+    for (const std::string &input : settings.inputs) {
+        if (FileReader::is_directory(input)) {
+            for (const std::string &file : FileReader::list_files(input)) {
+                files.push_back(join_path(input, file));
+            }
+        } else {
+            files.push_back(input);
+        }
+    }
+    return files;
+}
+
+std::vector<BatchFileResult> BatchRunner::run(std::ostream &ostream, const BatchSettings &settings) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::string> files = collect_files(settings);
+    FileReader::create_directory(settings.output_directory);
+
+    // output files are named after the inputs, same names from different directories get the index appended
+    std::vector<BatchFileResult> results(files.size());
+    std::set<std::string> output_names;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string name = get_file_name(files[i]) + ".out";
+        if (!output_names.insert(name).second) {
+            name = get_file_name(files[i]) + "_" + std::to_string(i) + ".out";
+            output_names.insert(name);
+        }
+        results[i] = {files[i], join_path(settings.output_directory, name), false, "", 0, 0};
+    }
+
+    ostream << "Solving " << files.size() << " systems with " << settings.jobs << " jobs." << std::endl;
+
+    // the systems are solved concurrently, each of them with one thread
+    SolverContext context = settings.context;
+    context.thread_count = 1;
+
+    BoundedQueue<BatchTask> queue(static_cast<size_t>(settings.jobs) * BATCH_QUEUE_SLOTS_PER_JOB);
+    std::mutex output_mutex;
+    size_t finished = 0;
+
+    auto solve_tasks = [&]() {
+        BatchTask task;
+        while (queue.pop(task)) {
+            BatchFileResult &result = results[task.index];
+            std::ofstream out(result.output_path, std::ios::binary);
+            if (!out) {
+                result.error = "failed to create output file";
+            } else if (!task.matrix && !task.sparse) {
+                result.error = task.error;
+                out << "An exception occurred: " << task.error << std::endl;
+            } else {
+                auto solve_start = std::chrono::high_resolution_clock::now();
+                try {
+                    std::unique_ptr<ResultSink> sink = ResultSink::create(context.output_level, out);
+                    if (task.sparse) {
+                        SystemSolver::solve_with_method(*sink, *task.sparse, context);
+                    } else {
+                        SystemSolver::solve_with_method(*sink, *task.matrix, context);
+                    }
+                    result.succeeded = true;
+                } catch (std::exception &e) {
+                    result.error = e.what();
+                    out << "An exception occurred: " << e.what() << std::endl;
+                }
+                result.solve_ms = to_ms(std::chrono::high_resolution_clock::now() - solve_start).count();
+            }
+            task.matrix.reset();
+            task.sparse.reset();
+
+            std::lock_guard<std::mutex> lock(output_mutex);
+            ++finished;
+            ostream << "[" << finished << "/" << files.size() << "] " << result.input_path
+                    << (result.succeeded ? " solved" : " failed: " + result.error) << std::endl;
+        }
+    };
+
+    std::vector<std::thread> jobs;
+    for (int i = 0; i < settings.jobs; ++i) {
+        jobs.emplace_back(solve_tasks);
+    }
+
+    // load the files in this thread, the queue blocks when the jobs fall behind
+    for (size_t i = 0; i < files.size(); ++i) {
+        BatchTask task{i, nullptr, nullptr, ""};
+        auto load_start = std::chrono::high_resolution_clock::now();
+        try {
+            if (!BinaryMatrixFile::is_binary_path(files[i])) {
+                task.matrix.reset(new Matrix(MatrixCreator::parse_from_txt_file(files[i])));
+            } else if (BinaryMatrixFile::read_header(files[i]).storage == StorageType::DENSE) {
+                task.matrix.reset(new Matrix(BinaryMatrixFile::load_dense(files[i])));
+            } else {
+                // sparse files stay sparse, the sparse elimination solves them
+                task.sparse.reset(new SparseMatrix(BinaryMatrixFile::load_sparse(files[i])));
+            }
+        } catch (std::exception &e) {
+            task.error = e.what();
+        }
+        results[i].load_ms = to_ms(std::chrono::high_resolution_clock::now() - load_start).count();
+        queue.push(std::move(task));
+    }
+    queue.close();
+
+    for (std::thread &job : jobs) {
+        job.join();
+    }
+
+    long long total_ms = to_ms(std::chrono::high_resolution_clock::now() - start).count();
+    std::ofstream summary(join_path(settings.output_directory, BATCH_SUMMARY_FILE));
+    print_summary(summary, results, total_ms);
+    print_summary(ostream, results, total_ms);
+
+    return results;
+}
+
+void BatchRunner::print_summary(std::ostream &ostream, const std::vector<BatchFileResult> &results,
+                                long long total_ms) {
+    size_t failed = std::count_if(results.begin(), results.end(),
+                                  [](const BatchFileResult &result) { return !result.succeeded; });
+    ostream << "file\tstatus\tload_ms\tsolve_ms\toutput" << std::endl;
+    for (const BatchFileResult &result : results) {
+        ostream << result.input_path << "\t" << (result.succeeded ? "ok" : "failed") << "\t"
+                << result.load_ms << "\t" << result.solve_ms << "\t" << result.output_path << std::endl;
+    }
+    ostream << "Solved " << results.size() - failed << " of " << results.size() << " systems, "
+            << failed << " failed." << std::endl;
+    ostream << "Needed " << total_ms << " ms to finish." << std::endl;
+}
@@ -0,0 +1,104 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_BATCH_RUNNER_HPP
+#define LINEAR_SYSTEM_SOLVER_BATCH_RUNNER_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "solver_context.hpp"
+
+/**
+ * Constant representing number of loaded systems waiting in the queue per solving job.
+ */
+#define BATCH_QUEUE_SLOTS_PER_JOB 2
+
+/**
+ * Constant representing name of the summary file written to the output directory.
+ */
+#define BATCH_SUMMARY_FILE "summary.txt"
+
+/**
+ * Struct representing settings of the batch mode.
+ */
+struct BatchSettings {
+    /**
+     * Input files or directories, all regular files in the directories are solved. Files with the extension
+     * BINARY_EXTENSION are loaded as binary matrix files, the other as txt files.
+     */
+    std::vector<std::string> inputs;
+    /**
+     * Directory the results are written to, one file per input and the summary.
+     */
+    std::string output_directory = "results";
+    /**
+     * Number of systems solved concurrently.
+     */
+    int jobs = 1;
+    /**
+     * Settings of the solves, the number of threads is ignored since each system is solved with one thread.
+     */
+    SolverContext context;
+};
+
+/**
+ * Struct representing result of one input file of the batch.
+ */
+struct BatchFileResult {
+    std::string input_path;
+    std::string output_path;
+    bool succeeded;
+    std::string error;
+    long long load_ms;
+    long long solve_ms;
+};
+
+/**
+ * Class responsible for solving many linear systems from files without user interaction.
+ * <p>
+ * One thread loads the files into a bounded queue, so at most jobs * BATCH_QUEUE_SLOTS_PER_JOB loaded
+ * systems wait in the memory. Jobs threads take the systems from the queue and solve each of them
+ * with one thread, the systems are independent so the parallelism is across the files.
+ */
+class BatchRunner {
+public:
+    /**
+     * Parses the command line arguments of the batch mode. (--batch PATH [--batch PATH ...] --jobs N --out DIR)
+     *
+     * @param argc number of the arguments
+     * @param argv the arguments, including the program name
+     * @param settings settings to fill in
+     * @return true if the batch mode was requested, throws std::domain_error for invalid arguments
+     */
+    static bool parse_arguments(int argc, char **argv, BatchSettings &settings);
+
+    /**
+     * @param settings settings with the inputs
+     * @return paths of all input files, directories are expanded to the files they contain
+     */
+    static std::vector<std::string> collect_files(const BatchSettings &settings);
+
+    /**
+     * Solves all input files, writes the results and the summary to the output directory.
+     *
+     * @param ostream output stream to write the progress and the summary to
+     * @param settings settings of the batch
+     * @return results of the input files in the order of collect_files
+     */
+    static std::vector<BatchFileResult> run(std::ostream &ostream, const BatchSettings &settings);
+
+    /**
+     * Prints the summary with per-file timings.
+     *
+     * @param ostream output stream to write to
+     * @param results results of the input files
+     * @param total_ms wall time of the whole batch
+     */
+    static void print_summary(std::ostream &ostream, const std::vector<BatchFileResult> &results,
+                              long long total_ms);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_BATCH_RUNNER_HPP
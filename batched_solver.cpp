@@ -0,0 +1,223 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LSS_BATCHED_X86
+#endif
+
+#include "batched_solver.hpp"
+#include "gemm.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+    const int L = BATCHED_LANES;
+
+    /**
+     * Values of one element in all lanes of the block. The vector extension of the compiler turns the operations
+     * into the instructions of the target (one AVX-512, two AVX2 or four SSE2 instructions), the conditions are
+     * turned into masks and selects. The alignment is lowered, so the batch data can be accessed directly.
+     */
+    typedef double Lanes __attribute__((vector_size(L * sizeof(double)), aligned(sizeof(double))));
+
+    /**
+     * Solves one block of BATCHED_LANES systems in place.
+     */
+    typedef void (*BlockKernel)(int n, double *block, double *solution, uint8_t *singular);
+
+    inline __attribute__((always_inline))
+    void solve_block(int n, double *block, double *solution, uint8_t *singular) {
+        const int width = n + 1;
+        Lanes *matrix = reinterpret_cast<Lanes *>(block);
+        Lanes *values = reinterpret_cast<Lanes *>(solution);
+        auto lanes = [matrix, width](int x, int y) -> Lanes & { return matrix[y * width + x]; };
+        const Lanes zero = {};
+        const Lanes one = zero + 1;
+
+        // vector b does not take part, as in LUDecomposer::get_zero_tolerance
+        Lanes max_abs = zero;
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) {
+                const Lanes e = lanes(x, y) < 0 ? -lanes(x, y) : lanes(x, y);
+                max_abs = e > max_abs ? e : max_abs;
+            }
+        }
+        const Lanes tolerance = (n + 1) * std::numeric_limits<double>::epsilon() * max_abs;
+
+        // the pivot rows are kept as doubles, so the masks have the width of the elements
+        Lanes failed = zero;
+        for (int k = 0; k < n; ++k) {
+            Lanes pivot_max = lanes(k, k) < 0 ? -lanes(k, k) : lanes(k, k);
+            Lanes pivot_row = zero + k;
+            for (int y = k + 1; y < n; ++y) {
+                const Lanes e = lanes(k, y) < 0 ? -lanes(k, y) : lanes(k, y);
+                const auto larger = e > pivot_max;
+                pivot_max = larger ? e : pivot_max;
+                pivot_row = larger ? zero + y : pivot_row;
+            }
+            failed = pivot_max <= tolerance ? one : failed;
+
+            // the rows are swapped only in the lanes which chose them, rows chosen by no lane are skipped
+            for (int y = k + 1; y < n; ++y) {
+                const auto swap = pivot_row == y;
+                bool chosen = false;
+                for (int l = 0; l < L; ++l) {
+                    chosen |= swap[l] != 0;
+                }
+                if (!chosen) continue;
+                for (int x = k; x < width; ++x) {
+                    const Lanes a = lanes(x, k);
+                    const Lanes b = lanes(x, y);
+                    lanes(x, k) = swap ? b : a;
+                    lanes(x, y) = swap ? a : b;
+                }
+            }
+
+            // failed lanes get zero multipliers, so their matrices stay as they are
+            const auto active = failed == 0;
+            const Lanes pivot = active ? lanes(k, k) : one;
+            for (int y = k + 1; y < n; ++y) {
+                const Lanes multiplier = active ? lanes(k, y) / pivot : zero;
+                for (int x = k + 1; x < width; ++x) {
+                    lanes(x, y) -= multiplier * lanes(x, k);
+                }
+            }
+        }
+
+        for (int k = n - 1; k >= 0; --k) {
+            Lanes sum = lanes(n, k);
+            for (int x = k + 1; x < n; ++x) {
+                sum -= lanes(x, k) * values[x];
+            }
+            values[k] = sum / (failed == 0 ? lanes(k, k) : one);
+        }
+
+        const Lanes nan = zero + std::numeric_limits<double>::quiet_NaN();
+        for (int i = 0; i < n; ++i) {
+            values[i] = failed == 0 ? values[i] : nan;
+        }
+        for (int l = 0; l < L; ++l) {
+            singular[l] = static_cast<uint8_t>(failed[l] != 0);
+        }
+    }
+
+    __attribute__((flatten))
+    void scalar_kernel(int n, double *block, double *solution, uint8_t *singular) {
+        solve_block(n, block, solution, singular);
+    }
+
+#ifdef LSS_BATCHED_X86
+
+    __attribute__((target("avx2,fma"), flatten))
+    void avx2_kernel(int n, double *block, double *solution, uint8_t *singular) {
+        solve_block(n, block, solution, singular);
+    }
+
+    __attribute__((target("avx512f"), flatten))
+    void avx512_kernel(int n, double *block, double *solution, uint8_t *singular) {
+        solve_block(n, block, solution, singular);
+    }
+
+#endif
+
+    BlockKernel get_block_kernel() {
+#ifdef LSS_BATCHED_X86
+        switch (GemmEngine::get_kernel()) {
+            case GemmKernel::AVX512:
+                return &avx512_kernel;
+            case GemmKernel::AVX2:
+                return &avx2_kernel;
+            default:
+                break;
+        }
+#endif
+        return &scalar_kernel;
+    }
+}
+
+SystemBatch::SystemBatch(int unknowns, int count) : unknowns(unknowns), count(count) {
+    if (unknowns < 1 || count < 0) {
+        throw std::domain_error("Batch needs at least one unknown and non-negative number of systems.");
+    }
+    data.assign(static_cast<size_t>(get_block_count()) * unknowns * (unknowns + 1) * L, 0.0);
+}
+
+int SystemBatch::get_block_count() const {
+    return (count + L - 1) / L;
+}
+
+double &SystemBatch::field(int x, int y, int system) {
+    size_t block = static_cast<size_t>(system / L) * unknowns * (unknowns + 1);
+    return data[(block + static_cast<size_t>(y) * (unknowns + 1) + x) * L + system % L];
+}
+
+const double &SystemBatch::field(int x, int y, int system) const {
+    size_t block = static_cast<size_t>(system / L) * unknowns * (unknowns + 1);
+    return data[(block + static_cast<size_t>(y) * (unknowns + 1) + x) * L + system % L];
+}
+
+void SystemBatch::set_system(int system, const Matrix &matrix) {
+    if (matrix.width != unknowns + 1 || matrix.height != unknowns) {
+        throw std::domain_error("Matrix " + std::to_string(matrix.width) + "x" + std::to_string(matrix.height)
+                                + " does not belong to the batch of systems with " + std::to_string(unknowns)
+                                + " unknowns.");
+    }
+    for (int y = 0; y < unknowns; ++y) {
+        for (int x = 0; x < unknowns + 1; ++x) {
+            field(x, y, system) = matrix.field(x, y);
+        }
+    }
+}
+
+double BatchedSolution::get(int i, int system) const {
+    return solutions[(static_cast<size_t>(system / L) * unknowns + i) * L + system % L];
+}
+
+std::vector<double> BatchedSolution::get_solution(int system) const {
+    std::vector<double> solution(unknowns);
+    for (int i = 0; i < unknowns; ++i) {
+        solution[i] = get(i, system);
+    }
+    return solution;
+}
+
+int BatchedSolution::get_singular_count() const {
+    return static_cast<int>(std::count(singular.begin(), singular.end(), 1));
+}
+
+BatchedSolution BatchedSolver::solve(const SystemBatch &batch, int thread_count) {
+    const int n = batch.unknowns;
+    const int blocks = batch.get_block_count();
+    const size_t block_size = static_cast<size_t>(n) * (n + 1) * L;
+
+    BatchedSolution result;
+    result.unknowns = n;
+    result.count = batch.count;
+    result.solutions.resize(static_cast<size_t>(blocks) * n * L);
+    // the padding lanes are flagged as well, they are cut off at the end
+    result.singular.resize(static_cast<size_t>(blocks) * L);
+
+    const BlockKernel kernel = get_block_kernel();
+    auto solve_blocks = [&](int begin, int end) {
+        std::vector<double> scratch(block_size);
+        for (int b = begin; b < end; ++b) {
+            const double *block = batch.data.data() + b * block_size;
+            std::copy(block, block + block_size, scratch.begin());
+            kernel(n, scratch.data(), result.solutions.data() + static_cast<size_t>(b) * n * L,
+                   result.singular.data() + static_cast<size_t>(b) * L);
+        }
+    };
+    if (thread_count <= 1 || blocks <= BATCHED_BLOCKS_PER_TASK) {
+        solve_blocks(0, blocks);
+    } else {
+        ThreadPool::get_shared(thread_count - 1)->parallel_for(0, blocks, BATCHED_BLOCKS_PER_TASK, solve_blocks);
+    }
+    result.singular.resize(batch.count);
+    return result;
+}
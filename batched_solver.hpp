@@ -0,0 +1,124 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_BATCHED_SOLVER_HPP
+#define LINEAR_SYSTEM_SOLVER_BATCHED_SOLVER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "matrix.hpp"
+
+/**
+ * Constant representing number of systems interleaved in one block of the batch. Each operation of the elimination
+ * is done for all systems of the block at once, so the block fills one AVX-512 register, two AVX2 registers
+ * or four SSE2 registers.
+ */
+#define BATCHED_LANES 8
+
+/**
+ * Constant representing number of blocks given to one task when the batch is solved by more threads.
+ */
+#define BATCHED_BLOCKS_PER_TASK 64
+
+/**
+ * Struct representing batch of square systems with the same number of unknowns. The augmented matrices are stored
+ * in structure-of-arrays layout by blocks of BATCHED_LANES systems: the element [x,y] of all systems of the block
+ * is stored contiguously, the elements follow row after row and the blocks follow each other. The last block
+ * is padded by the zero systems.
+ */
+struct SystemBatch {
+    int unknowns;
+    int count;
+    std::vector<double> data;
+
+    /**
+     * Creates batch filled with zeros.
+     *
+     * @param unknowns number of unknowns (and equations) of each system
+     * @param count number of the systems
+     */
+    SystemBatch(int unknowns, int count);
+
+    /**
+     * @return number of the blocks of BATCHED_LANES systems
+     */
+    int get_block_count() const;
+
+    /**
+     * @param x index of the column in which the field is (zero based)
+     * @param y index of the row in which the field is (zero based)
+     * @param system index of the system (zero based)
+     * @return reference to element on [x,y] coords in the augmented matrix of the system
+     */
+    double &field(int x, int y, int system);
+
+    const double &field(int x, int y, int system) const;
+
+    /**
+     * Copies the augmented matrix into the batch.
+     *
+     * @param system index of the system (zero based)
+     * @param matrix augmented matrix with unknowns + 1 columns and unknowns rows,
+     * throws std::domain_error for other dimensions
+     */
+    void set_system(int system, const Matrix &matrix);
+};
+
+/**
+ * Struct representing solutions of the batch in the same blocked layout, the element i of the solutions
+ * of the block is stored contiguously.
+ */
+struct BatchedSolution {
+    int unknowns;
+    int count;
+    std::vector<double> solutions;
+    /**
+     * 1 for the systems with singular (or nearly singular) matrix A, their solution is NaN.
+     */
+    std::vector<uint8_t> singular;
+
+    /**
+     * @param i index of the unknown (zero based)
+     * @param system index of the system (zero based)
+     * @return value of the unknown in the solution of the system
+     */
+    double get(int i, int system) const;
+
+    /**
+     * @param system index of the system (zero based)
+     * @return solution of the system
+     */
+    std::vector<double> get_solution(int system) const;
+
+    /**
+     * @return number of the singular systems
+     */
+    int get_singular_count() const;
+};
+
+/**
+ * Class responsible for solving many small square systems at once.
+ * <p>
+ * Each block of the batch is eliminated with partial pivoting in the vector lanes, one lane per system. Every
+ * lane chooses its own pivot, the rows are swapped only in the lanes which chose them (by selecting instead
+ * of branching) and the lanes with the pivot under the tolerance of LUDecomposer are masked out of the updates
+ * and flagged as singular. The regular systems therefore get the same pivots as by the general elimination.
+ * The operations on the lanes are compiled for AVX-512 and AVX2 and the instruction set selected for GemmEngine
+ * is used, these kernels fuse the multiply-adds, so the solutions can differ from the general ones in the last bits.
+ */
+class BatchedSolver {
+public:
+    /**
+     * Solves all systems of the batch, the singular systems are only flagged, the general solver has to be used
+     * to find their kernel.
+     *
+     * @param batch batch of the systems
+     * @param thread_count number of threads the blocks are split among
+     * @return BatchedSolution with the solutions and the singularity flags
+     */
+    static BatchedSolution solve(const SystemBatch &batch, int thread_count = 1);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_BATCHED_SOLVER_HPP
@@ -0,0 +1,524 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include "batched_solver.hpp"
+#include "benchmark.hpp"
+#include "fixed_matrix.hpp"
+#include "gemm.hpp"
+#include "lu_decomposition.hpp"
+#include "qr_decomposition.hpp"
+#include "result_sink.hpp"
+#include "system_solver.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+    /**
+     * Stream buffer dropping everything written to it, so the solver still formats its whole output.
+     */
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override {
+            return c;
+        }
+
+        std::streamsize xsputn(const char *, std::streamsize count) override {
+            return count;
+        }
+    };
+
+    /**
+     * Runs the operation repetitions + 1 times, the first run is not recorded. Prepare is called before
+     * each run outside of the measured time and its result is passed to the operation.
+     */
+    template<typename Prepare, typename Operation>
+    std::vector<double> measure(int repetitions, Prepare &&prepare, Operation &&operation) {
+        std::vector<double> times_ms;
+        for (int i = 0; i <= repetitions; ++i) {
+            auto input = prepare();
+            auto start = std::chrono::high_resolution_clock::now();
+            operation(input);
+            auto end = std::chrono::high_resolution_clock::now();
+            if (i > 0) {
+                times_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            }
+        }
+        return times_ms;
+    }
+
+    std::vector<double> sorted(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    std::vector<std::string> split(const std::string &value) {
+        std::vector<std::string> parts;
+        std::stringstream stream(value);
+        std::string part;
+        while (std::getline(stream, part, ',')) {
+            if (!part.empty()) parts.push_back(part);
+        }
+        return parts;
+    }
+
+    int parse_positive(const std::string &argument, const std::string &value) {
+        int number = 0;
+        try {
+            number = std::stoi(value);
+        } catch (std::exception &e) {
+            number = 0;
+        }
+        if (number < 1) {
+            throw std::domain_error("Value of the argument " + argument + " has to be positive integer.");
+        }
+        return number;
+    }
+
+    /**
+     * Fills the matrix with random elements from [-1, 1].
+     */
+    void fill_random(Matrix &matrix, std::mt19937_64 &generator) {
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        for (size_t i = 0; i < matrix.size(); ++i) {
+            matrix.data[i] = distribution(generator);
+        }
+    }
+
+    /**
+     * Counts operations of the elimination with the given pivots, the elements below each pivot are divided by it
+     * and the rows below are updated right of the pivot column.
+     */
+    double count_lu_flops(int width, int height, const std::vector<int> &pivots_columns) {
+        double flops = 0;
+        for (size_t k = 0; k < pivots_columns.size(); ++k) {
+            double rows_below = height - static_cast<double>(k) - 1;
+            flops += rows_below * (1 + 2.0 * (width - pivots_columns[k] - 1));
+        }
+        return flops;
+    }
+
+    /**
+     * Counts operations of the backward substitution of one right-hand side.
+     */
+    double count_substitution_flops(int unknowns, const std::vector<int> &pivots_columns) {
+        double flops = 0;
+        for (int pivot_column : pivots_columns) {
+            flops += 1 + 2.0 * (unknowns - pivot_column - 1);
+        }
+        return flops;
+    }
+
+    /**
+     * Counts operations of the QR decomposition with column pivoting, the decomposition of [R11 R12]^T
+     * and the computation of the kernel basis.
+     */
+    double count_qr_flops(int rows, int unknowns, int rank) {
+        double flops = 0;
+        for (int k = 0; k < rank; ++k) {
+            flops += 4.0 * (rows - k) * (unknowns - k);
+            if (rank < unknowns) {
+                flops += 4.0 * (unknowns - k) * (rank - k);
+            }
+        }
+        return flops + 4.0 * unknowns * (unknowns - rank) * rank;
+    }
+
+    /**
+     * Writes the number to JSON, values that are not finite are written as null.
+     */
+    std::string to_json_number(double value) {
+        if (!std::isfinite(value)) {
+            return "null";
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        return buffer;
+    }
+}
+
+double BenchmarkResult::get_median_ms() const {
+    std::vector<double> times = sorted(times_ms);
+    size_t middle = times.size() / 2;
+    return times.size() % 2 == 1 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+}
+
+double BenchmarkResult::get_p99_ms() const {
+    // nearest rank, with less than 100 runs it is the slowest run
+    std::vector<double> times = sorted(times_ms);
+    auto rank = static_cast<size_t>(std::ceil(0.99 * times.size()));
+    return times[std::max<size_t>(rank, 1) - 1];
+}
+
+double BenchmarkResult::get_min_ms() const {
+    return *std::min_element(times_ms.begin(), times_ms.end());
+}
+
+double BenchmarkResult::get_gflops() const {
+    return flops / (get_median_ms() * 1e6);
+}
+
+double BenchmarkResult::get_gbps() const {
+    return bytes / (get_median_ms() * 1e6);
+}
+
+double BenchmarkResult::get_systems_per_second() const {
+    return systems / (get_median_ms() * 1e-3);
+}
+
+BenchmarkSettings Benchmark::parse_arguments(int argc, char **argv) {
+    BenchmarkSettings settings;
+    settings.threads = ThreadPool::get_hardware_threads();
+    for (int i = 1; i < argc; ++i) {
+        std::string argument(argv[i]);
+        if (argument != "--sizes" && argument != "--shapes" && argument != "--batch-sizes" &&
+            argument != "--batch-count" && argument != "--repetitions" && argument != "--threads" &&
+            argument != "--out") {
+            throw std::domain_error("Unknown argument " + argument + ".");
+        }
+        if (i + 1 == argc) {
+            throw std::domain_error("Missing value of the argument " + argument + ".");
+        }
+        std::string value(argv[++i]);
+        if (argument == "--sizes") {
+            settings.sizes.clear();
+            for (const std::string &size : split(value)) {
+                settings.sizes.push_back(parse_positive(argument, size));
+            }
+        } else if (argument == "--shapes") {
+            std::vector<BenchmarkShape> all_shapes = BenchmarkSettings().shapes;
+            settings.shapes.clear();
+            for (const std::string &name : split(value)) {
+                auto shape = std::find_if(all_shapes.begin(), all_shapes.end(),
+                                          [&name](const BenchmarkShape &s) { return get_shape_name(s) == name; });
+                if (shape == all_shapes.end()) {
+                    throw std::domain_error("Unknown shape " + name + ".");
+                }
+                settings.shapes.push_back(*shape);
+            }
+        } else if (argument == "--batch-sizes") {
+            settings.batch_sizes.clear();
+            for (const std::string &size : split(value)) {
+                settings.batch_sizes.push_back(parse_positive(argument, size));
+            }
+        } else if (argument == "--batch-count") {
+            settings.batch_count = parse_positive(argument, value);
+        } else if (argument == "--repetitions") {
+            settings.repetitions = parse_positive(argument, value);
+        } else if (argument == "--threads") {
+            settings.threads = parse_positive(argument, value);
+        } else {
+            settings.output_path = value;
+        }
+    }
+    if (settings.sizes.empty() || settings.shapes.empty()) {
+        throw std::domain_error("At least one size and one shape has to be given.");
+    }
+    return settings;
+}
+
+std::string Benchmark::get_shape_name(const BenchmarkShape &shape) {
+    switch (shape) {
+        case BenchmarkShape::SQUARE:
+            return "square";
+        case BenchmarkShape::WIDE:
+            return "wide";
+        case BenchmarkShape::TALL:
+            return "tall";
+        case BenchmarkShape::SINGULAR:
+            return "singular";
+        case BenchmarkShape::INCONSISTENT:
+            return "inconsistent";
+    }
+    return "unknown";
+}
+
+Matrix Benchmark::generate_system(const BenchmarkShape &shape, const int &size, std::mt19937_64 &generator) {
+    int rows = shape == BenchmarkShape::TALL ? 2 * size : size;
+    int unknowns = shape == BenchmarkShape::WIDE ? 2 * size : size;
+
+    Matrix matrix_A(unknowns, rows, false);
+    if (shape == BenchmarkShape::SINGULAR || shape == BenchmarkShape::INCONSISTENT) {
+        // product of rows * rank and rank * unknowns matrices has the given rank
+        int rank = std::max(size / 2, 1);
+        Matrix left(rank, rows, false);
+        Matrix right(unknowns, rank, false);
+        fill_random(left, generator);
+        fill_random(right, generator);
+        GemmEngine::multiply_add(rows, unknowns, rank, 1.0, left.data, rank, right.data, unknowns,
+                                 matrix_A.data, unknowns);
+    } else {
+        fill_random(matrix_A, generator);
+    }
+
+    // consistent systems get b = A * x for random x, the inconsistent one random b
+    std::vector<double> vector_b(rows);
+    if (shape == BenchmarkShape::INCONSISTENT) {
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        for (double &b : vector_b) {
+            b = distribution(generator);
+        }
+    } else {
+        Matrix vector_x(1, unknowns, false);
+        fill_random(vector_x, generator);
+        for (int y = 0; y < rows; ++y) {
+            double value = 0;
+            for (int x = 0; x < unknowns; ++x) {
+                value += matrix_A.field(x, y) * vector_x.data[x];
+            }
+            vector_b[y] = value;
+        }
+    }
+
+    Matrix matrix(unknowns + 1, rows, true);
+    for (int y = 0; y < rows; ++y) {
+        std::copy(&matrix_A.field(0, y), &matrix_A.field(0, y) + unknowns, &matrix.field(0, y));
+        matrix.field(unknowns, y) = vector_b[y];
+    }
+    return matrix;
+}
+
+std::string Benchmark::to_txt(const Matrix &matrix) {
+    std::string text = std::to_string(matrix.width) + " " + std::to_string(matrix.height) + "\n";
+    text.reserve(text.size() + matrix.size() * 24);
+    char buffer[32];
+    for (int y = 0; y < matrix.height; ++y) {
+        for (int x = 0; x < matrix.width; ++x) {
+            int length = std::snprintf(buffer, sizeof(buffer), x == 0 ? "%.17g" : " %.17g", matrix.field(x, y));
+            text.append(buffer, length);
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+void Benchmark::measure_system(const BenchmarkShape &shape, const int &size, const BenchmarkSettings &settings,
+                               std::vector<BenchmarkResult> &results) {
+    std::mt19937_64 generator(BENCHMARK_SEED + size * 8 + static_cast<int>(shape));
+    const Matrix matrix = generate_system(shape, size, generator);
+    const int unknowns = matrix.width - 1;
+    const std::string text = to_txt(matrix);
+    const double matrix_bytes = static_cast<double>(matrix.size()) * sizeof(double);
+    const int repetitions = settings.repetitions;
+
+    // reference decomposition gives the rank and the pivots for counting the operations
+    LUDecomposition reference = LUDecomposer::decompose(matrix);
+    Matrix matrix_U = reference.get_upper();
+    matrix_U.augmented = true;
+    const EchelonStructure &echelon = reference.echelon;
+    const std::vector<int> &pivots_columns = echelon.pivots_columns;
+    const int rank = reference.rank();
+    const bool solution_exists = echelon.has_solution();
+    const double lu_flops = count_lu_flops(matrix.width, matrix.height, pivots_columns);
+
+    std::vector<int> modes = {1};
+    if (settings.threads > 1) {
+        modes.push_back(settings.threads);
+    }
+
+    auto add_result = [&](const std::string &operation, int threads, std::vector<double> times_ms,
+                          double flops, double bytes) {
+        results.push_back({get_shape_name(shape), matrix.height, unknowns, rank, operation, threads,
+                           std::move(times_ms), flops, bytes});
+    };
+
+    add_result("parse", 1, measure(repetitions, [&]() { return std::istringstream(text); },
+                                   [](std::istringstream &stream) { MatrixCreator::parse_from_txt_stream(stream); }),
+               0, text.size());
+
+    for (int threads : modes) {
+        add_result("lu", threads, measure(repetitions, [&]() { return matrix; },
+                                          [threads](Matrix &input) {
+                                              LUDecomposer::decompose(std::move(input), threads);
+                                          }),
+                   lu_flops, 2 * matrix_bytes);
+    }
+
+    for (int threads : modes) {
+        add_result("qr", threads, measure(repetitions, []() { return 0; },
+                                          [&matrix, threads](int) { QRDecomposer::solve(matrix, threads); }),
+                   count_qr_flops(matrix.height, unknowns, rank), matrix_bytes);
+    }
+
+    // the decomposition hands over the pivot columns, only the lookup tables are built from them
+    add_result("pivots", 1, measure(repetitions, [&]() { return pivots_columns; },
+                                    [&matrix](std::vector<int> &input) {
+                                        EchelonStructure(std::move(input), matrix.width, matrix.width - 1);
+                                    }),
+               0, 3.0 * matrix.width * sizeof(int));
+
+    double substitution_flops = 0;
+    if (solution_exists) {
+        // same right-hand sides as SystemSolver::solve_echelon, the particular solution and the kernel basis
+        const int defect = unknowns - rank;
+        Matrix solutions(defect + 1, unknowns, false);
+        Matrix rhs(defect + 1, rank, false);
+        for (int k = 0; k < rank; ++k) {
+            rhs.field(0, k) = matrix_U.get_field(unknowns, k);
+        }
+        for (int j = 0; j < defect; ++j) {
+            solutions.field(j + 1, echelon.free_columns[j]) = 1;
+        }
+
+        substitution_flops = (defect + 1) * count_substitution_flops(unknowns, pivots_columns);
+        double upper_elements = 0;
+        for (int pivot_column : pivots_columns) {
+            upper_elements += unknowns - pivot_column;
+        }
+        double substitution_bytes = (upper_elements + 2.0 * solutions.size()) * sizeof(double);
+
+        for (int threads : modes) {
+            add_result("substitution", threads,
+                       measure(repetitions, [&]() { return std::make_pair(rhs, solutions); },
+                               [&](std::pair<Matrix, Matrix> &input) {
+                                   auto substitute = [&](int begin, int end) {
+                                       SystemSolver::backward_substitution(matrix_U, echelon, input.first,
+                                                                           input.second, begin, end);
+                                   };
+                                   if (threads == 1) {
+                                       substitute(0, defect + 1);
+                                   } else {
+                                       ThreadPool::get_shared(threads - 1)->parallel_for(0, defect + 1, 1,
+                                                                                         substitute);
+                                   }
+                               }),
+                       substitution_flops, substitution_bytes);
+        }
+    }
+
+    // full output shows the cost of printing, quiet output the cost of the solve alone
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    std::unique_ptr<ResultSink> full_sink = ResultSink::create(OutputLevel::FULL, null_stream);
+    std::unique_ptr<ResultSink> quiet_sink = ResultSink::create(OutputLevel::QUIET, null_stream);
+    for (int threads : modes) {
+        SolverContext context;
+        context.thread_count = threads;
+        add_result("solve", threads, measure(repetitions, []() { return 0; },
+                                             [&](int) { SystemSolver::solve(*full_sink, matrix, context); }),
+                   lu_flops + substitution_flops, 2 * matrix_bytes);
+        add_result("solve_quiet", threads, measure(repetitions, []() { return 0; },
+                                                   [&](int) { SystemSolver::solve(*quiet_sink, matrix, context); }),
+                   lu_flops + substitution_flops, 2 * matrix_bytes);
+    }
+}
+
+void Benchmark::measure_batch(const int &size, const BenchmarkSettings &settings,
+                              std::vector<BenchmarkResult> &results) {
+    std::mt19937_64 generator(BENCHMARK_SEED + size * 8 + 7);
+    const int count = settings.batch_count;
+    const int repetitions = settings.repetitions;
+    std::vector<Matrix> matrices;
+    matrices.reserve(count);
+    SystemBatch batch(size, count);
+    for (int i = 0; i < count; ++i) {
+        matrices.push_back(generate_system(BenchmarkShape::SQUARE, size, generator));
+        batch.set_system(i, matrices.back());
+    }
+
+    std::vector<int> pivots_columns(size);
+    for (int k = 0; k < size; ++k) {
+        pivots_columns[k] = k;
+    }
+    const double flops = static_cast<double>(count) * (count_lu_flops(size + 1, size, pivots_columns) +
+                                                       count_substitution_flops(size, pivots_columns));
+    const double bytes = static_cast<double>(count) * (size + 1.0) * (size + 1.0) * sizeof(double);
+
+    auto add_result = [&](const std::string &operation, int threads, std::vector<double> times_ms) {
+        results.push_back({"batch", size, size, size, operation, threads, std::move(times_ms), flops, bytes,
+                           count});
+    };
+
+    std::vector<int> modes = {1};
+    if (settings.threads > 1) {
+        modes.push_back(settings.threads);
+    }
+    for (int threads : modes) {
+        add_result("batched", threads, measure(repetitions, []() { return 0; },
+                                               [&](int) { BatchedSolver::solve(batch, threads); }));
+    }
+
+    // the same systems one after another, by the unrolled kernels and by the library entry point
+    std::vector<double> solution;
+    if (size >= FIXED_SIZE_MIN && size <= FIXED_SIZE_MAX) {
+        add_result("fixed_loop", 1, measure(repetitions, []() { return 0; }, [&](int) {
+            for (const Matrix &matrix : matrices) {
+                FixedSizeSolver::solve(matrix, solution);
+            }
+        }));
+    }
+    SolverContext context;
+    context.output_level = OutputLevel::QUIET;
+    add_result("solve_loop", 1, measure(repetitions, []() { return 0; }, [&](int) {
+        for (const Matrix &matrix : matrices) {
+            SystemSolver::solve_with_method(matrix, context);
+        }
+    }));
+}
+
+std::vector<BenchmarkResult> Benchmark::run(std::ostream &ostream, const BenchmarkSettings &settings) {
+    std::vector<BenchmarkResult> results;
+    auto print_progress = [&](size_t first) {
+        for (size_t i = first; i < results.size(); ++i) {
+            const BenchmarkResult &result = results[i];
+            ostream << result.shape << " " << result.rows << "x" << result.unknowns << " " << result.operation
+                    << " (" << result.threads << " threads): " << std::fixed << std::setprecision(3)
+                    << result.get_median_ms() << " ms";
+            if (result.systems > 1) {
+                ostream << std::setprecision(0) << ", " << result.get_systems_per_second() << " systems/s";
+            }
+            ostream << std::defaultfloat << std::endl;
+        }
+    };
+    for (int size : settings.sizes) {
+        for (const BenchmarkShape &shape : settings.shapes) {
+            size_t first = results.size();
+            measure_system(shape, size, settings, results);
+            print_progress(first);
+        }
+    }
+    for (int size : settings.batch_sizes) {
+        size_t first = results.size();
+        measure_batch(size, settings, results);
+        print_progress(first);
+    }
+    return results;
+}
+
+void Benchmark::print_json(std::ostream &ostream, const BenchmarkSettings &settings,
+                           const std::vector<BenchmarkResult> &results) {
+    ostream << "{" << std::endl;
+    ostream << "  \"benchmark\": \"lss-bench\"," << std::endl;
+    ostream << "  \"version\": " << BENCHMARK_REPORT_VERSION << "," << std::endl;
+    ostream << "  \"seed\": " << BENCHMARK_SEED << "," << std::endl;
+    ostream << "  \"repetitions\": " << settings.repetitions << "," << std::endl;
+    ostream << "  \"batch_count\": " << settings.batch_count << "," << std::endl;
+    ostream << "  \"threads\": " << settings.threads << "," << std::endl;
+    ostream << "  \"hardware_threads\": " << ThreadPool::get_hardware_threads() << "," << std::endl;
+    ostream << "  \"gemm_kernel\": \"" << GemmEngine::get_kernel_name(GemmEngine::get_kernel()) << "\","
+            << std::endl;
+    ostream << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult &result = results[i];
+        ostream << (i == 0 ? "" : ",") << std::endl;
+        ostream << "    {\"shape\": \"" << result.shape << "\", \"rows\": " << result.rows
+                << ", \"unknowns\": " << result.unknowns << ", \"rank\": " << result.rank
+                << ", \"operation\": \"" << result.operation << "\", \"mode\": \""
+                << (result.threads == 1 ? "serial" : "threaded") << "\", \"threads\": " << result.threads
+                << ", \"median_ms\": " << to_json_number(result.get_median_ms())
+                << ", \"p99_ms\": " << to_json_number(result.get_p99_ms())
+                << ", \"min_ms\": " << to_json_number(result.get_min_ms())
+                << ", \"gflops\": " << (result.flops > 0 ? to_json_number(result.get_gflops()) : "null")
+                << ", \"gbps\": " << to_json_number(result.get_gbps())
+                << ", \"systems_per_s\": " << to_json_number(result.get_systems_per_second()) << "}";
+    }
+    ostream << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
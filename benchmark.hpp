@@ -0,0 +1,207 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_BENCHMARK_HPP
+#define LINEAR_SYSTEM_SOLVER_BENCHMARK_HPP
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "matrix.hpp"
+
+/**
+ * Constant representing number of measured runs of each operation, one more run warms up the caches.
+ */
+#define BENCHMARK_DEFAULT_REPETITIONS 11
+
+/**
+ * Constant representing seed of the generator of the systems, so the runs of different commits are comparable.
+ */
+#define BENCHMARK_SEED 20191213
+
+/**
+ * Constant representing version of the JSON report, it is increased when the fields change.
+ */
+#define BENCHMARK_REPORT_VERSION 2
+
+/**
+ * Constant representing default number of systems solved at once by the batched solver benchmark.
+ */
+#define BENCHMARK_BATCH_COUNT 10000
+
+/**
+ * Enumeration for the shapes of the generated systems.
+ */
+enum class BenchmarkShape {
+    SQUARE, // n equations, n unknowns, regular
+    WIDE, // n equations, 2n unknowns, the kernel has dimension n
+    TALL, // 2n equations, n unknowns, consistent
+    SINGULAR, // n equations, n unknowns, rank n / 2, consistent
+    INCONSISTENT // n equations, n unknowns, rank n / 2, vector b outside of the column space
+};
+
+/**
+ * Struct representing settings of the benchmark.
+ */
+struct BenchmarkSettings {
+    std::vector<int> sizes = {64, 128, 256, 512};
+    std::vector<BenchmarkShape> shapes = {BenchmarkShape::SQUARE, BenchmarkShape::WIDE, BenchmarkShape::TALL,
+                                          BenchmarkShape::SINGULAR, BenchmarkShape::INCONSISTENT};
+    /**
+     * Numbers of unknowns of the small systems solved by the batched solver.
+     */
+    std::vector<int> batch_sizes = {2, 4, 8};
+    /**
+     * Number of the small systems in one batch.
+     */
+    int batch_count = BENCHMARK_BATCH_COUNT;
+    int repetitions = BENCHMARK_DEFAULT_REPETITIONS;
+    /**
+     * Number of threads of the threaded mode, 1 measures the serial mode only.
+     */
+    int threads = 1;
+    /**
+     * File the JSON report is written to, empty for the standard output.
+     */
+    std::string output_path;
+};
+
+/**
+ * Struct representing measured times of one operation on one system.
+ */
+struct BenchmarkResult {
+    std::string shape;
+    int rows;
+    int unknowns;
+    int rank;
+    std::string operation;
+    int threads;
+    std::vector<double> times_ms;
+    /**
+     * Number of floating point operations of one run, 0 for the operations without arithmetic.
+     */
+    double flops;
+    /**
+     * Number of bytes one run has to read and write at least (the text for parsing, the matrix for the rest).
+     */
+    double bytes;
+    /**
+     * Number of the systems solved by one run, more than 1 for the batched operations.
+     */
+    int systems = 1;
+
+    double get_median_ms() const;
+
+    double get_p99_ms() const;
+
+    double get_min_ms() const;
+
+    /**
+     * @return flops per second of the median run in billions
+     */
+    double get_gflops() const;
+
+    /**
+     * @return bytes per second of the median run in billions
+     */
+    double get_gbps() const;
+
+    /**
+     * @return systems solved per second by the median run
+     */
+    double get_systems_per_second() const;
+};
+
+/**
+ * Class responsible for measuring performance of the solver on generated systems.
+ * <p>
+ * For each shape and size the system is generated, written as txt and then the parsing, LU decomposition,
+ * QR solve, building of the echelon structure, backward substitution and the whole SystemSolver::solve with full
+ * and quiet output are measured. Operations that use threads are measured in the serial mode and, if more threads
+ * are requested, in the threaded mode. Batches of small square systems are solved by BatchedSolver and,
+ * for comparison, one system after another by FixedSizeSolver and SystemSolver.
+ * The report is JSON with one object per measured operation, so it can be compared across commits.
+ */
+class Benchmark {
+private:
+    /**
+     * Measures all operations on one generated system.
+     *
+     * @param shape shape of the system
+     * @param size number of equations (n of the shape)
+     * @param settings settings with the repetitions and threads
+     * @param results vector the results are appended to
+     */
+    static void measure_system(const BenchmarkShape &shape, const int &size, const BenchmarkSettings &settings,
+                               std::vector<BenchmarkResult> &results);
+
+    /**
+     * Measures the solves of the batch of small square systems.
+     *
+     * @param size number of unknowns of each system
+     * @param settings settings with the number of the systems, repetitions and threads
+     * @param results vector the results are appended to
+     */
+    static void measure_batch(const int &size, const BenchmarkSettings &settings,
+                              std::vector<BenchmarkResult> &results);
+
+public:
+    /**
+     * Parses the command line arguments of the benchmark.
+     * (--sizes N,N,... --shapes NAME,NAME,... --batch-sizes N,N,... --batch-count N --repetitions N --threads N
+     * --out FILE)
+     *
+     * @param argc number of the arguments
+     * @param argv the arguments, including the program name
+     * @return BenchmarkSettings, throws std::domain_error for invalid arguments
+     */
+    static BenchmarkSettings parse_arguments(int argc, char **argv);
+
+    /**
+     * @param shape shape of the system
+     * @return name of the shape used in the arguments and the report
+     */
+    static std::string get_shape_name(const BenchmarkShape &shape);
+
+    /**
+     * Generates augmented matrix of the system with random elements from [-1, 1].
+     *
+     * @param shape shape of the system
+     * @param size number of equations (n of the shape)
+     * @param generator random number generator
+     * @return augmented Matrix of the system
+     */
+    static Matrix generate_system(const BenchmarkShape &shape, const int &size, std::mt19937_64 &generator);
+
+    /**
+     * Writes the matrix in the txt file format.
+     *
+     * @param matrix matrix to be written
+     * @return content of the txt file, the elements are written with all 17 significant digits
+     */
+    static std::string to_txt(const Matrix &matrix);
+
+    /**
+     * Runs all measurements.
+     *
+     * @param ostream output stream to write the progress to
+     * @param settings settings of the benchmark
+     * @return results of all measured operations
+     */
+    static std::vector<BenchmarkResult> run(std::ostream &ostream, const BenchmarkSettings &settings);
+
+    /**
+     * Prints the JSON report.
+     *
+     * @param ostream output stream to write to
+     * @param settings settings of the benchmark
+     * @param results results of the measured operations
+     */
+    static void print_json(std::ostream &ostream, const BenchmarkSettings &settings,
+                           const std::vector<BenchmarkResult> &results);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_BENCHMARK_HPP
@@ -0,0 +1,34 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <fstream>
+#include <iostream>
+
+#include "benchmark.hpp"
+
+int main(int argc, char **argv) {
+    BenchmarkSettings settings;
+    try {
+        settings = Benchmark::parse_arguments(argc, argv);
+    } catch (std::exception &e) {
+        std::cerr << "An exception occurred: " << e.what() << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [--sizes N,N,...] [--shapes square,wide,tall,singular,inconsistent]"
+                  << " [--batch-sizes N,N,...] [--batch-count N] [--repetitions N] [--threads N] [--out FILE]" << std::endl;
+        return 2;
+    }
+
+    // the progress goes to the error output, so the standard output holds only the JSON report
+    std::vector<BenchmarkResult> results = Benchmark::run(std::cerr, settings);
+    if (settings.output_path.empty()) {
+        Benchmark::print_json(std::cout, settings, results);
+        return 0;
+    }
+    std::ofstream out(settings.output_path);
+    if (!out) {
+        std::cerr << "An exception occurred: failed to create file " << settings.output_path << "." << std::endl;
+        return 1;
+    }
+    Benchmark::print_json(out, settings, results);
+    return 0;
+}
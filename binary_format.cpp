@@ -0,0 +1,302 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "binary_format.hpp"
+#include "text_parser.hpp"
+#include "utils.hpp"
+
+namespace {
+    /**
+     * Fletcher style checksum of 8-byte words, both running sums are modulo 2^64.
+     */
+    class Checksum {
+    private:
+        uint64_t sum = 0;
+        uint64_t sum_of_sums = 0;
+
+    public:
+        /**
+         * @param data bytes to add, their number has to be multiple of 8
+         * @param size number of the bytes
+         */
+        void update(const char *data, size_t size) {
+            for (size_t i = 0; i + 8 <= size; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, data + i, 8);
+                sum += word;
+                sum_of_sums += sum;
+            }
+        }
+
+        uint64_t get_value() const {
+            return sum ^ (sum_of_sums << 32u | sum_of_sums >> 32u);
+        }
+    };
+
+    size_t round_up_to_words(size_t bytes) {
+        return (bytes + 7) / 8 * 8;
+    }
+
+    size_t get_sparse_data_size(const BinaryHeader &header) {
+        size_t lines = static_cast<size_t>(header.storage == StorageType::SPARSE_CSR ? header.height : header.width);
+        return round_up_to_words((lines + 1 + header.non_zeros) * sizeof(int32_t))
+               + header.non_zeros * sizeof(double);
+    }
+
+    BinaryHeader create_header(StorageType storage, ScalarType scalar_type, const int &width, const int &height,
+                               const bool &augmented) {
+        BinaryHeader header{};
+        std::memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+        header.version = BINARY_VERSION;
+        header.scalar_type = scalar_type;
+        header.storage = storage;
+        header.augmented = augmented ? 1 : 0;
+        header.width = width;
+        header.height = height;
+        return header;
+    }
+
+    void write_file(const std::string &path, const BinaryHeader &header, const char *data) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(data, static_cast<std::streamsize>(header.data_size));
+        if (!file) {
+            throw std::domain_error("Failed to write file " + path + ".");
+        }
+    }
+
+    /**
+     * Checks the header against the size of the data and optionally the checksum of the data.
+     *
+     * @param source beginning of the error messages naming the file or the buffer
+     */
+    const BinaryHeader &validate(const char *data, size_t size, const std::string &source, bool verify) {
+        if (size < sizeof(BinaryHeader)) {
+            throw std::domain_error(source + " is not binary matrix file.");
+        }
+        const auto &header = *reinterpret_cast<const BinaryHeader *>(data);
+        if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) != 0) {
+            throw std::domain_error(source + " is not binary matrix file.");
+        }
+        if (header.version != BINARY_VERSION || header.scalar_type > ScalarType::COMPLEX128
+            || header.storage > StorageType::SPARSE_CSC
+            || (header.storage != StorageType::DENSE && header.scalar_type != ScalarType::FLOAT64)) {
+            throw std::domain_error(source + " has unsupported version, scalar type or storage.");
+        }
+        const size_t element_size = ScalarTypes::get_size(header.scalar_type);
+        if (header.width < 1 || header.height < 1 || header.width > INT_MAX || header.height > INT_MAX
+            || header.width * header.height > static_cast<int64_t>(LLONG_MAX / element_size)) {
+            throw std::domain_error(source + " has invalid dimensions.");
+        }
+        size_t expected_size = header.storage == StorageType::DENSE
+                               ? round_up_to_words(static_cast<size_t>(header.width * header.height) * element_size)
+                               : get_sparse_data_size(header);
+        if (header.data_size != expected_size || size < sizeof(BinaryHeader) + expected_size) {
+            throw std::domain_error(source + " is truncated or corrupted.");
+        }
+        if (verify) {
+            Checksum checksum;
+            checksum.update(data + sizeof(BinaryHeader), header.data_size);
+            if (checksum.get_value() != header.checksum) {
+                throw std::domain_error("Checksum of " + source + " does not match.");
+            }
+        }
+        return header;
+    }
+
+    const BinaryHeader &validate(const MappedFile &file, const std::string &path, bool verify) {
+        return validate(file.get_data(), file.get_size(), "File " + path, verify);
+    }
+
+    void check_scalar_type(const BinaryHeader &header, ScalarType expected, const std::string &source) {
+        if (header.scalar_type != expected) {
+            throw std::domain_error(source + " holds elements of type " + ScalarTypes::get_name(header.scalar_type)
+                                    + ", expected " + ScalarTypes::get_name(expected) + ".");
+        }
+    }
+
+    /**
+     * Reads the sparse matrix from the data following the validated header.
+     */
+    SparseMatrix read_sparse(const BinaryHeader &header, const char *data, const std::string &source) {
+        SparseFormat format = header.storage == StorageType::SPARSE_CSR ? SparseFormat::CSR : SparseFormat::CSC;
+        SparseMatrix matrix(static_cast<int>(header.width), static_cast<int>(header.height), header.augmented != 0,
+                            format);
+        size_t lines = static_cast<size_t>(format == SparseFormat::CSR ? header.height : header.width);
+        matrix.offsets.resize(lines + 1);
+        matrix.indexes.resize(header.non_zeros);
+        matrix.values.resize(header.non_zeros);
+        size_t offsets_size = matrix.offsets.size() * sizeof(int32_t);
+        std::memcpy(matrix.offsets.data(), data, offsets_size);
+        std::memcpy(matrix.indexes.data(), data + offsets_size, matrix.indexes.size() * sizeof(int32_t));
+        size_t values_position = round_up_to_words(offsets_size + matrix.indexes.size() * sizeof(int32_t));
+        std::memcpy(matrix.values.data(), data + values_position, matrix.values.size() * sizeof(double));
+
+        // the offsets and indexes are used for indexing, so they have to be consistent and sorted within each line
+        bool consistent = matrix.offsets.front() == 0
+                          && matrix.offsets.back() == static_cast<int>(header.non_zeros);
+        int index_limit = format == SparseFormat::CSR ? matrix.width : matrix.height;
+        for (size_t i = 0; consistent && i < lines; ++i) {
+            consistent = matrix.offsets[i] <= matrix.offsets[i + 1];
+        }
+        for (size_t i = 0; consistent && i < matrix.indexes.size(); ++i) {
+            consistent = matrix.indexes[i] >= 0 && matrix.indexes[i] < index_limit;
+        }
+        for (size_t i = 0; consistent && i < lines; ++i) {
+            for (int j = matrix.offsets[i] + 1; consistent && j < matrix.offsets[i + 1]; ++j) {
+                consistent = matrix.indexes[j - 1] < matrix.indexes[j];
+            }
+        }
+        if (!consistent) {
+            throw std::domain_error(source + " has invalid sparse structure.");
+        }
+        return matrix;
+    }
+}
+
+template<typename T>
+void BinaryMatrixFile::write(const std::string &path, const BasicMatrix<T> &matrix) {
+    BinaryHeader header = create_header(StorageType::DENSE, ScalarTraits<T>::get_type(), matrix.width, matrix.height,
+                                        matrix.augmented);
+    header.data_size = round_up_to_words(matrix.size() * sizeof(T));
+
+    // only the float matrices of odd size need the padding, the others are written as they are
+    const char *data = reinterpret_cast<const char *>(matrix.data);
+    std::vector<char> padded;
+    if (header.data_size != matrix.size() * sizeof(T)) {
+        padded.assign(header.data_size, 0);
+        std::memcpy(padded.data(), data, matrix.size() * sizeof(T));
+        data = padded.data();
+    }
+
+    Checksum checksum;
+    checksum.update(data, header.data_size);
+    header.checksum = checksum.get_value();
+
+    write_file(path, header, data);
+}
+
+void BinaryMatrixFile::write(const std::string &path, const SparseMatrix &matrix) {
+    StorageType storage = matrix.format == SparseFormat::CSR ? StorageType::SPARSE_CSR : StorageType::SPARSE_CSC;
+    BinaryHeader header = create_header(storage, ScalarType::FLOAT64, matrix.width, matrix.height, matrix.augmented);
+    header.non_zeros = matrix.non_zeros();
+    header.data_size = get_sparse_data_size(header);
+
+    // offsets and indexes are stored as they are, values start on the next 8-byte boundary
+    std::vector<char> data(header.data_size, 0);
+    size_t offsets_size = matrix.offsets.size() * sizeof(int32_t);
+    std::memcpy(data.data(), matrix.offsets.data(), offsets_size);
+    std::memcpy(data.data() + offsets_size, matrix.indexes.data(), matrix.indexes.size() * sizeof(int32_t));
+    size_t values_position = round_up_to_words(offsets_size + matrix.indexes.size() * sizeof(int32_t));
+    std::memcpy(data.data() + values_position, matrix.values.data(), matrix.values.size() * sizeof(double));
+
+    Checksum checksum;
+    checksum.update(data.data(), data.size());
+    header.checksum = checksum.get_value();
+
+    write_file(path, header, data.data());
+}
+
+BinaryHeader BinaryMatrixFile::read_header(const std::string &path) {
+    MappedFile file(path);
+    return validate(file, path, false);
+}
+
+Matrix BinaryMatrixFile::load_dense(const std::string &path, bool verify) {
+    return load_dense_as<double>(path, verify);
+}
+
+template<typename T>
+BasicMatrix<T> BinaryMatrixFile::load_dense_as(const std::string &path, bool verify) {
+    auto file = std::make_shared<MappedFile>(path, true);
+    const BinaryHeader &header = validate(*file, path, verify);
+    if (header.storage != StorageType::DENSE) {
+        throw std::domain_error("File " + path + " holds sparse matrix.");
+    }
+    check_scalar_type(header, ScalarTraits<T>::get_type(), "File " + path);
+    auto *data = reinterpret_cast<T *>(file->get_data() + sizeof(BinaryHeader));
+    return BasicMatrix<T>(static_cast<int>(header.width), static_cast<int>(header.height), header.augmented != 0,
+                          data, file);
+}
+
+SparseMatrix BinaryMatrixFile::load_sparse(const std::string &path, bool verify) {
+    MappedFile file(path);
+    const BinaryHeader &header = validate(file, path, verify);
+    if (header.storage == StorageType::DENSE) {
+        throw std::domain_error("File " + path + " holds dense matrix.");
+    }
+    return read_sparse(header, file.get_data() + sizeof(BinaryHeader), "File " + path);
+}
+
+BinaryHeader BinaryMatrixFile::parse_header(const char *data, size_t size) {
+    return validate(data, size, "Binary matrix", false);
+}
+
+Matrix BinaryMatrixFile::parse_dense(const char *data, size_t size, bool verify) {
+    const std::string source = "Binary matrix";
+    const BinaryHeader &header = validate(data, size, source, verify);
+    if (header.storage != StorageType::DENSE) {
+        throw std::domain_error(source + " holds sparse matrix.");
+    }
+    check_scalar_type(header, ScalarType::FLOAT64, source);
+    Matrix matrix(static_cast<int>(header.width), static_cast<int>(header.height), header.augmented != 0);
+    std::memcpy(matrix.data, data + sizeof(BinaryHeader), header.data_size);
+    return matrix;
+}
+
+SparseMatrix BinaryMatrixFile::parse_sparse(const char *data, size_t size, bool verify) {
+    const std::string source = "Binary matrix";
+    const BinaryHeader &header = validate(data, size, source, verify);
+    if (header.storage == StorageType::DENSE) {
+        throw std::domain_error(source + " holds dense matrix.");
+    }
+    return read_sparse(header, data + sizeof(BinaryHeader), source);
+}
+
+void BinaryMatrixFile::convert_txt(const std::string &txt_path, const std::string &binary_path, bool sparse,
+                                   ScalarType default_type) {
+    ScalarType type = TextMatrixParser::read_scalar_type(txt_path, default_type);
+    if (sparse && type != ScalarType::FLOAT64) {
+        throw std::domain_error("Sparse binary files hold only double elements.");
+    }
+    if (sparse) {
+        write(binary_path, SparseMatrix(MatrixCreator::parse_from_txt_file(txt_path)));
+        return;
+    }
+    ScalarTypes::visit(type, [&](auto tag) {
+        typedef typename decltype(tag)::type T;
+        write(binary_path, BasicMatrixCreator<T>::parse_from_txt_file(txt_path));
+    });
+}
+
+bool BinaryMatrixFile::is_binary_path(const std::string &path) {
+    const std::string extension(BINARY_EXTENSION);
+    return path.size() >= extension.size()
+           && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+template void BinaryMatrixFile::write<float>(const std::string &, const BasicMatrix<float> &);
+
+template void BinaryMatrixFile::write<double>(const std::string &, const BasicMatrix<double> &);
+
+template void BinaryMatrixFile::write<long double>(const std::string &, const BasicMatrix<long double> &);
+
+template void BinaryMatrixFile::write<std::complex<double>>(const std::string &,
+                                                            const BasicMatrix<std::complex<double>> &);
+
+template BasicMatrix<float> BinaryMatrixFile::load_dense_as<float>(const std::string &, bool);
+
+template BasicMatrix<double> BinaryMatrixFile::load_dense_as<double>(const std::string &, bool);
+
+template BasicMatrix<long double> BinaryMatrixFile::load_dense_as<long double>(const std::string &, bool);
+
+template BasicMatrix<std::complex<double>>
+BinaryMatrixFile::load_dense_as<std::complex<double>>(const std::string &, bool);
@@ -0,0 +1,175 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_BINARY_FORMAT_HPP
+#define LINEAR_SYSTEM_SOLVER_BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "matrix.hpp"
+#include "sparse_matrix.hpp"
+#include "scalar_type.hpp"
+
+/**
+ * Constant representing the first 8 bytes of every binary matrix file.
+ */
+#define BINARY_MAGIC "LSSMATRX"
+
+/**
+ * Constant representing current version of the binary format.
+ */
+#define BINARY_VERSION 1
+
+/**
+ * Constant representing extension of the binary matrix files.
+ */
+#define BINARY_EXTENSION ".bin"
+
+/**
+ * Enumeration for the storage of the matrix in the binary file.
+ */
+enum class StorageType : uint32_t {
+    DENSE = 0,
+    SPARSE_CSR = 1,
+    SPARSE_CSC = 2
+};
+
+/**
+ * Struct representing header of the binary matrix file, the data follow right after it (64 bytes from the start,
+ * so the mapped data are aligned to BUFFER_ALIGNMENT). All numbers are little-endian.
+ * <p>
+ * Dense data are the elements of the scalar type stored row after row and padded with zeros to 8 bytes. Sparse data
+ * are offsets (int32, (height or width) + 1 of them), indexes (int32, non_zeros of them) padded with zeros to 8 bytes
+ * and values (float64, non_zeros of them), sparse files always have the scalar type FLOAT64. Long double elements
+ * are stored in the layout of the platform, so such files are not portable.
+ * Checksum is Fletcher style pair of running sums (modulo 2^64) over the data read as 8-byte words.
+ */
+struct BinaryHeader {
+    char magic[8];
+    uint32_t version;
+    ScalarType scalar_type;
+    StorageType storage;
+    uint32_t augmented;
+    int64_t width;
+    int64_t height;
+    uint64_t non_zeros;
+    uint64_t data_size;
+    uint64_t checksum;
+};
+
+static_assert(sizeof(BinaryHeader) == 64, "binary header has to keep the data aligned");
+
+/**
+ * Class responsible for writing and loading the binary matrix files.
+ */
+class BinaryMatrixFile {
+public:
+    /**
+     * Writes the dense matrix to the binary file, the scalar type of the file is the type of the elements.
+     *
+     * @tparam T type of the elements
+     * @param path path to the file, the file is overwritten
+     * @param matrix matrix to be written
+     */
+    template<typename T>
+    static void write(const std::string &path, const BasicMatrix<T> &matrix);
+
+    /**
+     * Writes the sparse matrix to the binary file in its format.
+     *
+     * @param path path to the file, the file is overwritten
+     * @param matrix matrix to be written
+     */
+    static void write(const std::string &path, const SparseMatrix &matrix);
+
+    /**
+     * Reads and validates the header of the binary file.
+     *
+     * @param path path to the file
+     * @return BinaryHeader of the file, throws std::domain_error if the file is not valid binary matrix file
+     */
+    static BinaryHeader read_header(const std::string &path);
+
+    /**
+     * Maps the dense binary file to the memory and wraps it in the matrix without copying. The mapping is
+     * copy-on-write, so the solver can modify the matrix in place and the file stays unchanged.
+     *
+     * @param path path to the file
+     * @param verify true to check the checksum, which reads the whole file
+     * @return Matrix pointing into the mapped file, throws std::domain_error for invalid or sparse file
+     * or file of other scalar type
+     */
+    static Matrix load_dense(const std::string &path, bool verify = true);
+
+    /**
+     * Maps the dense binary file with elements of the type T to the memory, same as load_dense.
+     *
+     * @tparam T type of the elements, it has to match the scalar type of the file
+     * @param path path to the file
+     * @param verify true to check the checksum
+     * @return BasicMatrix pointing into the mapped file, throws std::domain_error for invalid or sparse file
+     * or file of other scalar type
+     */
+    template<typename T>
+    static BasicMatrix<T> load_dense_as(const std::string &path, bool verify = true);
+
+    /**
+     * Loads the sparse binary file.
+     *
+     * @param path path to the file
+     * @param verify true to check the checksum
+     * @return SparseMatrix read from the file, throws std::domain_error for invalid or dense file
+     */
+    static SparseMatrix load_sparse(const std::string &path, bool verify = true);
+
+    /**
+     * Reads and validates the header of the binary matrix file in the memory (e.g. received from the socket).
+     *
+     * @param data contents of the binary file
+     * @param size number of the bytes
+     * @return BinaryHeader of the data, throws std::domain_error if the data are not valid
+     */
+    static BinaryHeader parse_header(const char *data, size_t size);
+
+    /**
+     * Reads the dense binary matrix file of doubles from the memory to the new matrix.
+     *
+     * @param data contents of the binary file
+     * @param size number of the bytes
+     * @param verify true to check the checksum
+     * @return Matrix with the copy of the data, throws std::domain_error if the data are not valid,
+     * sparse or their scalar type is not FLOAT64
+     */
+    static Matrix parse_dense(const char *data, size_t size, bool verify = true);
+
+    /**
+     * Reads the sparse binary matrix file from the memory to the new sparse matrix.
+     *
+     * @param data contents of the binary file
+     * @param size number of the bytes
+     * @param verify true to check the checksum
+     * @return SparseMatrix read from the data, throws std::domain_error if the data are not valid or dense
+     */
+    static SparseMatrix parse_sparse(const char *data, size_t size, bool verify = true);
+
+    /**
+     * Converts the txt matrix file to the binary one. The scalar type is taken from the header of the txt file.
+     *
+     * @param txt_path path to the txt file
+     * @param binary_path path to the binary file, the file is overwritten
+     * @param sparse true to store the matrix in CSR format (only for FLOAT64), false to store it dense
+     * @param default_type scalar type of the txt file which does not name its type
+     */
+    static void convert_txt(const std::string &txt_path, const std::string &binary_path, bool sparse,
+                            ScalarType default_type = ScalarType::FLOAT64);
+
+    /**
+     * @param path path to the file
+     * @return true if the path has the extension BINARY_EXTENSION
+     */
+    static bool is_binary_path(const std::string &path);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_BINARY_FORMAT_HPP
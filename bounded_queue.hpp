@@ -0,0 +1,64 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_BOUNDED_QUEUE_HPP
+#define LINEAR_SYSTEM_SOLVER_BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * Queue with limited capacity, push blocks while the queue is full and pop blocks while it is empty.
+ * It passes the work between the stages of the batch mode and the server.
+ *
+ * @tparam T type of the queued items
+ */
+template<typename T>
+class BoundedQueue {
+private:
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(std::max<size_t>(capacity, 1)) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return items.size() < capacity; });
+        items.push_back(std::move(item));
+        not_empty.notify_one();
+    }
+
+    /**
+     * @return false if the queue is closed and empty
+     */
+    bool pop(T &item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    /**
+     * Wakes up all waiting consumers, no more items will be pushed.
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        not_empty.notify_all();
+    }
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_BOUNDED_QUEUE_HPP
@@ -0,0 +1,121 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include "buffer_pool.hpp"
+#include "statistics.hpp"
+
+namespace {
+    const size_t HUGE_PAGE_SIZE = 2u << 20u;
+
+    struct PoolState {
+        std::mutex mutex;
+        std::map<size_t, std::vector<void *>> free_buffers;
+        size_t cached_bytes = 0;
+        size_t cache_limit = 256u << 20u;
+    };
+
+    /**
+     * The state is intentionally never destroyed, so matrices released during static destruction are still valid.
+     */
+    PoolState &get_state() {
+        static auto *state = new PoolState();
+        return *state;
+    }
+
+    size_t get_size_class(size_t bytes) {
+        if (bytes >= HUGE_PAGE_THRESHOLD) {
+            return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+        size_t size_class = BUFFER_ALIGNMENT;
+        while (size_class < bytes) {
+            size_class <<= 1u;
+        }
+        return size_class;
+    }
+
+    void *allocate_system(size_t size_class) {
+        void *buffer = nullptr;
+        size_t alignment = size_class >= HUGE_PAGE_THRESHOLD ? HUGE_PAGE_SIZE : BUFFER_ALIGNMENT;
+        if (posix_memalign(&buffer, alignment, size_class) != 0) {
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        if (size_class >= HUGE_PAGE_THRESHOLD) {
+            madvise(buffer, size_class, MADV_HUGEPAGE);
+        }
+#endif
+        return buffer;
+    }
+}
+
+double *BufferPool::allocate(size_t count) {
+    if (count == 0) return nullptr;
+    Statistics::add(Counter::ALLOCATIONS);
+    Statistics::add(Counter::BYTES_ALLOCATED, count * sizeof(double));
+    size_t size_class = get_size_class(count * sizeof(double));
+    {
+        PoolState &state = get_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.free_buffers.find(size_class);
+        if (it != state.free_buffers.end() && !it->second.empty()) {
+            void *buffer = it->second.back();
+            it->second.pop_back();
+            state.cached_bytes -= size_class;
+            return static_cast<double *>(buffer);
+        }
+    }
+    Statistics::add(Counter::SYSTEM_ALLOCATIONS);
+    return static_cast<double *>(allocate_system(size_class));
+}
+
+void BufferPool::release(double *buffer, size_t count) noexcept {
+    if (buffer == nullptr) return;
+    size_t size_class = get_size_class(count * sizeof(double));
+    PoolState &state = get_state();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.cached_bytes + size_class <= state.cache_limit) {
+            try {
+                state.free_buffers[size_class].push_back(buffer);
+                state.cached_bytes += size_class;
+                return;
+            } catch (std::bad_alloc &e) {
+                // not enough memory for the bookkeeping, free the buffer instead
+            }
+        }
+    }
+    free(buffer);
+}
+
+void BufferPool::trim() {
+    PoolState &state = get_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (auto &size_class : state.free_buffers) {
+        for (void *buffer : size_class.second) {
+            free(buffer);
+        }
+    }
+    state.free_buffers.clear();
+    state.cached_bytes = 0;
+}
+
+void BufferPool::set_cache_limit(size_t bytes) {
+    PoolState &state = get_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.cache_limit = bytes;
+}
+
+size_t BufferPool::get_cached_bytes() {
+    PoolState &state = get_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.cached_bytes;
+}
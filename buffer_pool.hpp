@@ -0,0 +1,64 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_BUFFER_POOL_HPP
+#define LINEAR_SYSTEM_SOLVER_BUFFER_POOL_HPP
+
+#include <cstddef>
+
+/**
+ * Constant representing alignment of all buffers given by the pool (size of the cache line).
+ */
+#define BUFFER_ALIGNMENT 64
+
+/**
+ * Constant representing size in bytes from which the buffers are aligned to huge pages
+ * and the kernel is advised to back them with transparent huge pages.
+ */
+#define HUGE_PAGE_THRESHOLD (4u << 20u)
+
+/**
+ * Class responsible for recycling the matrix buffers.
+ * <p>
+ * Released buffers are kept in size classes (powers of two for small buffers, multiples of huge page for large ones)
+ * and given back on the next allocation of the same class, so the temporary matrices of the solver
+ * do not go through the system allocator and do not fault fresh pages over and over.
+ */
+class BufferPool {
+public:
+    /**
+     * Gets buffer for given number of doubles. The content of the buffer is not initialized.
+     *
+     * @param count number of doubles in the buffer
+     * @return buffer aligned to BUFFER_ALIGNMENT, nullptr for count 0
+     */
+    static double *allocate(size_t count);
+
+    /**
+     * Gives the buffer back to the pool.
+     *
+     * @param buffer buffer obtained from allocate, nullptr is ignored
+     * @param count number of doubles the buffer was allocated for
+     */
+    static void release(double *buffer, size_t count) noexcept;
+
+    /**
+     * Frees all buffers cached in the pool.
+     */
+    static void trim();
+
+    /**
+     * Sets how many bytes can the pool keep cached, buffers released over the limit are freed.
+     *
+     * @param bytes maximum of cached bytes
+     */
+    static void set_cache_limit(size_t bytes);
+
+    /**
+     * @return number of bytes currently cached in the pool
+     */
+    static size_t get_cached_bytes();
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_BUFFER_POOL_HPP
@@ -2,13 +2,18 @@
 // Created by tomanm10 on 04.12.2019.
 //
 
+#include <chrono>
 #include <iostream>
+#include <limits>
 
 #include "command.hpp"
 #include "matrix.hpp"
 #include "system_solver.hpp"
-
-bool CommandInterpreter::USING_MULTIPLE_THREADS = false; // use one thread as default
+#include "thread_pool.hpp"
+#include "binary_format.hpp"
+#include "statistics.hpp"
+#include "result_sink.hpp"
+#include "text_parser.hpp"
 
 Command CommandInterpreter::get_command(std::ostream &ostream, std::istream &istream) {
     ostream << "Enter command to execute..." << std::endl;
@@ -45,32 +50,262 @@ std::string CommandInterpreter::get_command_help(const Command &cmd) {
 }
 
 void CommandInterpreter::process_command(std::ostream &ostream, std::istream &istream, const Command &cmd) {
+    // statistics are reported for each command that solves a system
+    bool report_statistics = Statistics::FORMAT != StatisticsFormat::NONE &&
+                             (cmd == Command::CMD_INPUT || cmd == Command::TXT_INPUT || cmd == Command::BIN_INPUT ||
+                              cmd == Command::OUT_OF_CORE || cmd == Command::NEW_RHS);
+    if (report_statistics) {
+        Statistics::reset();
+    }
+
     if (cmd == Command::QUIT) {
         ostream << "Shutting down..." << std::endl;
     } else if (cmd == Command::HELP) {
         print_help(ostream);
     } else if (cmd == Command::ONE_THREAD) {
-        CommandInterpreter::USING_MULTIPLE_THREADS = false;
+        context.thread_count = 1;
         ostream << "Using one thread for computation." << std::endl;
     } else if (cmd == Command::MTP_THREAD) {
-        CommandInterpreter::USING_MULTIPLE_THREADS = true;
-        ostream << "Using multiple threads for computation." << std::endl;
+        context.thread_count = ThreadPool::get_hardware_threads();
+        ostream << "Using " << context.thread_count << " threads for computation." << std::endl;
+    } else if (cmd == Command::SET_THREADS) {
+        ostream << "Enter number of threads: ";
+        int thread_count;
+        istream >> thread_count;
+        if (!istream || thread_count < 1) {
+            istream.clear();
+            istream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            ostream << "Number of threads has to be positive integer." << std::endl;
+        } else {
+            context.thread_count = thread_count;
+            ostream << "Using " << thread_count << " threads for computation." << std::endl;
+        }
     } else if (cmd == Command::CMD_INPUT) {
         try {
-            Matrix matrix = MatrixCreator::parse_from_cmd_line(ostream, istream);
-            SystemSolver::solve(ostream, matrix);
+            ScalarTypes::visit(context.scalar_type, [&](auto tag) {
+                typedef typename decltype(tag)::type T;
+                solve_and_load(ostream, BasicMatrixCreator<T>::parse_from_cmd_line(ostream, istream));
+            });
         } catch (std::exception &e) {
             ostream << "An exception occurred: " << e.what() << std::endl;
         }
     } else if (cmd == Command::TXT_INPUT) {
         try {
-            Matrix matrix = MatrixCreator::parse_from_txt_file(ostream, istream);
-            SystemSolver::solve(ostream, matrix);
+            ostream << "Choose file from shown below:" << std::endl;
+            std::string path = FileReader::choose_file_path(ostream, istream);
+            ScalarTypes::visit(TextMatrixParser::read_scalar_type(path, context.scalar_type), [&](auto tag) {
+                typedef typename decltype(tag)::type T;
+                solve_and_load(ostream, BasicMatrixCreator<T>::parse_from_txt_file(ostream, path));
+            });
+        } catch (std::exception &e) {
+            ostream << "An exception occurred: " << e.what() << std::endl;
+        }
+    } else if (cmd == Command::BIN_INPUT) {
+        try {
+            std::string path;
+            ostream << "Enter path to the binary file: ";
+            istream >> path;
+            auto start = std::chrono::high_resolution_clock::now();
+            BinaryHeader header = BinaryMatrixFile::read_header(path);
+            if (header.storage != StorageType::DENSE) {
+                // sparse files go to the sparse elimination without expanding them
+                SparseMatrix matrix = BinaryMatrixFile::load_sparse(path);
+                ostream << "Loaded file in " << to_ms(std::chrono::high_resolution_clock::now() - start).count()
+                        << " ms." << std::endl;
+                SystemSolver::solve_with_method(*ResultSink::create(context.output_level, ostream), matrix, context);
+                loaded_system.reset();
+                loaded_factorization.reset();
+            } else {
+                ScalarTypes::visit(header.scalar_type, [&](auto tag) {
+                    typedef typename decltype(tag)::type T;
+                    BasicMatrix<T> matrix = BinaryMatrixFile::load_dense_as<T>(path);
+                    ostream << "Loaded file in " << to_ms(std::chrono::high_resolution_clock::now() - start).count()
+                            << " ms." << std::endl;
+                    solve_and_load(ostream, std::move(matrix));
+                });
+            }
+        } catch (std::exception &e) {
+            ostream << "An exception occurred: " << e.what() << std::endl;
+        }
+    } else if (cmd == Command::CONVERT) {
+        try {
+            convert_to_binary(ostream, istream);
+        } catch (std::exception &e) {
+            ostream << "An exception occurred: " << e.what() << std::endl;
+        }
+    } else if (cmd == Command::OUT_OF_CORE) {
+        try {
+            solve_out_of_core(ostream, istream);
+        } catch (std::exception &e) {
+            ostream << "An exception occurred: " << e.what() << std::endl;
+        }
+    } else if (cmd == Command::NEW_RHS) {
+        try {
+            solve_new_rhs(ostream, istream);
         } catch (std::exception &e) {
             ostream << "An exception occurred: " << e.what() << std::endl;
         }
+    } else if (cmd == Command::SET_METHOD) {
+        choose_method(ostream, istream);
+    } else if (cmd == Command::SET_OUTPUT) {
+        choose_output(ostream, istream);
+    } else if (cmd == Command::SET_TYPE) {
+        choose_type(ostream, istream);
     } else if (cmd == Command::UNKNOWN) {
         ostream << "Unknown command entered" << std::endl;
     }
+
+    if (report_statistics) {
+        Statistics::print(ostream, Statistics::get_snapshot());
+    }
 }
 
+
+void CommandInterpreter::solve_with_method(std::ostream &ostream, const Matrix &matrix) {
+    SystemSolver::solve_with_method(*ResultSink::create(context.output_level, ostream), matrix, context);
+}
+
+void CommandInterpreter::solve_and_load(std::ostream &ostream, Matrix matrix) {
+    solve_with_method(ostream, matrix);
+    loaded_system.reset(new Matrix(std::move(matrix)));
+    loaded_factorization.reset();
+}
+
+template<typename T>
+void CommandInterpreter::solve_and_load(std::ostream &ostream, BasicMatrix<T> matrix) {
+    SystemSolver::solve_with_method(*ResultSink::create(context.output_level, ostream), matrix, context);
+    loaded_system.reset();
+    loaded_factorization.reset();
+}
+
+void CommandInterpreter::solve_new_rhs(std::ostream &ostream, std::istream &istream) {
+    if (!loaded_system) {
+        ostream << "No linear system of doubles loaded yet, use cmd or txt first." << std::endl;
+        return;
+    }
+    if (!loaded_factorization) {
+        loaded_factorization.reset(new Factorization(SystemSolver::factor(*loaded_system, context)));
+    }
+
+    std::vector<double> vector_b(loaded_factorization->get_equations());
+    ostream << "Enter " << vector_b.size() << " values of the new vector b:" << std::endl;
+    for (double &value : vector_b) {
+        istream >> value;
+    }
+    if (!istream) {
+        istream.clear();
+        istream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        throw std::domain_error("Failed to read vector b.");
+    }
+    SystemSolver::solve(*ResultSink::create(context.output_level, ostream), *loaded_factorization, vector_b);
+}
+
+void CommandInterpreter::convert_to_binary(std::ostream &ostream, std::istream &istream) {
+    std::string txt_path, binary_path, storage;
+    ostream << "Enter path to the text file: ";
+    istream >> txt_path;
+    ostream << "Enter path to the binary file: ";
+    istream >> binary_path;
+    ostream << "Enter storage (dense, sparse): ";
+    istream >> storage;
+    if (storage != "dense" && storage != "sparse") {
+        ostream << "Unknown storage entered" << std::endl;
+        return;
+    }
+    BinaryMatrixFile::convert_txt(txt_path, binary_path, storage == "sparse", context.scalar_type);
+    ostream << "Converted " << txt_path << " to " << binary_path << "." << std::endl;
+}
+
+void CommandInterpreter::solve_out_of_core(std::ostream &ostream, std::istream &istream) {
+    std::string path;
+    ostream << "Enter path to the binary file: ";
+    istream >> path;
+    ostream << "Enter memory budget in MB: ";
+    long long budget;
+    istream >> budget;
+    if (!istream || budget < 1) {
+        istream.clear();
+        istream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        ostream << "Memory budget has to be positive integer." << std::endl;
+        return;
+    }
+    OutOfCoreSettings settings;
+    settings.memory_budget = static_cast<size_t>(budget) << 20u;
+    SystemSolver::solve_out_of_core(*ResultSink::create(context.output_level, ostream), path, settings);
+}
+
+void CommandInterpreter::choose_method(std::ostream &ostream, std::istream &istream) {
+    const std::map<std::string, IterativeMethod> methods{
+            {"cg",       IterativeMethod::CG},
+            {"bicgstab", IterativeMethod::BICGSTAB},
+            {"gmres",    IterativeMethod::GMRES}
+    };
+    const std::map<std::string, PreconditionerType> preconditioners{
+            {"none",   PreconditionerType::NONE},
+            {"jacobi", PreconditionerType::JACOBI},
+            {"ilu0",   PreconditionerType::ILU0}
+    };
+
+    std::string method;
+    ostream << "Enter method (direct, qr, mixed, cg, bicgstab, gmres): ";
+    istream >> method;
+    if (method == "direct") {
+        context.method = SolverMethod::DIRECT;
+        ostream << "Using direct elimination for computation." << std::endl;
+        return;
+    }
+    if (method == "qr") {
+        context.method = SolverMethod::QR;
+        ostream << "Using QR decomposition with column pivoting for computation." << std::endl;
+        return;
+    }
+    if (method == "mixed") {
+        context.method = SolverMethod::MIXED_PRECISION;
+        ostream << "Using mixed precision LU with iterative refinement for computation." << std::endl;
+        return;
+    }
+    if (methods.find(method) == methods.end()) {
+        ostream << "Unknown method entered" << std::endl;
+        return;
+    }
+
+    std::string preconditioner;
+    ostream << "Enter preconditioner (none, jacobi, ilu0): ";
+    istream >> preconditioner;
+    if (preconditioners.find(preconditioner) == preconditioners.end()) {
+        ostream << "Unknown preconditioner entered" << std::endl;
+        return;
+    }
+
+    context.method = SolverMethod::ITERATIVE;
+    context.iterative.method = methods.at(method);
+    context.iterative.preconditioner = preconditioners.at(preconditioner);
+    ostream << "Using " << method << " method with " << preconditioner << " preconditioner for computation."
+            << std::endl;
+}
+
+void CommandInterpreter::choose_output(std::ostream &ostream, std::istream &istream) {
+    std::string level;
+    ostream << "Enter output level (quiet, summary, full, csv, binary): ";
+    istream >> level;
+    try {
+        context.output_level = ResultSink::parse_level(level);
+    } catch (std::domain_error &e) {
+        ostream << "Unknown output level entered" << std::endl;
+        return;
+    }
+    ostream << "Using " << level << " output." << std::endl;
+}
+
+void CommandInterpreter::choose_type(std::ostream &ostream, std::istream &istream) {
+    std::string type;
+    ostream << "Enter type of the elements (float, double, long-double, complex): ";
+    istream >> type;
+    try {
+        context.scalar_type = ScalarTypes::parse_name(type);
+    } catch (std::domain_error &e) {
+        ostream << "Unknown type entered" << std::endl;
+        return;
+    }
+    ostream << "Using " << type << " elements." << std::endl;
+}
@@ -7,6 +7,12 @@
 
 #include <string>
 #include <map>
+#include <memory>
+#include <utility>
+
+#include "matrix.hpp"
+#include "factorization.hpp"
+#include "solver_context.hpp"
 
 /**
  * Enumeration for all commands in the application.
@@ -16,8 +22,16 @@ enum class Command {
     HELP,
     CMD_INPUT,
     TXT_INPUT,
+    BIN_INPUT,
+    CONVERT,
+    OUT_OF_CORE,
     ONE_THREAD,
     MTP_THREAD,
+    SET_THREADS,
+    NEW_RHS,
+    SET_METHOD,
+    SET_OUTPUT,
+    SET_TYPE,
     UNKNOWN
 };
 
@@ -31,8 +45,16 @@ private:
             {"h",    Command::HELP},
             {"cmd",  Command::CMD_INPUT},
             {"txt",  Command::TXT_INPUT},
+            {"bin",  Command::BIN_INPUT},
+            {"cnv",  Command::CONVERT},
+            {"ooc",  Command::OUT_OF_CORE},
             {"thd1", Command::ONE_THREAD},
-            {"thd2", Command::MTP_THREAD}
+            {"thd2", Command::MTP_THREAD},
+            {"thd",  Command::SET_THREADS},
+            {"rhs",  Command::NEW_RHS},
+            {"itr",  Command::SET_METHOD},
+            {"out",  Command::SET_OUTPUT},
+            {"typ",  Command::SET_TYPE}
     };
 
     std::map<Command, std::string> command_descriptions{
@@ -40,10 +62,109 @@ private:
             {Command::HELP,       "shows help"},
             {Command::CMD_INPUT,  "selects input from command line"},
             {Command::TXT_INPUT,  "selects input from text file"},
+            {Command::BIN_INPUT,  "selects input from binary file"},
+            {Command::CONVERT,    "converts text file to binary file"},
+            {Command::OUT_OF_CORE, "solves system from binary file larger than the memory"},
             {Command::ONE_THREAD, "sets app to use one thread for computation"},
-            {Command::MTP_THREAD, "sets app to use multiple threads for computation"}
+            {Command::MTP_THREAD, "sets app to use all hardware threads for computation"},
+            {Command::SET_THREADS, "sets number of threads used for computation"},
+            {Command::NEW_RHS,    "solves the last loaded system with new vector b from command line"},
+            {Command::SET_METHOD, "selects direct, QR, mixed precision or iterative method for computation"},
+            {Command::SET_OUTPUT, "selects output level (quiet, summary, full, csv, binary)"},
+            {Command::SET_TYPE,   "selects type of the elements (float, double, long-double, complex)"}
     };
 
+    /**
+     * Settings of the solves, changed by the thread, method, output and type commands.
+     */
+    SolverContext context;
+
+    /**
+     * Augmented matrix of the last solved linear system, nullptr if there was none or it was not double one.
+     */
+    std::unique_ptr<Matrix> loaded_system;
+
+    /**
+     * Factorization of the last solved linear system, created on the first use.
+     */
+    std::unique_ptr<Factorization> loaded_factorization;
+
+    /**
+     * Solves the linear system with the method of the context and writes the result in its output level.
+     *
+     * @param ostream output stream to write to
+     * @param matrix augmented matrix of the linear system
+     */
+    void solve_with_method(std::ostream &ostream, const Matrix &matrix);
+
+    /**
+     * Solves the linear system and remembers it for the later solves with new vectors b.
+     *
+     * @param ostream output stream to write to
+     * @param matrix augmented matrix of the linear system
+     */
+    void solve_and_load(std::ostream &ostream, Matrix matrix);
+
+    /**
+     * Solves the linear system of the other scalar type, the new vectors b are supported only for the double
+     * systems, so the loaded system is cleared.
+     *
+     * @tparam T type of the elements
+     * @param ostream output stream to write to
+     * @param matrix augmented matrix of the linear system
+     */
+    template<typename T>
+    void solve_and_load(std::ostream &ostream, BasicMatrix<T> matrix);
+
+    /**
+     * Reads new vector b from the input stream and solves the last loaded linear system with it.
+     *
+     * @param ostream output stream to write to
+     * @param istream input stream to read from
+     */
+    void solve_new_rhs(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Asks user for the paths and storage and converts the text file to the binary file.
+     *
+     * @param ostream output stream to write to
+     * @param istream input stream to read from
+     */
+    void convert_to_binary(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Asks user for the binary file and the memory budget and solves the system with the out-of-core solver.
+     *
+     * @param ostream output stream to write to
+     * @param istream input stream to read from
+     */
+    void solve_out_of_core(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Asks user for the method used for computation and for the preconditioner of the iterative methods.
+     *
+     * @param ostream output stream to write to
+     * @param istream input stream to read from
+     */
+    void choose_method(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Asks user for the output level of the solves.
+     *
+     * @param ostream output stream to write to
+     * @param istream input stream to read from
+     */
+    void choose_output(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Asks user for the type of the elements of the systems entered on the command line
+     * and of the txt files which do not name it.
+     *
+     * @param ostream output stream to write to
+     * @param istream input stream to read from
+     */
+    void choose_type(std::ostream &ostream, std::istream &istream);
+
     /**
      * Converts command string alias to Command enum field.
      *
@@ -62,10 +183,9 @@ private:
 
 public:
     /**
-     * Determines if the system solver will use multiple threads for the computation.
-     * Default value set below.
+     * @param context initial settings of the solves
      */
-    static bool USING_MULTIPLE_THREADS;
+    explicit CommandInterpreter(SolverContext context = SolverContext()) : context(std::move(context)) {}
 
     /**
      * Asks user for command alias and returns Command enum field for given alias.
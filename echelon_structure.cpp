@@ -0,0 +1,27 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <stdexcept>
+#include <utility>
+
+#include "echelon_structure.hpp"
+
+EchelonStructure::EchelonStructure(std::vector<int> pivots_columns, const int &width, const int &unknowns) :
+        width(width), unknowns(unknowns), pivots_columns(std::move(pivots_columns)), columns_rows(width, -1) {
+    pivots_rows.reserve(rank());
+    for (int k = 0; k < rank(); ++k) {
+        const int column = this->pivots_columns[k];
+        if (column < 0 || column >= width || (k > 0 && column <= this->pivots_columns[k - 1])) {
+            throw std::domain_error("pivot columns have to be increasing and inside of the matrix");
+        }
+        pivots_rows.push_back(k);
+        columns_rows[column] = k;
+    }
+    free_columns.reserve(unknowns - rank() > 0 ? unknowns - rank() : 0);
+    for (int x = 0; x < unknowns; ++x) {
+        if (columns_rows[x] < 0) {
+            free_columns.push_back(x);
+        }
+    }
+}
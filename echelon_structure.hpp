@@ -0,0 +1,67 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_ECHELON_STRUCTURE_HPP
+#define LINEAR_SYSTEM_SOLVER_ECHELON_STRUCTURE_HPP
+
+#include <vector>
+
+/**
+ * Struct representing positions of the pivots in the row echelon matrix U.
+ * <p>
+ * It is filled by the decomposition from the pivot columns it found, so the pivots never have to be searched
+ * for in U. k-th pivot lies on the row pivots_rows[k] and the column pivots_columns[k], columns_rows maps
+ * each column to the row of its pivot (-1 for the columns without pivot) and free_columns lists
+ * the unknowns without pivot in increasing order. All lookups take constant time.
+ */
+struct EchelonStructure {
+    int width = 0;
+    int unknowns = 0;
+    std::vector<int> pivots_columns;
+    std::vector<int> pivots_rows;
+    std::vector<int> columns_rows;
+    std::vector<int> free_columns;
+
+    EchelonStructure() = default;
+
+    /**
+     * Builds the structure in O(width) time.
+     *
+     * @param pivots_columns increasing column indexes of the pivots, k-th pivot has to be on k-th row
+     * @param width number of columns of U
+     * @param unknowns number of columns of U belonging to the unknowns (width - 1 for the augmented matrix)
+     */
+    EchelonStructure(std::vector<int> pivots_columns, const int &width, const int &unknowns);
+
+    /**
+     * @return number of the pivots (rank of U)
+     */
+    int rank() const {
+        return static_cast<int>(pivots_columns.size());
+    }
+
+    /**
+     * @return number of the unknowns without pivot (dimension of the kernel)
+     */
+    int defect() const {
+        return static_cast<int>(free_columns.size());
+    }
+
+    /**
+     * @param column column of U
+     * @return true if there is a pivot in the column
+     */
+    bool is_pivot_column(const int &column) const {
+        return columns_rows[column] >= 0;
+    }
+
+    /**
+     * @return true if no pivot lies behind the unknowns (in vector b of the augmented matrix)
+     */
+    bool has_solution() const {
+        return pivots_columns.empty() || pivots_columns.back() < unknowns;
+    }
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_ECHELON_STRUCTURE_HPP
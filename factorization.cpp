@@ -0,0 +1,109 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "factorization.hpp"
+#include "system_solver.hpp"
+
+Factorization::Factorization(LUDecomposition lu, double max_abs_A) :
+        lu(std::move(lu)), matrix_U(this->lu.get_upper()), max_abs_A(max_abs_A) {
+    const int unknowns = get_unknowns();
+    const int defect = unknowns - get_rank();
+    if (defect == 0) return;
+
+    // j-th kernel basis vector has 1 on j-th non pivot variable, 0 on the others and solves U * x = 0
+    Matrix solutions(defect, unknowns, false);
+    Matrix rhs(defect, get_rank(), false);
+    const EchelonStructure &echelon = this->lu.echelon;
+    for (int j = 0; j < defect; ++j) {
+        solutions.field(j, echelon.free_columns[j]) = 1;
+    }
+    SystemSolver::backward_substitution(matrix_U, echelon, rhs, solutions, 0, defect);
+
+    kernel.reserve(defect);
+    for (int j = 0; j < defect; ++j) {
+        kernel.push_back(solutions.get_column(j));
+    }
+}
+
+int Factorization::get_unknowns() const {
+    return lu.factors.width;
+}
+
+int Factorization::get_equations() const {
+    return lu.factors.height;
+}
+
+int Factorization::get_rank() const {
+    return lu.rank();
+}
+
+const LUDecomposition &Factorization::get_lu() const {
+    return lu;
+}
+
+const std::vector<std::vector<double>> &Factorization::get_kernel() const {
+    return kernel;
+}
+
+Solution Factorization::solve(const std::vector<double> &vector_b) const {
+    Matrix matrix_B(1, get_equations(), false);
+    matrix_B.set_column(0, vector_b);
+    return std::move(solve_many(matrix_B)[0]);
+}
+
+std::vector<Solution> Factorization::solve_many(const Matrix &matrix_B) const {
+    if (matrix_B.height != get_equations()) {
+        throw std::domain_error("not right number of right-hand side values given");
+    }
+    const int rhs_count = matrix_B.width;
+    const int rank = get_rank();
+    const std::vector<int> &pivots_columns = lu.echelon.pivots_columns;
+
+    // apply the row permutation, then the forward substitution with L (Ly = Pb) on all right-hand sides at once
+    Matrix rhs(rhs_count, get_equations(), false);
+    for (int y = 0; y < get_equations(); ++y) {
+        ConstRowView source = matrix_B.row(lu.permutation[y]);
+        std::copy(source.begin(), source.end(), rhs.row(y).begin());
+    }
+    for (int k = 0; k < rank; ++k) {
+        const double *row_k = &rhs.field(0, k);
+        for (int y = k + 1; y < get_equations(); ++y) {
+            const double multiplier = lu.factors.field(pivots_columns[k], y);
+            if (multiplier == 0) continue;
+            double *row_y = &rhs.field(0, y);
+            for (int c = 0; c < rhs_count; ++c) {
+                row_y[c] -= multiplier * row_k[c];
+            }
+        }
+    }
+
+    // equations without pivot have to be satisfied already, otherwise the system has no solution
+    std::vector<Solution> result(rhs_count);
+    for (int c = 0; c < rhs_count; ++c) {
+        double max_abs = max_abs_A;
+        for (int y = 0; y < get_equations(); ++y) {
+            max_abs = std::max(max_abs, std::abs(matrix_B.field(c, y)));
+        }
+        const double tolerance = std::max(get_unknowns() + 1, get_equations()) *
+                                 std::numeric_limits<double>::epsilon() * max_abs;
+        result[c].exists = true;
+        for (int y = rank; y < get_equations() && result[c].exists; ++y) {
+            result[c].exists = std::abs(rhs.field(c, y)) <= tolerance;
+        }
+    }
+
+    Matrix solutions(rhs_count, get_unknowns(), false);
+    SystemSolver::backward_substitution(matrix_U, lu.echelon, rhs, solutions, 0, rhs_count);
+
+    for (int c = 0; c < rhs_count; ++c) {
+        if (result[c].exists) {
+            result[c].particular_solution = solutions.get_column(c);
+        }
+    }
+    return result;
+}
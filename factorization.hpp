@@ -0,0 +1,88 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_FACTORIZATION_HPP
+#define LINEAR_SYSTEM_SOLVER_FACTORIZATION_HPP
+
+#include <vector>
+
+#include "matrix.hpp"
+#include "lu_decomposition.hpp"
+
+/**
+ * Struct representing solution of the system for one vector b.
+ * <p>
+ * Particular solution has all non pivot variables set to 0. It is empty if the system has no solution.
+ */
+struct Solution {
+    bool exists;
+    std::vector<double> particular_solution;
+};
+
+/**
+ * Class representing factorized matrix A of the linear system Ax = b.
+ * <p>
+ * Keeps the LU decomposition, pivot structure and basis of the kernel of A, so solving the system
+ * for new vector b needs only the forward and backward substitution, which is O(width * height).
+ * Instances are created by SystemSolver::factor.
+ */
+class Factorization {
+private:
+    friend class SystemSolver;
+
+    LUDecomposition lu;
+    Matrix matrix_U;
+    double max_abs_A;
+    std::vector<std::vector<double>> kernel;
+
+    /**
+     * @param lu decomposition of the matrix A
+     * @param max_abs_A largest magnitude of the elements of A
+     */
+    Factorization(LUDecomposition lu, double max_abs_A);
+
+public:
+    /**
+     * @return number of unknowns of the system (width of A)
+     */
+    int get_unknowns() const;
+
+    /**
+     * @return number of equations of the system (height of A)
+     */
+    int get_equations() const;
+
+    /**
+     * @return rank of the matrix A
+     */
+    int get_rank() const;
+
+    /**
+     * @return LU decomposition of the matrix A
+     */
+    const LUDecomposition &get_lu() const;
+
+    /**
+     * @return basis of the kernel of the matrix A (empty if the kernel is trivial)
+     */
+    const std::vector<std::vector<double>> &get_kernel() const;
+
+    /**
+     * Solves the system for the given vector b.
+     *
+     * @param vector_b right-hand side of the system with one element for each equation
+     * @return Solution of the system
+     */
+    Solution solve(const std::vector<double> &vector_b) const;
+
+    /**
+     * Solves the system for all the given vectors b at once.
+     *
+     * @param matrix_B matrix with one right-hand side in each column (height equal to number of equations)
+     * @return vector of Solution structs, one for each column of matrix_B
+     */
+    std::vector<Solution> solve_many(const Matrix &matrix_B) const;
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_FACTORIZATION_HPP
@@ -0,0 +1,53 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "fixed_matrix.hpp"
+
+namespace {
+    using FixedSolveFunction = bool (*)(const Matrix &, std::vector<double> &);
+
+    /**
+     * The nested StaticFor lambdas exceed the inlining limits of the compiler for the larger sizes,
+     * flatten inlines all of them, so the kernel is one straight block of code.
+     */
+    template<int N>
+    __attribute__((flatten))
+    bool solve_fixed(const Matrix &matrix, std::vector<double> &solution) {
+        FixedMatrix<N, N + 1> fixed;
+        for (int y = 0; y < N; ++y) {
+            const double *row = &matrix.field(0, y);
+            std::copy(row, row + N + 1, &fixed.field(0, y));
+        }
+        FixedVector<N> fixed_solution;
+        if (!FixedKernels::solve(fixed, fixed_solution)) {
+            return false;
+        }
+        solution.assign(fixed_solution.begin(), fixed_solution.end());
+        return true;
+    }
+
+    template<int... Offsets>
+    std::array<FixedSolveFunction, sizeof...(Offsets)> create_kernels(std::integer_sequence<int, Offsets...>) {
+        return {{&solve_fixed<FIXED_SIZE_MIN + Offsets>...}};
+    }
+
+    /**
+     * Kernel for each supported size, the kernel for n unknowns is on index n - FIXED_SIZE_MIN.
+     */
+    const std::array<FixedSolveFunction, FIXED_SIZE_MAX - FIXED_SIZE_MIN + 1> KERNELS =
+            create_kernels(std::make_integer_sequence<int, FIXED_SIZE_MAX - FIXED_SIZE_MIN + 1>());
+}
+
+bool FixedSizeSolver::is_supported(const Matrix &matrix) {
+    const int unknowns = matrix.width - 1;
+    return matrix.augmented && unknowns == matrix.height && unknowns >= FIXED_SIZE_MIN && unknowns <= FIXED_SIZE_MAX;
+}
+
+bool FixedSizeSolver::solve(const Matrix &matrix, std::vector<double> &solution) {
+    return KERNELS[matrix.height - FIXED_SIZE_MIN](matrix, solution);
+}
@@ -0,0 +1,219 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_FIXED_MATRIX_HPP
+#define LINEAR_SYSTEM_SOLVER_FIXED_MATRIX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "matrix.hpp"
+
+/**
+ * Constant representing the smallest number of unknowns of the systems solved by the fixed size kernels.
+ */
+#define FIXED_SIZE_MIN 2
+
+/**
+ * Constant representing the largest number of unknowns of the systems solved by the fixed size kernels.
+ * Each size between FIXED_SIZE_MIN and FIXED_SIZE_MAX gets its own fully unrolled kernel.
+ */
+#define FIXED_SIZE_MAX 16
+
+/**
+ * Struct representing matrix with dimensions known at compile time. The elements are stored row after row
+ * in std::array, so the matrix lives on the stack and all indexes are constant after unrolling.
+ *
+ * @tparam Rows number of rows
+ * @tparam Cols number of columns
+ * @tparam T type of the elements
+ */
+template<int Rows, int Cols, typename T = double>
+struct FixedMatrix {
+    static constexpr int rows = Rows;
+    static constexpr int cols = Cols;
+
+    std::array<T, static_cast<size_t>(Rows) * Cols> data;
+
+    /**
+     * @param x index of the column in which the field is (zero based)
+     * @param y index of the row in which the field is (zero based)
+     * @return reference to element on [x,y] coords in the matrix
+     */
+    T &field(const int &x, const int &y) {
+        return data[x + Cols * y];
+    }
+
+    const T &field(const int &x, const int &y) const {
+        return data[x + Cols * y];
+    }
+};
+
+/**
+ * Vector with dimension known at compile time.
+ *
+ * @tparam N number of elements
+ * @tparam T type of the elements
+ */
+template<int N, typename T = double>
+using FixedVector = std::array<T, static_cast<size_t>(N)>;
+
+/**
+ * Struct calling the body for each index from Begin to End - 1. The recursion is resolved at compile time,
+ * so the loop is always fully unrolled. The body gets std::integral_constant, its value can be used
+ * as template argument of the nested loops.
+ *
+ * @tparam Begin first index
+ * @tparam End index after the last index
+ */
+template<int Begin, int End, typename Enable = void>
+struct StaticFor {
+    template<typename F>
+    static void run(F &&body) {
+        body(std::integral_constant<int, Begin>());
+        StaticFor<Begin + 1, End>::run(body);
+    }
+};
+
+template<int Begin, int End>
+struct StaticFor<Begin, End, typename std::enable_if<Begin >= End>::type> {
+    template<typename F>
+    static void run(F &&) {}
+};
+
+/**
+ * Class responsible for solving the square regular systems with dimensions known at compile time.
+ * <p>
+ * The elimination does the same operations as LUDecomposer::decompose_in_place with the same pivots,
+ * so the solution is the same. The loops over the pivots and the rows are unrolled, the updates of the rows
+ * are loops with constant trip count, which the compiler unrolls and vectorizes, and the matrix stays on the stack.
+ */
+class FixedKernels {
+public:
+    /**
+     * Gaussian elimination with partial pivoting of the augmented matrix, U with the transformed vector b
+     * is left in the upper triangle and the last column.
+     *
+     * @tparam N number of unknowns
+     * @tparam T type of the elements
+     * @param matrix augmented matrix of the square system
+     * @param tolerance magnitude under which the pivots are considered zero
+     * @return false if some pivot is not larger than the tolerance, the matrix is not finished then
+     */
+    template<int N, typename T>
+    static bool eliminate(FixedMatrix<N, N + 1, T> &matrix, const T &tolerance) {
+        bool regular = true;
+        StaticFor<0, N>::run([&](auto k_constant) {
+            constexpr int k = decltype(k_constant)::value;
+            if (!regular) return;
+
+            int pivot = k;
+            T pivot_max = std::abs(matrix.field(k, k));
+            StaticFor<k + 1, N>::run([&](auto y_constant) {
+                constexpr int y = decltype(y_constant)::value;
+                T e = std::abs(matrix.field(k, y));
+                if (e > pivot_max) {
+                    pivot_max = e;
+                    pivot = y;
+                }
+            });
+            if (pivot_max <= tolerance) {
+                regular = false;
+                return;
+            }
+            if (pivot != k) {
+                std::swap_ranges(&matrix.field(k, k), &matrix.field(N + 1, k), &matrix.field(k, pivot));
+            }
+
+            // the rows are updated by loops with constant trip count, which the compiler vectorizes
+            StaticFor<k + 1, N>::run([&](auto y_constant) {
+                constexpr int y = decltype(y_constant)::value;
+                const T multiplier = matrix.field(k, y) / matrix.field(k, k);
+                T *row = &matrix.field(0, y);
+                const T *pivot_row = &matrix.field(0, k);
+                for (int x = k + 1; x < N + 1; ++x) {
+                    row[x] -= multiplier * pivot_row[x];
+                }
+            });
+        });
+        return regular;
+    }
+
+    /**
+     * Backward substitution with the upper triangular part of the eliminated augmented matrix.
+     *
+     * @tparam N number of unknowns
+     * @tparam T type of the elements
+     * @param matrix_U augmented matrix after eliminate
+     * @param solution solution of the system
+     */
+    template<int N, typename T>
+    static void back_substitute(const FixedMatrix<N, N + 1, T> &matrix_U, FixedVector<N, T> &solution) {
+        StaticFor<0, N>::run([&](auto i_constant) {
+            constexpr int k = N - 1 - decltype(i_constant)::value;
+            T sum = matrix_U.field(N, k);
+            StaticFor<k + 1, N>::run([&](auto x_constant) {
+                constexpr int x = decltype(x_constant)::value;
+                sum -= matrix_U.field(x, k) * solution[x];
+            });
+            solution[k] = sum / matrix_U.field(k, k);
+        });
+    }
+
+    /**
+     * Solves the square system, the tolerance is the same as LUDecomposer::get_zero_tolerance gives.
+     *
+     * @tparam N number of unknowns
+     * @tparam T type of the elements
+     * @param matrix augmented matrix of the square system, it is overwritten by the elimination
+     * @param solution solution of the system
+     * @return false if the matrix A is singular (or nearly singular), the solution is not set then
+     */
+    template<int N, typename T>
+    static bool solve(FixedMatrix<N, N + 1, T> &matrix, FixedVector<N, T> &solution) {
+        // vector b (every (N + 1)-th element) does not take part, as in LUDecomposer::get_zero_tolerance
+        T max_abs = 0;
+        StaticFor<0, N * (N + 1)>::run([&](auto i_constant) {
+            constexpr int i = decltype(i_constant)::value;
+            if (i % (N + 1) != N) {
+                max_abs = std::max(max_abs, std::abs(matrix.data[i]));
+            }
+        });
+        const T tolerance = (N + 1) * std::numeric_limits<T>::epsilon() * max_abs;
+        if (!eliminate(matrix, tolerance)) {
+            return false;
+        }
+        back_substitute(matrix, solution);
+        return true;
+    }
+};
+
+/**
+ * Class responsible for passing the small systems from the runtime sized Matrix to the fixed size kernels.
+ */
+class FixedSizeSolver {
+public:
+    /**
+     * @param matrix matrix of the system
+     * @return true if the matrix is augmented square system with number of unknowns
+     * from FIXED_SIZE_MIN to FIXED_SIZE_MAX
+     */
+    static bool is_supported(const Matrix &matrix);
+
+    /**
+     * Solves the system with the kernel instantiated for its size.
+     *
+     * @param matrix augmented matrix of the square system, is_supported has to be true for it
+     * @param solution unique solution of the system
+     * @return false if the matrix A is singular (or nearly singular), the general solver has to be used then
+     */
+    static bool solve(const Matrix &matrix, std::vector<double> &solution);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_FIXED_MATRIX_HPP
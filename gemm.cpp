@@ -0,0 +1,367 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LSS_GEMM_X86
+
+#include <immintrin.h>
+
+#endif
+
+#include "gemm.hpp"
+
+namespace {
+    /**
+     * Number of columns of A (rows of B) in one packed block, the packed panels of the block fit into L1 cache.
+     */
+    const int KC = 256;
+
+    /**
+     * Number of rows of A in one packed block, the packed block fits into L2 cache.
+     */
+    const int MC = 96;
+
+    /**
+     * Number of columns of B in one packed block.
+     */
+    const int NC = 2048;
+
+    /**
+     * Computes C += alpha * a * b for one MR * NR tile, a and b are packed panels of length kc.
+     */
+    template<typename T>
+    using MicroKernel = void (*)(int kc, const T *a, const T *b, T *c, int ldc, T alpha);
+
+    template<typename T>
+    struct KernelInfo {
+        GemmKernel type;
+        int mr;
+        int nr;
+        MicroKernel<T> kernel;
+    };
+
+    template<typename T, int MR, int NR>
+    void scalar_kernel(int kc, const T *a, const T *b, T *c, int ldc, T alpha) {
+        T acc[MR][NR] = {};
+        for (int p = 0; p < kc; ++p) {
+            for (int i = 0; i < MR; ++i) {
+                for (int j = 0; j < NR; ++j) {
+                    acc[i][j] += a[i] * b[j];
+                }
+            }
+            a += MR;
+            b += NR;
+        }
+        for (int i = 0; i < MR; ++i) {
+            for (int j = 0; j < NR; ++j) {
+                c[static_cast<size_t>(i) * ldc + j] += alpha * acc[i][j];
+            }
+        }
+    }
+
+#ifdef LSS_GEMM_X86
+
+    __attribute__((target("avx2,fma")))
+    void avx2_kernel(int kc, const double *a, const double *b, double *c, int ldc, double alpha) {
+        const int MR = 6;
+        __m256d acc[MR][2];
+        for (int i = 0; i < MR; ++i) {
+            acc[i][0] = _mm256_setzero_pd();
+            acc[i][1] = _mm256_setzero_pd();
+        }
+        for (int p = 0; p < kc; ++p) {
+            __m256d b0 = _mm256_loadu_pd(b);
+            __m256d b1 = _mm256_loadu_pd(b + 4);
+            for (int i = 0; i < MR; ++i) {
+                __m256d ai = _mm256_broadcast_sd(a + i);
+                acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+            }
+            a += MR;
+            b += 8;
+        }
+        __m256d alpha_v = _mm256_set1_pd(alpha);
+        for (int i = 0; i < MR; ++i) {
+            double *ci = c + static_cast<size_t>(i) * ldc;
+            _mm256_storeu_pd(ci, _mm256_fmadd_pd(alpha_v, acc[i][0], _mm256_loadu_pd(ci)));
+            _mm256_storeu_pd(ci + 4, _mm256_fmadd_pd(alpha_v, acc[i][1], _mm256_loadu_pd(ci + 4)));
+        }
+    }
+
+    __attribute__((target("avx2,fma")))
+    void avx2_kernel(int kc, const float *a, const float *b, float *c, int ldc, float alpha) {
+        const int MR = 6;
+        __m256 acc[MR][2];
+        for (int i = 0; i < MR; ++i) {
+            acc[i][0] = _mm256_setzero_ps();
+            acc[i][1] = _mm256_setzero_ps();
+        }
+        for (int p = 0; p < kc; ++p) {
+            __m256 b0 = _mm256_loadu_ps(b);
+            __m256 b1 = _mm256_loadu_ps(b + 8);
+            for (int i = 0; i < MR; ++i) {
+                __m256 ai = _mm256_broadcast_ss(a + i);
+                acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+            }
+            a += MR;
+            b += 16;
+        }
+        __m256 alpha_v = _mm256_set1_ps(alpha);
+        for (int i = 0; i < MR; ++i) {
+            float *ci = c + static_cast<size_t>(i) * ldc;
+            _mm256_storeu_ps(ci, _mm256_fmadd_ps(alpha_v, acc[i][0], _mm256_loadu_ps(ci)));
+            _mm256_storeu_ps(ci + 8, _mm256_fmadd_ps(alpha_v, acc[i][1], _mm256_loadu_ps(ci + 8)));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void avx512_kernel(int kc, const double *a, const double *b, double *c, int ldc, double alpha) {
+        const int MR = 8;
+        __m512d acc[MR][2];
+        for (int i = 0; i < MR; ++i) {
+            acc[i][0] = _mm512_setzero_pd();
+            acc[i][1] = _mm512_setzero_pd();
+        }
+        for (int p = 0; p < kc; ++p) {
+            __m512d b0 = _mm512_loadu_pd(b);
+            __m512d b1 = _mm512_loadu_pd(b + 8);
+            for (int i = 0; i < MR; ++i) {
+                __m512d ai = _mm512_set1_pd(a[i]);
+                acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+            }
+            a += MR;
+            b += 16;
+        }
+        __m512d alpha_v = _mm512_set1_pd(alpha);
+        for (int i = 0; i < MR; ++i) {
+            double *ci = c + static_cast<size_t>(i) * ldc;
+            _mm512_storeu_pd(ci, _mm512_fmadd_pd(alpha_v, acc[i][0], _mm512_loadu_pd(ci)));
+            _mm512_storeu_pd(ci + 8, _mm512_fmadd_pd(alpha_v, acc[i][1], _mm512_loadu_pd(ci + 8)));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void avx512_kernel(int kc, const float *a, const float *b, float *c, int ldc, float alpha) {
+        const int MR = 8;
+        __m512 acc[MR][2];
+        for (int i = 0; i < MR; ++i) {
+            acc[i][0] = _mm512_setzero_ps();
+            acc[i][1] = _mm512_setzero_ps();
+        }
+        for (int p = 0; p < kc; ++p) {
+            __m512 b0 = _mm512_loadu_ps(b);
+            __m512 b1 = _mm512_loadu_ps(b + 16);
+            for (int i = 0; i < MR; ++i) {
+                __m512 ai = _mm512_set1_ps(a[i]);
+                acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+            }
+            a += MR;
+            b += 32;
+        }
+        __m512 alpha_v = _mm512_set1_ps(alpha);
+        for (int i = 0; i < MR; ++i) {
+            float *ci = c + static_cast<size_t>(i) * ldc;
+            _mm512_storeu_ps(ci, _mm512_fmadd_ps(alpha_v, acc[i][0], _mm512_loadu_ps(ci)));
+            _mm512_storeu_ps(ci + 16, _mm512_fmadd_ps(alpha_v, acc[i][1], _mm512_loadu_ps(ci + 16)));
+        }
+    }
+
+#endif
+
+    /**
+     * Micro-kernels of the element type, the float kernels have the same number of rows and twice the columns.
+     */
+    template<typename T>
+    struct Kernels;
+
+    template<>
+    struct Kernels<double> {
+        static constexpr KernelInfo<double> SCALAR{GemmKernel::SCALAR, 4, 4, &scalar_kernel<double, 4, 4>};
+#ifdef LSS_GEMM_X86
+        static constexpr KernelInfo<double> AVX2{GemmKernel::AVX2, 6, 8, &avx2_kernel};
+        static constexpr KernelInfo<double> AVX512{GemmKernel::AVX512, 8, 16, &avx512_kernel};
+#endif
+    };
+
+    template<>
+    struct Kernels<float> {
+        static constexpr KernelInfo<float> SCALAR{GemmKernel::SCALAR, 4, 8, &scalar_kernel<float, 4, 8>};
+#ifdef LSS_GEMM_X86
+        static constexpr KernelInfo<float> AVX2{GemmKernel::AVX2, 6, 16, &avx2_kernel};
+        static constexpr KernelInfo<float> AVX512{GemmKernel::AVX512, 8, 32, &avx512_kernel};
+#endif
+    };
+
+    constexpr KernelInfo<double> Kernels<double>::SCALAR;
+    constexpr KernelInfo<float> Kernels<float>::SCALAR;
+#ifdef LSS_GEMM_X86
+    constexpr KernelInfo<double> Kernels<double>::AVX2;
+    constexpr KernelInfo<double> Kernels<double>::AVX512;
+    constexpr KernelInfo<float> Kernels<float>::AVX2;
+    constexpr KernelInfo<float> Kernels<float>::AVX512;
+#endif
+
+    bool is_supported(GemmKernel kernel) {
+#ifdef LSS_GEMM_X86
+        if (kernel == GemmKernel::AVX512) {
+            return __builtin_cpu_supports("avx512f");
+        }
+        if (kernel == GemmKernel::AVX2) {
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        }
+#endif
+        return kernel == GemmKernel::SCALAR;
+    }
+
+    GemmKernel detect_kernel() {
+        for (GemmKernel kernel : {GemmKernel::AVX512, GemmKernel::AVX2}) {
+            if (is_supported(kernel)) return kernel;
+        }
+        return GemmKernel::SCALAR;
+    }
+
+    std::atomic<GemmKernel> &selected_kernel() {
+        static std::atomic<GemmKernel> kernel(detect_kernel());
+        return kernel;
+    }
+
+    template<typename T>
+    const KernelInfo<T> &get_kernel_info(GemmKernel kernel) {
+#ifdef LSS_GEMM_X86
+        if (kernel == GemmKernel::AVX512) return Kernels<T>::AVX512;
+        if (kernel == GemmKernel::AVX2) return Kernels<T>::AVX2;
+#endif
+        return Kernels<T>::SCALAR;
+    }
+
+    /**
+     * Packs mc * kc block of A into panels of mr rows, each panel is stored column after column.
+     * Rows missing in the last panel are filled with zeros.
+     */
+    template<typename T>
+    void pack_a(int mc, int kc, const T *A, int lda, int mr, T *buffer) {
+        for (int i = 0; i < mc; i += mr) {
+            int rows = std::min(mr, mc - i);
+            for (int p = 0; p < kc; ++p) {
+                for (int r = 0; r < rows; ++r) {
+                    buffer[r] = A[static_cast<size_t>(i + r) * lda + p];
+                }
+                std::fill(buffer + rows, buffer + mr, T(0));
+                buffer += mr;
+            }
+        }
+    }
+
+    /**
+     * Packs kc * nc block of B into panels of nr columns, each panel is stored row after row.
+     * Columns missing in the last panel are filled with zeros.
+     */
+    template<typename T>
+    void pack_b(int kc, int nc, const T *B, int ldb, int nr, T *buffer) {
+        for (int j = 0; j < nc; j += nr) {
+            int cols = std::min(nr, nc - j);
+            for (int p = 0; p < kc; ++p) {
+                const T *b_row = B + static_cast<size_t>(p) * ldb + j;
+                std::copy(b_row, b_row + cols, buffer);
+                std::fill(buffer + cols, buffer + nr, T(0));
+                buffer += nr;
+            }
+        }
+    }
+
+    int round_up(int value, int multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    template<typename T>
+    void multiply_add_blocked(int m, int n, int k, T alpha, const T *A, int lda, const T *B, int ldb, T *C, int ldc) {
+        if (m <= 0 || n <= 0 || k <= 0 || alpha == 0) return;
+
+        const KernelInfo<T> &info = get_kernel_info<T>(GemmEngine::get_kernel());
+        const int mr = info.mr;
+        const int nr = info.nr;
+
+        std::vector<T> packed_a(static_cast<size_t>(round_up(std::min(MC, m), mr)) * KC);
+        std::vector<T> packed_b(static_cast<size_t>(round_up(std::min(NC, n), nr)) * KC);
+        T edge_tile[8 * 32];
+
+        for (int jc = 0; jc < n; jc += NC) {
+            int nc = std::min(NC, n - jc);
+            for (int pc = 0; pc < k; pc += KC) {
+                int kc = std::min(KC, k - pc);
+                pack_b(kc, nc, B + static_cast<size_t>(pc) * ldb + jc, ldb, nr, packed_b.data());
+
+                for (int ic = 0; ic < m; ic += MC) {
+                    int mc = std::min(MC, m - ic);
+                    pack_a(mc, kc, A + static_cast<size_t>(ic) * lda + pc, lda, mr, packed_a.data());
+
+                    for (int jr = 0; jr < nc; jr += nr) {
+                        int cols = std::min(nr, nc - jr);
+                        const T *b_panel = packed_b.data() + jr * kc;
+                        for (int ir = 0; ir < mc; ir += mr) {
+                            int rows = std::min(mr, mc - ir);
+                            const T *a_panel = packed_a.data() + ir * kc;
+                            T *c_tile = C + static_cast<size_t>(ic + ir) * ldc + jc + jr;
+
+                            if (rows == mr && cols == nr) {
+                                info.kernel(kc, a_panel, b_panel, c_tile, ldc, alpha);
+                            } else {
+                                // partial tile on the border of C, compute it aside and add only the valid part
+                                std::fill(edge_tile, edge_tile + mr * nr, T(0));
+                                info.kernel(kc, a_panel, b_panel, edge_tile, nr, alpha);
+                                for (int i = 0; i < rows; ++i) {
+                                    for (int j = 0; j < cols; ++j) {
+                                        c_tile[static_cast<size_t>(i) * ldc + j] += edge_tile[i * nr + j];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void GemmEngine::multiply_add(int m, int n, int k, double alpha,
+                              const double *A, int lda, const double *B, int ldb, double *C, int ldc) {
+    multiply_add_blocked(m, n, k, alpha, A, lda, B, ldb, C, ldc);
+}
+
+void GemmEngine::multiply_add(int m, int n, int k, float alpha,
+                              const float *A, int lda, const float *B, int ldb, float *C, int ldc) {
+    multiply_add_blocked(m, n, k, alpha, A, lda, B, ldb, C, ldc);
+}
+
+void GemmEngine::set_kernel(GemmKernel kernel) {
+    if (kernel == GemmKernel::AUTO || !is_supported(kernel)) {
+        kernel = detect_kernel();
+    }
+    selected_kernel().store(kernel);
+}
+
+GemmKernel GemmEngine::get_kernel() {
+    return selected_kernel().load();
+}
+
+std::string GemmEngine::get_kernel_name(GemmKernel kernel) {
+    switch (kernel) {
+        case GemmKernel::AUTO:
+            return "auto";
+        case GemmKernel::SCALAR:
+            return "scalar";
+        case GemmKernel::AVX2:
+            return "avx2";
+        case GemmKernel::AVX512:
+            return "avx512";
+    }
+    return "";
+}
@@ -0,0 +1,72 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_GEMM_HPP
+#define LINEAR_SYSTEM_SOLVER_GEMM_HPP
+
+#include <string>
+
+/**
+ * Enumeration for all implementations of the matrix multiplication kernel.
+ */
+enum class GemmKernel {
+    AUTO,
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+/**
+ * Class responsible for multiplication of dense row-major matrices.
+ * <p>
+ * The multiplication is blocked for L1 and L2 caches, panels of both operands are packed into contiguous buffers
+ * and the innermost tile is computed in registers by micro-kernel. The micro-kernel is chosen on the first use
+ * according to the instruction sets the processor supports, scalar implementation is used as fallback.
+ */
+class GemmEngine {
+public:
+    /**
+     * Computes C += alpha * A * B.
+     *
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param k number of columns of A and rows of B
+     * @param alpha scalar multiplying the product
+     * @param A pointer to the first element of A
+     * @param lda distance between two rows of A
+     * @param B pointer to the first element of B
+     * @param ldb distance between two rows of B
+     * @param C pointer to the first element of C
+     * @param ldc distance between two rows of C
+     */
+    static void multiply_add(int m, int n, int k, double alpha,
+                             const double *A, int lda, const double *B, int ldb, double *C, int ldc);
+
+    /**
+     * Computes C += alpha * A * B in single precision, same as the double multiply_add.
+     */
+    static void multiply_add(int m, int n, int k, float alpha,
+                             const float *A, int lda, const float *B, int ldb, float *C, int ldc);
+
+    /**
+     * Forces usage of the given kernel. GemmKernel::AUTO restores the detection.
+     * Kernel that is not supported by the processor is replaced by the best supported one.
+     *
+     * @param kernel kernel to be used
+     */
+    static void set_kernel(GemmKernel kernel);
+
+    /**
+     * @return kernel used for the multiplication
+     */
+    static GemmKernel get_kernel();
+
+    /**
+     * @param kernel kernel to get name of
+     * @return name of the kernel as string
+     */
+    static std::string get_kernel_name(GemmKernel kernel);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_GEMM_HPP
@@ -0,0 +1,441 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "iterative_solver.hpp"
+
+namespace {
+    double dot(const std::vector<double> &x, const std::vector<double> &y) {
+        double sum = 0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            sum += x[i] * y[i];
+        }
+        return sum;
+    }
+
+    double norm(const std::vector<double> &x) {
+        return std::sqrt(dot(x, x));
+    }
+
+    /**
+     * Computes y = y + alpha * x.
+     */
+    void axpy(double alpha, const std::vector<double> &x, std::vector<double> &y) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    /**
+     * @return number of unknowns of the square matrix, vector b of the augmented matrix is not counted
+     */
+    int get_unknowns(int width, int height, bool augmented) {
+        int unknowns = augmented ? width - 1 : width;
+        if (unknowns != height) {
+            throw std::domain_error("iterative methods need square matrix of the system");
+        }
+        return unknowns;
+    }
+
+    /**
+     * Prepares result with x = 0 and the first residual, which is ||b|| / ||b|| = 1 (or 0 for b = 0).
+     */
+    IterativeResult start_result(const std::vector<double> &b) {
+        IterativeResult result;
+        result.solution.assign(b.size(), 0.0);
+        result.iterations = 0;
+        result.converged = norm(b) == 0;
+        result.residual_history.push_back(result.converged ? 0.0 : 1.0);
+        return result;
+    }
+
+    /**
+     * @return vector b of the sparse augmented matrix, the last element of the row in CSR or the last column in CSC
+     */
+    std::vector<double> get_vector_b(const SparseMatrix &matrix) {
+        std::vector<double> b(matrix.height, 0.0);
+        const int b_index = matrix.width - 1;
+        if (matrix.format == SparseFormat::CSR) {
+            for (int row = 0; row < matrix.height; ++row) {
+                const int last = matrix.offsets[row + 1] - 1;
+                if (last >= matrix.offsets[row] && matrix.indexes[last] == b_index) {
+                    b[row] = matrix.values[last];
+                }
+            }
+        } else {
+            for (int i = matrix.offsets[b_index]; i < matrix.offsets[b_index + 1]; ++i) {
+                b[matrix.indexes[i]] = matrix.values[i];
+            }
+        }
+        return b;
+    }
+
+    /**
+     * @return preconditioner of the given type built from the sparse matrix
+     */
+    std::unique_ptr<Preconditioner> create_preconditioner(const SparseMatrix &matrix, PreconditionerType type) {
+        if (type == PreconditionerType::JACOBI) {
+            return std::unique_ptr<Preconditioner>(new JacobiPreconditioner(matrix));
+        } else if (type == PreconditionerType::ILU0) {
+            return std::unique_ptr<Preconditioner>(new ILU0Preconditioner(matrix));
+        }
+        return std::unique_ptr<Preconditioner>(new IdentityPreconditioner());
+    }
+}
+
+DenseOperator::DenseOperator(const Matrix &matrix) : matrix(matrix) {
+    get_unknowns(matrix.width, matrix.height, matrix.augmented);
+}
+
+int DenseOperator::get_size() const {
+    return matrix.height;
+}
+
+void DenseOperator::apply(const std::vector<double> &x, std::vector<double> &y) const {
+    for (int row = 0; row < matrix.height; ++row) {
+        const double *a = &matrix.field(0, row);
+        double sum = 0;
+        for (int column = 0; column < get_size(); ++column) {
+            sum += a[column] * x[column];
+        }
+        y[row] = sum;
+    }
+}
+
+SparseOperator::SparseOperator(const SparseMatrix &matrix) : matrix(matrix.to_format(SparseFormat::CSR)) {
+    get_unknowns(matrix.width, matrix.height, matrix.augmented);
+}
+
+int SparseOperator::get_size() const {
+    return matrix.height;
+}
+
+void SparseOperator::apply(const std::vector<double> &x, std::vector<double> &y) const {
+    for (int row = 0; row < matrix.height; ++row) {
+        double sum = 0;
+        for (int i = matrix.offsets[row]; i < matrix.offsets[row + 1] && matrix.indexes[i] < get_size(); ++i) {
+            sum += matrix.values[i] * x[matrix.indexes[i]];
+        }
+        y[row] = sum;
+    }
+}
+
+void IdentityPreconditioner::apply(const std::vector<double> &r, std::vector<double> &z) const {
+    z = r;
+}
+
+JacobiPreconditioner::JacobiPreconditioner(const SparseMatrix &matrix) :
+        inverse_diagonal(get_unknowns(matrix.width, matrix.height, matrix.augmented), 1.0) {
+    for (int i = 0; i < matrix.height; ++i) {
+        double diagonal = matrix.get_field(i, i);
+        if (diagonal != 0) {
+            inverse_diagonal[i] = 1 / diagonal;
+        }
+    }
+}
+
+void JacobiPreconditioner::apply(const std::vector<double> &r, std::vector<double> &z) const {
+    for (size_t i = 0; i < r.size(); ++i) {
+        z[i] = inverse_diagonal[i] * r[i];
+    }
+}
+
+ILU0Preconditioner::ILU0Preconditioner(const SparseMatrix &matrix) :
+        factors(matrix.height, matrix.height, false) {
+    const int n = get_unknowns(matrix.width, matrix.height, matrix.augmented);
+    const SparseMatrix csr = matrix.to_format(SparseFormat::CSR);
+
+    // copy A without vector b
+    for (int row = 0; row < n; ++row) {
+        for (int i = csr.offsets[row]; i < csr.offsets[row + 1] && csr.indexes[i] < n; ++i) {
+            factors.indexes.push_back(csr.indexes[i]);
+            factors.values.push_back(csr.values[i]);
+        }
+        factors.offsets[row + 1] = factors.indexes.size();
+    }
+
+    diagonal_positions.assign(n, -1);
+    std::vector<int> positions(n, -1);
+    for (int row = 0; row < n; ++row) {
+        const int first = factors.offsets[row];
+        const int last = factors.offsets[row + 1];
+        for (int i = first; i < last; ++i) {
+            positions[factors.indexes[i]] = i;
+        }
+        // eliminate the elements left of the diagonal, updates only the existing elements of the row
+        for (int i = first; i < last && factors.indexes[i] < row; ++i) {
+            const int k = factors.indexes[i];
+            factors.values[i] /= factors.values[diagonal_positions[k]];
+            for (int j = diagonal_positions[k] + 1; j < factors.offsets[k + 1]; ++j) {
+                int position = positions[factors.indexes[j]];
+                if (position != -1) {
+                    factors.values[position] -= factors.values[i] * factors.values[j];
+                }
+            }
+        }
+        diagonal_positions[row] = positions[row];
+        if (diagonal_positions[row] == -1 || factors.values[diagonal_positions[row]] == 0) {
+            throw std::domain_error("ILU(0) preconditioner needs non-zero diagonal");
+        }
+        for (int i = first; i < last; ++i) {
+            positions[factors.indexes[i]] = -1;
+        }
+    }
+}
+
+void ILU0Preconditioner::apply(const std::vector<double> &r, std::vector<double> &z) const {
+    const int n = r.size();
+    // forward substitution with unit lower triangular L
+    for (int row = 0; row < n; ++row) {
+        double sum = r[row];
+        for (int i = factors.offsets[row]; i < diagonal_positions[row]; ++i) {
+            sum -= factors.values[i] * z[factors.indexes[i]];
+        }
+        z[row] = sum;
+    }
+    // backward substitution with U
+    for (int row = n - 1; row >= 0; --row) {
+        double sum = z[row];
+        for (int i = diagonal_positions[row] + 1; i < factors.offsets[row + 1]; ++i) {
+            sum -= factors.values[i] * z[factors.indexes[i]];
+        }
+        z[row] = sum / factors.values[diagonal_positions[row]];
+    }
+}
+
+IterativeResult IterativeSolver::conjugate_gradient(const LinearOperator &A, const std::vector<double> &b,
+                                                    const Preconditioner &M, const IterativeSettings &settings) {
+    IterativeResult result = start_result(b);
+    const double b_norm = norm(b);
+    std::vector<double> &x = result.solution;
+    std::vector<double> r = b;
+    std::vector<double> z(b.size());
+    std::vector<double> Ap(b.size());
+    M.apply(r, z);
+    std::vector<double> p = z;
+    double rz = dot(r, z);
+
+    while (!result.converged && result.iterations < settings.max_iterations) {
+        A.apply(p, Ap);
+        double pAp = dot(p, Ap);
+        if (pAp == 0) break;
+        double alpha = rz / pAp;
+        axpy(alpha, p, x);
+        axpy(-alpha, Ap, r);
+        result.iterations++;
+        result.residual_history.push_back(norm(r) / b_norm);
+        result.converged = result.residual_history.back() < settings.tolerance;
+
+        M.apply(r, z);
+        double rz_next = dot(r, z);
+        double beta = rz_next / rz;
+        rz = rz_next;
+        for (size_t i = 0; i < p.size(); ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    return result;
+}
+
+IterativeResult IterativeSolver::bicgstab(const LinearOperator &A, const std::vector<double> &b,
+                                          const Preconditioner &M, const IterativeSettings &settings) {
+    IterativeResult result = start_result(b);
+    const double b_norm = norm(b);
+    const size_t n = b.size();
+    std::vector<double> &x = result.solution;
+    std::vector<double> r = b;
+    const std::vector<double> r_hat = b;
+    std::vector<double> p(n, 0.0), v(n, 0.0), y(n), s(n), z(n), t(n);
+    double rho = 1;
+    double alpha = 1;
+    double omega = 1;
+
+    while (!result.converged && result.iterations < settings.max_iterations) {
+        double rho_next = dot(r_hat, r);
+        if (rho_next == 0 || omega == 0) break; // breakdown of the method
+        double beta = (rho_next / rho) * (alpha / omega);
+        rho = rho_next;
+        for (size_t i = 0; i < n; ++i) {
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        }
+        M.apply(p, y);
+        A.apply(y, v);
+        double r_hat_v = dot(r_hat, v);
+        if (r_hat_v == 0) break;
+        alpha = rho / r_hat_v;
+        for (size_t i = 0; i < n; ++i) {
+            s[i] = r[i] - alpha * v[i];
+        }
+        result.iterations++;
+        if (norm(s) / b_norm < settings.tolerance) {
+            axpy(alpha, y, x);
+            result.residual_history.push_back(norm(s) / b_norm);
+            result.converged = true;
+            break;
+        }
+        M.apply(s, z);
+        A.apply(z, t);
+        double tt = dot(t, t);
+        omega = tt == 0 ? 0 : dot(t, s) / tt;
+        for (size_t i = 0; i < n; ++i) {
+            x[i] += alpha * y[i] + omega * z[i];
+            r[i] = s[i] - omega * t[i];
+        }
+        result.residual_history.push_back(norm(r) / b_norm);
+        result.converged = result.residual_history.back() < settings.tolerance;
+    }
+    return result;
+}
+
+IterativeResult IterativeSolver::gmres(const LinearOperator &A, const std::vector<double> &b,
+                                       const Preconditioner &M, const IterativeSettings &settings) {
+    IterativeResult result = start_result(b);
+    const double b_norm = norm(b);
+    const size_t n = b.size();
+    const int m = std::max(1, settings.restart);
+    std::vector<double> &x = result.solution;
+    std::vector<std::vector<double>> V(m + 1, std::vector<double>(n));
+    std::vector<std::vector<double>> H(m + 1, std::vector<double>(m, 0.0));
+    std::vector<double> cs(m), sn(m), g(m + 1), w(n), Mv(n);
+
+    while (!result.converged && result.iterations < settings.max_iterations) {
+        // r = b - Ax starts the new Krylov subspace
+        A.apply(x, w);
+        for (size_t i = 0; i < n; ++i) {
+            w[i] = b[i] - w[i];
+        }
+        double beta = norm(w);
+        if (beta / b_norm < settings.tolerance) {
+            result.converged = true;
+            break;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            V[0][i] = w[i] / beta;
+        }
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        int j = 0;
+        while (j < m && !result.converged && result.iterations < settings.max_iterations) {
+            M.apply(V[j], Mv);
+            A.apply(Mv, w);
+            // modified Gram-Schmidt orthogonalization against the basis
+            for (int i = 0; i <= j; ++i) {
+                H[i][j] = dot(w, V[i]);
+                axpy(-H[i][j], V[i], w);
+            }
+            H[j + 1][j] = norm(w);
+            bool breakdown = H[j + 1][j] == 0;
+            if (!breakdown) {
+                for (size_t i = 0; i < n; ++i) {
+                    V[j + 1][i] = w[i] / H[j + 1][j];
+                }
+            }
+            // keep H upper triangular with Givens rotations
+            for (int i = 0; i < j; ++i) {
+                double temp = cs[i] * H[i][j] + sn[i] * H[i + 1][j];
+                H[i + 1][j] = -sn[i] * H[i][j] + cs[i] * H[i + 1][j];
+                H[i][j] = temp;
+            }
+            double denominator = std::hypot(H[j][j], H[j + 1][j]);
+            cs[j] = denominator == 0 ? 1 : H[j][j] / denominator;
+            sn[j] = denominator == 0 ? 0 : H[j + 1][j] / denominator;
+            H[j][j] = cs[j] * H[j][j] + sn[j] * H[j + 1][j];
+            H[j + 1][j] = 0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] = cs[j] * g[j];
+
+            j++;
+            result.iterations++;
+            result.residual_history.push_back(std::abs(g[j]) / b_norm);
+            result.converged = result.residual_history.back() < settings.tolerance;
+            if (breakdown) break; // the subspace is invariant, nothing more to add
+        }
+
+        // solve H y = g and update x = x + M V y
+        std::vector<double> y(j);
+        for (int i = j - 1; i >= 0; --i) {
+            double sum = g[i];
+            for (int k = i + 1; k < j; ++k) {
+                sum -= H[i][k] * y[k];
+            }
+            y[i] = H[i][i] == 0 ? 0 : sum / H[i][i];
+        }
+        std::fill(w.begin(), w.end(), 0.0);
+        for (int i = 0; i < j; ++i) {
+            axpy(y[i], V[i], w);
+        }
+        M.apply(w, Mv);
+        axpy(1.0, Mv, x);
+    }
+    return result;
+}
+
+IterativeResult IterativeSolver::solve(const LinearOperator &A, const std::vector<double> &b, const Preconditioner &M,
+                                       const IterativeSettings &settings) {
+    if (static_cast<int>(b.size()) != A.get_size()) {
+        throw std::domain_error("not right number of right-hand side values given");
+    }
+    switch (settings.method) {
+        case IterativeMethod::CG:
+            return conjugate_gradient(A, b, M, settings);
+        case IterativeMethod::BICGSTAB:
+            return bicgstab(A, b, M, settings);
+        case IterativeMethod::GMRES:
+            return gmres(A, b, M, settings);
+    }
+    throw std::domain_error("unknown iterative method");
+}
+
+IterativeResult IterativeSolver::solve(const Matrix &matrix, const IterativeSettings &settings) {
+    if (!matrix.augmented) {
+        throw std::domain_error("iterative methods need augmented matrix of the system");
+    }
+    DenseOperator A(matrix);
+    std::vector<double> b = matrix.get_column(matrix.width - 1);
+
+    // the preconditioners are built from the sparse copy, which is not needed without them
+    std::unique_ptr<Preconditioner> M(new IdentityPreconditioner());
+    if (settings.preconditioner != PreconditionerType::NONE) {
+        M = create_preconditioner(SparseMatrix(matrix), settings.preconditioner);
+    }
+    return solve(A, b, *M, settings);
+}
+
+IterativeResult IterativeSolver::solve(const SparseMatrix &matrix, const IterativeSettings &settings) {
+    if (!matrix.augmented) {
+        throw std::domain_error("iterative methods need augmented matrix of the system");
+    }
+    SparseOperator A(matrix);
+    std::vector<double> b = get_vector_b(matrix);
+    std::unique_ptr<Preconditioner> M = create_preconditioner(matrix, settings.preconditioner);
+    return solve(A, b, *M, settings);
+}
+
+std::string IterativeSolver::get_method_name(IterativeMethod method) {
+    switch (method) {
+        case IterativeMethod::CG:
+            return "cg";
+        case IterativeMethod::BICGSTAB:
+            return "bicgstab";
+        case IterativeMethod::GMRES:
+            return "gmres";
+    }
+    return "";
+}
+
+std::string IterativeSolver::get_preconditioner_name(PreconditionerType preconditioner) {
+    switch (preconditioner) {
+        case PreconditionerType::NONE:
+            return "none";
+        case PreconditionerType::JACOBI:
+            return "jacobi";
+        case PreconditionerType::ILU0:
+            return "ilu0";
+    }
+    return "";
+}
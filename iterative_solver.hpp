@@ -0,0 +1,237 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_ITERATIVE_SOLVER_HPP
+#define LINEAR_SYSTEM_SOLVER_ITERATIVE_SOLVER_HPP
+
+#include <string>
+#include <vector>
+
+#include "matrix.hpp"
+#include "sparse_matrix.hpp"
+
+/**
+ * Enumeration for all iterative (Krylov subspace) methods.
+ */
+enum class IterativeMethod {
+    CG,
+    BICGSTAB,
+    GMRES
+};
+
+/**
+ * Enumeration for all preconditioners of the iterative methods.
+ */
+enum class PreconditionerType {
+    NONE,
+    JACOBI,
+    ILU0
+};
+
+/**
+ * Struct representing settings of the iterative solver.
+ */
+struct IterativeSettings {
+    IterativeMethod method = IterativeMethod::GMRES;
+    PreconditionerType preconditioner = PreconditionerType::NONE;
+    /**
+     * The iteration stops when the residual norm ||b - Ax|| / ||b|| drops below this value.
+     */
+    double tolerance = 1e-10;
+    int max_iterations = 1000;
+    /**
+     * Number of iterations after which GMRES is restarted.
+     */
+    int restart = 30;
+};
+
+/**
+ * Struct representing result of the iterative solver.
+ */
+struct IterativeResult {
+    std::vector<double> solution;
+    bool converged;
+    int iterations;
+    /**
+     * Relative residual norm ||b - Ax|| / ||b|| before the first and after each iteration.
+     */
+    std::vector<double> residual_history;
+};
+
+/**
+ * Interface of the square matrix A of the system, the iterative methods use it only through matrix-vector product.
+ */
+class LinearOperator {
+public:
+    virtual ~LinearOperator() = default;
+
+    /**
+     * @return dimension of the operator
+     */
+    virtual int get_size() const = 0;
+
+    /**
+     * Computes y = Ax.
+     *
+     * @param x vector to be multiplied
+     * @param y vector to write the result to (already of the right size)
+     */
+    virtual void apply(const std::vector<double> &x, std::vector<double> &y) const = 0;
+};
+
+/**
+ * Operator of the dense matrix, vector b of the augmented matrix is ignored.
+ */
+class DenseOperator : public LinearOperator {
+private:
+    const Matrix &matrix;
+
+public:
+    /**
+     * @param matrix square matrix A or augmented matrix [A | b], has to outlive the operator
+     */
+    explicit DenseOperator(const Matrix &matrix);
+
+    int get_size() const override;
+
+    void apply(const std::vector<double> &x, std::vector<double> &y) const override;
+};
+
+/**
+ * Operator of the sparse matrix, vector b of the augmented matrix is ignored.
+ */
+class SparseOperator : public LinearOperator {
+private:
+    SparseMatrix matrix;
+
+public:
+    /**
+     * @param matrix square matrix A or augmented matrix [A | b]
+     */
+    explicit SparseOperator(const SparseMatrix &matrix);
+
+    int get_size() const override;
+
+    void apply(const std::vector<double> &x, std::vector<double> &y) const override;
+};
+
+/**
+ * Interface of the preconditioner M, which approximates inverse of A.
+ */
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+
+    /**
+     * Computes z = Mr.
+     *
+     * @param r vector to be preconditioned
+     * @param z vector to write the result to (already of the right size)
+     */
+    virtual void apply(const std::vector<double> &r, std::vector<double> &z) const = 0;
+};
+
+/**
+ * Preconditioner doing nothing (M = I).
+ */
+class IdentityPreconditioner : public Preconditioner {
+public:
+    void apply(const std::vector<double> &r, std::vector<double> &z) const override;
+};
+
+/**
+ * Jacobi preconditioner, M is inverse of the diagonal of A. Zeros on the diagonal are replaced by ones.
+ */
+class JacobiPreconditioner : public Preconditioner {
+private:
+    std::vector<double> inverse_diagonal;
+
+public:
+    /**
+     * @param matrix square matrix A or augmented matrix [A | b]
+     */
+    explicit JacobiPreconditioner(const SparseMatrix &matrix);
+
+    void apply(const std::vector<double> &r, std::vector<double> &z) const override;
+};
+
+/**
+ * Incomplete LU preconditioner without fill-in, L and U have the same non-zero pattern as A.
+ */
+class ILU0Preconditioner : public Preconditioner {
+private:
+    SparseMatrix factors;
+    std::vector<int> diagonal_positions;
+
+public:
+    /**
+     * @param matrix square matrix A or augmented matrix [A | b], all diagonal elements have to be non-zero
+     */
+    explicit ILU0Preconditioner(const SparseMatrix &matrix);
+
+    void apply(const std::vector<double> &r, std::vector<double> &z) const override;
+};
+
+/**
+ * Class responsible for solving square linear systems with iterative methods.
+ */
+class IterativeSolver {
+private:
+    static IterativeResult conjugate_gradient(const LinearOperator &A, const std::vector<double> &b,
+                                              const Preconditioner &M, const IterativeSettings &settings);
+
+    static IterativeResult bicgstab(const LinearOperator &A, const std::vector<double> &b,
+                                    const Preconditioner &M, const IterativeSettings &settings);
+
+    static IterativeResult gmres(const LinearOperator &A, const std::vector<double> &b,
+                                 const Preconditioner &M, const IterativeSettings &settings);
+
+public:
+    /**
+     * Solves Ax = b with the method given in the settings, starting from x = 0.
+     * <p>
+     * Conjugate gradient requires symmetric positive definite A, BiCGSTAB and GMRES work for general A.
+     *
+     * @param A operator of the square matrix of the system
+     * @param b right-hand side of the system
+     * @param M preconditioner
+     * @param settings method, tolerance and iteration limits
+     * @return IterativeResult with the last approximation of the solution
+     */
+    static IterativeResult solve(const LinearOperator &A, const std::vector<double> &b, const Preconditioner &M,
+                                 const IterativeSettings &settings);
+
+    /**
+     * Solves the given square augmented matrix with the settings, including the preconditioner.
+     *
+     * @param matrix square augmented matrix [A | b]
+     * @param settings method, preconditioner, tolerance and iteration limits
+     * @return IterativeResult with the last approximation of the solution
+     */
+    static IterativeResult solve(const Matrix &matrix, const IterativeSettings &settings);
+
+    /**
+     * Solves the given square sparse augmented matrix with the settings, including the preconditioner.
+     * The matrix is never converted to the dense one, the preconditioners are built from its compressed form.
+     *
+     * @param matrix square sparse augmented matrix [A | b] in CSR or CSC format
+     * @param settings method, preconditioner, tolerance and iteration limits
+     * @return IterativeResult with the last approximation of the solution
+     */
+    static IterativeResult solve(const SparseMatrix &matrix, const IterativeSettings &settings);
+
+    /**
+     * @param method method to get name of
+     * @return name of the method as string
+     */
+    static std::string get_method_name(IterativeMethod method);
+
+    /**
+     * @param preconditioner preconditioner to get name of
+     * @return name of the preconditioner as string
+     */
+    static std::string get_preconditioner_name(PreconditionerType preconditioner);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_ITERATIVE_SOLVER_HPP
@@ -0,0 +1,258 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "lss.h"
+#include "matrix.hpp"
+#include "solve_result.hpp"
+#include "solver_context.hpp"
+#include "system_solver.hpp"
+
+struct lss_context {
+    SolverContext context;
+};
+
+struct lss_result {
+    SolveResult result;
+};
+
+namespace {
+    thread_local std::string last_error;
+
+    int fail(int code, const std::string &message) {
+        last_error = message;
+        return code;
+    }
+
+    /**
+     * Runs the function and converts the exceptions to the error codes, no exception leaves the C interface.
+     */
+    template<typename Function>
+    int guard(Function &&function) {
+        try {
+            function();
+        } catch (std::bad_alloc &e) {
+            return fail(LSS_ERROR_OUT_OF_MEMORY, "not enough memory");
+        } catch (std::exception &e) {
+            return fail(LSS_ERROR_SOLVER, e.what());
+        } catch (...) {
+            return fail(LSS_ERROR_SOLVER, "unknown error");
+        }
+        last_error.clear();
+        return LSS_OK;
+    }
+
+    /**
+     * Checks the result passed to the getters, the getters return their sentinel for null.
+     *
+     * @return true if the result is null, the last error is set then
+     */
+    bool is_null(const lss_result *result) {
+        if (!result) {
+            fail(LSS_ERROR_INVALID_ARGUMENT, "result is null");
+            return true;
+        }
+        return false;
+    }
+}
+
+lss_context *lss_context_create(void) {
+    lss_context *context = new(std::nothrow) lss_context();
+    if (context) {
+        context->context.output_level = OutputLevel::QUIET;
+    }
+    return context;
+}
+
+void lss_context_destroy(lss_context *context) {
+    delete context;
+}
+
+int lss_context_set_threads(lss_context *context, int thread_count) {
+    if (!context) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "context is null");
+    }
+    if (thread_count < 1) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "number of threads has to be positive");
+    }
+    context->context.thread_count = thread_count;
+    return LSS_OK;
+}
+
+int lss_context_set_method(lss_context *context, int method) {
+    if (!context) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "context is null");
+    }
+    SolverContext &settings = context->context;
+    switch (method) {
+        case LSS_METHOD_DIRECT:
+            settings.method = SolverMethod::DIRECT;
+            break;
+        case LSS_METHOD_QR:
+            settings.method = SolverMethod::QR;
+            break;
+        case LSS_METHOD_MIXED_PRECISION:
+            settings.method = SolverMethod::MIXED_PRECISION;
+            break;
+        case LSS_METHOD_CG:
+            settings.method = SolverMethod::ITERATIVE;
+            settings.iterative.method = IterativeMethod::CG;
+            break;
+        case LSS_METHOD_BICGSTAB:
+            settings.method = SolverMethod::ITERATIVE;
+            settings.iterative.method = IterativeMethod::BICGSTAB;
+            break;
+        case LSS_METHOD_GMRES:
+            settings.method = SolverMethod::ITERATIVE;
+            settings.iterative.method = IterativeMethod::GMRES;
+            break;
+        default:
+            return fail(LSS_ERROR_INVALID_ARGUMENT, "unknown method " + std::to_string(method));
+    }
+    return LSS_OK;
+}
+
+int lss_context_set_preconditioner(lss_context *context, int preconditioner) {
+    if (!context) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "context is null");
+    }
+    switch (preconditioner) {
+        case LSS_PRECONDITIONER_NONE:
+            context->context.iterative.preconditioner = PreconditionerType::NONE;
+            break;
+        case LSS_PRECONDITIONER_JACOBI:
+            context->context.iterative.preconditioner = PreconditionerType::JACOBI;
+            break;
+        case LSS_PRECONDITIONER_ILU0:
+            context->context.iterative.preconditioner = PreconditionerType::ILU0;
+            break;
+        default:
+            return fail(LSS_ERROR_INVALID_ARGUMENT, "unknown preconditioner " + std::to_string(preconditioner));
+    }
+    return LSS_OK;
+}
+
+int lss_context_set_tolerance(lss_context *context, double tolerance) {
+    if (!context) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "context is null");
+    }
+    if (!(tolerance > 0)) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "tolerance has to be positive");
+    }
+    context->context.iterative.tolerance = tolerance;
+    return LSS_OK;
+}
+
+int lss_context_set_max_iterations(lss_context *context, int max_iterations) {
+    if (!context) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "context is null");
+    }
+    if (max_iterations < 1) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "maximum of iterations has to be positive");
+    }
+    context->context.iterative.max_iterations = max_iterations;
+    return LSS_OK;
+}
+
+int lss_solve(const lss_context *context, const double *augmented, int width, int height, lss_result **result) {
+    if (!context || !augmented || !result) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "context, matrix and result have to be set");
+    }
+    if (width < 2 || height < 1) {
+        return fail(LSS_ERROR_INVALID_ARGUMENT, "augmented matrix needs at least 2 columns and 1 row");
+    }
+    *result = nullptr;
+    return guard([&]() {
+        // the solvers do not write to the matrix, so the caller's buffer is wrapped without copying
+        std::shared_ptr<void> storage(const_cast<double *>(augmented), [](void *) {});
+        Matrix matrix(width, height, true, const_cast<double *>(augmented), storage);
+        std::unique_ptr<lss_result> solved(new lss_result{SystemSolver::solve_with_method(matrix, context->context)});
+        *result = solved.release();
+    });
+}
+
+void lss_result_destroy(lss_result *result) {
+    delete result;
+}
+
+int lss_result_status(const lss_result *result) {
+    if (is_null(result)) {
+        return LSS_STATUS_INVALID;
+    }
+    switch (result->result.status) {
+        case SolveStatus::UNIQUE:
+            return LSS_STATUS_UNIQUE;
+        case SolveStatus::KERNEL:
+            return LSS_STATUS_KERNEL;
+        case SolveStatus::NOT_CONVERGED:
+            return LSS_STATUS_NOT_CONVERGED;
+        case SolveStatus::NO_SOLUTION:
+            break;
+    }
+    return LSS_STATUS_NO_SOLUTION;
+}
+
+int lss_result_rank(const lss_result *result) {
+    if (is_null(result)) {
+        return -1;
+    }
+    return result->result.rank;
+}
+
+int lss_result_unknowns(const lss_result *result) {
+    if (is_null(result)) {
+        return 0;
+    }
+    return static_cast<int>(result->result.particular.size());
+}
+
+const double *lss_result_particular(const lss_result *result) {
+    if (is_null(result)) {
+        return nullptr;
+    }
+    return result->result.has_solution() ? result->result.particular.data() : nullptr;
+}
+
+int lss_result_kernel_size(const lss_result *result) {
+    if (is_null(result)) {
+        return 0;
+    }
+    return static_cast<int>(result->result.kernel.size());
+}
+
+const double *lss_result_kernel_vector(const lss_result *result, int index) {
+    if (is_null(result) || index < 0 || index >= lss_result_kernel_size(result)) {
+        return nullptr;
+    }
+    return result->result.kernel[index].data();
+}
+
+double lss_result_factor_ms(const lss_result *result) {
+    if (is_null(result)) {
+        return -1;
+    }
+    return result->result.timings.factor_ms;
+}
+
+double lss_result_substitution_ms(const lss_result *result) {
+    if (is_null(result)) {
+        return -1;
+    }
+    return result->result.timings.substitution_ms;
+}
+
+double lss_result_total_ms(const lss_result *result) {
+    if (is_null(result)) {
+        return -1;
+    }
+    return result->result.timings.total_ms;
+}
+
+const char *lss_last_error(void) {
+    return last_error.c_str();
+}
@@ -0,0 +1,106 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_LSS_H
+#define LINEAR_SYSTEM_SOLVER_LSS_H
+
+/*
+ * C interface of the solver library for the FFI callers. The functions do not throw, they return LSS_OK
+ * or one of the error codes and lss_last_error describes the last failure of the calling thread.
+ * Contexts and results are owned by the caller and have to be destroyed by their destroy functions.
+ * The result getters return their sentinel for NULL result and set lss_last_error.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LSS_OK 0
+#define LSS_ERROR_INVALID_ARGUMENT 1
+#define LSS_ERROR_SOLVER 2
+#define LSS_ERROR_OUT_OF_MEMORY 3
+
+#define LSS_METHOD_DIRECT 0
+#define LSS_METHOD_QR 1
+#define LSS_METHOD_MIXED_PRECISION 2
+#define LSS_METHOD_CG 3
+#define LSS_METHOD_BICGSTAB 4
+#define LSS_METHOD_GMRES 5
+
+#define LSS_PRECONDITIONER_NONE 0
+#define LSS_PRECONDITIONER_JACOBI 1
+#define LSS_PRECONDITIONER_ILU0 2
+
+#define LSS_STATUS_UNIQUE 0
+#define LSS_STATUS_KERNEL 1
+#define LSS_STATUS_NO_SOLUTION 2
+#define LSS_STATUS_NOT_CONVERGED 3
+#define LSS_STATUS_INVALID -1
+
+/* settings of the solves, one context can be used by one thread at a time */
+typedef struct lss_context lss_context;
+
+/* status, rank, solution vectors and timings of one solve */
+typedef struct lss_result lss_result;
+
+/* returns NULL if the memory can not be allocated, the context solves with LSS_METHOD_DIRECT and one thread */
+lss_context *lss_context_create(void);
+
+void lss_context_destroy(lss_context *context);
+
+int lss_context_set_threads(lss_context *context, int thread_count);
+
+int lss_context_set_method(lss_context *context, int method);
+
+/* used by LSS_METHOD_CG, LSS_METHOD_BICGSTAB and LSS_METHOD_GMRES only */
+int lss_context_set_preconditioner(lss_context *context, int preconditioner);
+
+int lss_context_set_tolerance(lss_context *context, double tolerance);
+
+int lss_context_set_max_iterations(lss_context *context, int max_iterations);
+
+/*
+ * Solves the linear system given by its augmented matrix [A|b] with height rows and width columns stored row
+ * after row, the matrix is read only. The new result is stored to *result on success.
+ */
+int lss_solve(const lss_context *context, const double *augmented, int width, int height, lss_result **result);
+
+void lss_result_destroy(lss_result *result);
+
+/* LSS_STATUS_INVALID for NULL result */
+int lss_result_status(const lss_result *result);
+
+/* -1 if the method does not compute the rank or for NULL result */
+int lss_result_rank(const lss_result *result);
+
+/*
+ * number of the elements of the particular solution and of each kernel vector, 0 if there is no solution
+ * or for NULL result
+ */
+int lss_result_unknowns(const lss_result *result);
+
+/* NULL if there is no solution or for NULL result, the last approximation for LSS_STATUS_NOT_CONVERGED */
+const double *lss_result_particular(const lss_result *result);
+
+/* 0 for NULL result */
+int lss_result_kernel_size(const lss_result *result);
+
+/* NULL if the index is out of range or for NULL result */
+const double *lss_result_kernel_vector(const lss_result *result, int index);
+
+/* the timings are in milliseconds, -1 for NULL result */
+double lss_result_factor_ms(const lss_result *result);
+
+double lss_result_substitution_ms(const lss_result *result);
+
+double lss_result_total_ms(const lss_result *result);
+
+/* message of the last error of the calling thread, empty string if there was none */
+const char *lss_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LINEAR_SYSTEM_SOLVER_LSS_H
@@ -0,0 +1,761 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "batched_solver.hpp"
+#include "binary_format.hpp"
+#include "fixed_matrix.hpp"
+#include "lss.h"
+#include "matrix.hpp"
+#include "number_formatter.hpp"
+#include "out_of_core.hpp"
+#include "result_sink.hpp"
+#include "sparse_matrix.hpp"
+#include "system_solver.hpp"
+#include "text_parser.hpp"
+
+/**
+ * Constant representing the largest accepted residual relative to the norms of the system and the solution.
+ */
+#define TEST_RESIDUAL_TOLERANCE 1e-9
+
+namespace {
+    /**
+     * Struct representing the rank of the matrix A and of the augmented matrix found by the reference elimination.
+     */
+    struct ReferenceResult {
+        int rank;
+        bool has_solution;
+    };
+
+    /**
+     * Reference Gaussian elimination with partial pivoting on a copy of the matrix. The elements are considered zero
+     * with the same tolerances as in LUDecomposer: the tolerance of A follows the scale of A only
+     * and the vector b is tested against the scale of the whole augmented matrix.
+     */
+    ReferenceResult eliminate(const Matrix &matrix) {
+        const int unknowns = matrix.width - 1;
+        const int height = matrix.height;
+        std::vector<std::vector<long double>> rows(height, std::vector<long double>(matrix.width));
+        long double max_abs = 0;
+        long double max_abs_all = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < matrix.width; ++x) {
+                rows[y][x] = matrix.field(x, y);
+                max_abs_all = std::max(max_abs_all, std::fabs(rows[y][x]));
+                if (x < unknowns) max_abs = std::max(max_abs, std::fabs(rows[y][x]));
+            }
+        }
+        const long double epsilon = std::max(matrix.width, height) * std::numeric_limits<double>::epsilon();
+
+        int rank = 0;
+        for (int x = 0; x < matrix.width && rank < height; ++x) {
+            int pivot = rank;
+            for (int y = rank + 1; y < height; ++y) {
+                if (std::fabs(rows[y][x]) > std::fabs(rows[pivot][x])) pivot = y;
+            }
+            const long double tolerance = epsilon * (x < unknowns ? max_abs : max_abs_all);
+            if (std::fabs(rows[pivot][x]) <= tolerance) continue;
+            if (x == unknowns) {
+                return {rank, false};
+            }
+            std::swap(rows[pivot], rows[rank]);
+            for (int y = rank + 1; y < height; ++y) {
+                const long double multiplier = rows[y][x] / rows[rank][x];
+                for (int i = x; i < matrix.width; ++i) {
+                    rows[y][i] -= multiplier * rows[rank][i];
+                }
+            }
+            ++rank;
+        }
+        return {rank, true};
+    }
+
+    /**
+     * @return infinity norm of A * vector - b (or of A * vector if the b is omitted) relative to the norms
+     * of A, the vector and b
+     */
+    double get_relative_residual(const Matrix &matrix, const std::vector<double> &vector, bool subtract_b) {
+        const int unknowns = matrix.width - 1;
+        double residual = 0;
+        double norm_A = 0;
+        double norm_b = 0;
+        double norm_vector = 0;
+        for (double value : vector) {
+            norm_vector = std::max(norm_vector, std::fabs(value));
+        }
+        for (int y = 0; y < matrix.height; ++y) {
+            long double sum = subtract_b ? -static_cast<long double>(matrix.field(unknowns, y)) : 0;
+            double row_norm = 0;
+            for (int x = 0; x < unknowns; ++x) {
+                sum += static_cast<long double>(matrix.field(x, y)) * vector[x];
+                row_norm += std::fabs(matrix.field(x, y));
+            }
+            residual = std::max(residual, static_cast<double>(std::fabs(sum)));
+            norm_A = std::max(norm_A, row_norm);
+            norm_b = std::max(norm_b, std::fabs(matrix.field(unknowns, y)));
+        }
+        double scale = norm_A * norm_vector + (subtract_b ? norm_b : 0);
+        return scale == 0 ? residual : residual / scale;
+    }
+
+    /**
+     * Compares the result of the solver with the reference elimination, prints the differences.
+     *
+     * @return true if the result matches
+     */
+    bool check_result(const std::string &name, const Matrix &matrix, const SolveResult &result,
+                      const ReferenceResult &reference) {
+        const int unknowns = matrix.width - 1;
+        std::string error;
+        if (result.has_solution() != reference.has_solution) {
+            error = reference.has_solution ? "solution not found" : "solution found for inconsistent system";
+        } else if (result.rank != -1 && result.rank != reference.rank) {
+            error = "rank " + std::to_string(result.rank) + ", expected " + std::to_string(reference.rank);
+        } else if (result.has_solution()) {
+            if (static_cast<int>(result.particular.size()) != unknowns) {
+                error = "particular solution has " + std::to_string(result.particular.size()) + " elements";
+            } else if (static_cast<int>(result.kernel.size()) != unknowns - reference.rank) {
+                error = "kernel has dimension " + std::to_string(result.kernel.size()) + ", expected "
+                        + std::to_string(unknowns - reference.rank);
+            } else if (get_relative_residual(matrix, result.particular, true) > TEST_RESIDUAL_TOLERANCE) {
+                error = "residual of the particular solution is too large";
+            }
+            for (const std::vector<double> &vector : result.kernel) {
+                if (error.empty() && get_relative_residual(matrix, vector, false) > TEST_RESIDUAL_TOLERANCE) {
+                    error = "kernel vector is not in the kernel";
+                }
+            }
+        }
+        if (!error.empty()) {
+            std::cout << "FAILED " << name << ": " << error << std::endl;
+            return false;
+        }
+        std::cout << "ok     " << name << std::endl;
+        return true;
+    }
+
+    /**
+     * @return augmented matrix with small integer elements and the given rank of A. If the rank is lower than
+     * the number of unknowns, the rows behind the rank are multiples of the first rows, so they are eliminated
+     * exactly and the rank is not blurred by the round-off. Vector b is A * x for random x, the rows behind
+     * the rank get b shifted by one if the system is inconsistent.
+     */
+    Matrix create_system(int unknowns, int height, int rank, bool consistent, std::mt19937 &generator) {
+        std::uniform_int_distribution<int> distribution(-3, 3);
+        std::vector<double> solution(unknowns);
+        for (double &value : solution) value = distribution(generator);
+
+        Matrix matrix(unknowns + 1, height, true);
+        for (int y = 0; y < height; ++y) {
+            const bool independent = y < rank || rank == unknowns;
+            const double multiple = y / rank % 2 == 0 ? -1 : 2;
+            double b = 0;
+            for (int x = 0; x < unknowns; ++x) {
+                matrix.field(x, y) = independent ? distribution(generator) : multiple * matrix.field(x, y % rank);
+                b += matrix.field(x, y) * solution[x];
+            }
+            matrix.field(unknowns, y) = consistent || y < rank ? b : b + 1;
+        }
+        return matrix;
+    }
+
+    /**
+     * @return tridiagonal system sparse enough to be solved by the sparse elimination, the last row is a copy
+     * of the previous one if the system is singular
+     */
+    Matrix create_sparse_system(int unknowns, bool singular) {
+        Matrix matrix(unknowns + 1, unknowns, true);
+        for (int y = 0; y < unknowns; ++y) {
+            if (y > 0) matrix.field(y - 1, y) = -1;
+            matrix.field(y, y) = 4;
+            if (y < unknowns - 1) matrix.field(y + 1, y) = -1;
+            matrix.field(unknowns, y) = y + 1;
+        }
+        if (singular) {
+            for (int x = 0; x <= unknowns; ++x) {
+                matrix.field(x, unknowns - 1) = matrix.field(x, unknowns - 2);
+            }
+        }
+        return matrix;
+    }
+
+    /**
+     * @return augmented matrix with the given rows, the last element of each row is the element of b
+     */
+    Matrix create_from_rows(const std::vector<std::vector<double>> &rows) {
+        Matrix matrix(static_cast<int>(rows[0].size()), static_cast<int>(rows.size()), true);
+        for (size_t y = 0; y < rows.size(); ++y) {
+            matrix.set_row(static_cast<int>(y), rows[y]);
+        }
+        return matrix;
+    }
+
+    /**
+     * @return tridiagonal system with -lower, 4 and -upper on the diagonals, it is symmetric positive definite
+     * if lower equals upper and diagonally dominant otherwise
+     */
+    Matrix create_tridiagonal_system(int unknowns, double lower, double upper) {
+        Matrix matrix(unknowns + 1, unknowns, true);
+        for (int y = 0; y < unknowns; ++y) {
+            if (y > 0) matrix.field(y - 1, y) = -lower;
+            matrix.field(y, y) = 4;
+            if (y < unknowns - 1) matrix.field(y + 1, y) = -upper;
+            matrix.field(unknowns, y) = y % 7 - 3;
+        }
+        return matrix;
+    }
+
+    /**
+     * @return matrix with random small integer elements, about the given fraction of them is zero
+     */
+    Matrix create_random_sparse(int width, int height, double zero_fraction, std::mt19937 &generator) {
+        std::uniform_int_distribution<int> distribution(-9, 9);
+        std::bernoulli_distribution is_zero(zero_fraction);
+        Matrix matrix(width, height, true);
+        for (size_t i = 0; i < matrix.size(); ++i) {
+            matrix.data[i] = is_zero(generator) ? 0 : distribution(generator);
+        }
+        return matrix;
+    }
+
+    /**
+     * Prints the result of one check.
+     *
+     * @param name name of the check
+     * @param error description of the failure, empty if the check passed
+     * @return true if the check passed
+     */
+    bool report(const std::string &name, const std::string &error) {
+        if (!error.empty()) {
+            std::cout << "FAILED " << name << ": " << error << std::endl;
+            return false;
+        }
+        std::cout << "ok     " << name << std::endl;
+        return true;
+    }
+
+    /**
+     * @return true if the function throws std::domain_error
+     */
+    template<typename Function>
+    bool throws_domain_error(Function &&function) {
+        try {
+            function();
+        } catch (std::domain_error &) {
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @return true if both matrices have the same dimensions and the same elements
+     */
+    template<typename T>
+    bool is_equal(const BasicMatrix<T> &first, const BasicMatrix<T> &second) {
+        return first.width == second.width && first.height == second.height && first.augmented == second.augmented
+               && std::equal(first.data, first.data + first.size(), second.data);
+    }
+
+    /**
+     * @return whole contents of the file
+     */
+    std::vector<char> read_bytes(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * Solves the systems by all methods with 1 and 4 threads and by the sparse path, compares the results
+     * with the reference elimination.
+     *
+     * @return number of failed checks
+     */
+    int test_systems() {
+        std::mt19937 generator(42);
+        const std::vector<std::pair<std::string, Matrix>> systems = {
+                {"small square",            create_system(4, 4, 4, true, generator)},
+                {"square",                  create_system(80, 80, 80, true, generator)},
+                {"wide",                    create_system(60, 30, 30, true, generator)},
+                {"tall",                    create_system(30, 60, 30, true, generator)},
+                {"blocked square",          create_system(250, 250, 250, true, generator)},
+                {"rank-deficient",          create_system(50, 50, 20, true, generator)},
+                {"rank-deficient wide",     create_system(60, 40, 25, true, generator)},
+                {"inconsistent",            create_system(50, 50, 20, false, generator)},
+                {"inconsistent tall",       create_system(20, 40, 20, false, generator)},
+                {"sparse",                  create_sparse_system(100, false)},
+                {"sparse singular",         create_sparse_system(100, true)},
+                {"large b",                 create_from_rows({{1, 0, 1e20}, {0, 1, 1}})},
+                {"large b inconsistent",    create_from_rows({{1, 1, 1e20}, {1, 1, 1}})},
+                {"large b square",          create_from_rows({{2, 1, 0, 1e20}, {1, 3, 1, 1}, {0, 1, 4, -1}})},
+        };
+        const std::vector<std::pair<std::string, SolverMethod>> methods = {
+                {"direct",          SolverMethod::DIRECT},
+                {"qr",              SolverMethod::QR},
+                {"mixed precision", SolverMethod::MIXED_PRECISION},
+        };
+
+        std::unique_ptr<ResultSink> sink = ResultSink::create(OutputLevel::QUIET, std::cout);
+        int failed = 0;
+        for (const auto &system : systems) {
+            const ReferenceResult reference = eliminate(system.second);
+            for (const auto &method : methods) {
+                for (int threads : {1, 4}) {
+                    SolverContext context;
+                    context.method = method.second;
+                    context.thread_count = threads;
+                    SolveResult result = SystemSolver::solve_with_method(system.second, context);
+                    std::string name = system.first + ", " + method.first + ", " + std::to_string(threads)
+                                       + " threads";
+                    failed += !check_result(name, system.second, result, reference);
+                }
+            }
+            SolveResult result = SystemSolver::solve_with_method(*sink, SparseMatrix(system.second), SolverContext());
+            failed += !check_result(system.first + ", sparse", system.second, result, reference);
+        }
+        return failed;
+    }
+
+    /**
+     * Checks that all iterative methods with all preconditioners converge for the dense and the sparse matrix.
+     * CG gets only the symmetric positive definite system.
+     *
+     * @return number of failed checks
+     */
+    int test_iterative() {
+        const std::vector<std::pair<std::string, Matrix>> systems = {
+                {"symmetric",       create_tridiagonal_system(200, 1, 1)},
+                {"non-symmetric",   create_tridiagonal_system(200, 1.5, 0.5)},
+        };
+        const std::vector<std::pair<std::string, IterativeMethod>> methods = {
+                {"cg",          IterativeMethod::CG},
+                {"bicgstab",    IterativeMethod::BICGSTAB},
+                {"gmres",       IterativeMethod::GMRES},
+        };
+        const std::vector<PreconditionerType> preconditioners = {
+                PreconditionerType::NONE, PreconditionerType::JACOBI, PreconditionerType::ILU0
+        };
+
+        std::unique_ptr<ResultSink> sink = ResultSink::create(OutputLevel::QUIET, std::cout);
+        int failed = 0;
+        for (const auto &system : systems) {
+            const ReferenceResult reference = eliminate(system.second);
+            for (const auto &method : methods) {
+                if (method.second == IterativeMethod::CG && system.first != "symmetric") continue;
+                for (PreconditionerType preconditioner : preconditioners) {
+                    SolverContext context;
+                    context.method = SolverMethod::ITERATIVE;
+                    context.iterative.method = method.second;
+                    context.iterative.preconditioner = preconditioner;
+                    std::string name = system.first + ", " + method.first + ", "
+                                       + IterativeSolver::get_preconditioner_name(preconditioner);
+
+                    SolveResult dense = SystemSolver::solve_with_method(*sink, system.second, context);
+                    const SparseMatrix sparse_matrix(system.second, SparseFormat::CSC);
+                    SolveResult sparse = SystemSolver::solve_with_method(*sink, sparse_matrix, context);
+                    for (const SolveResult *result : {&dense, &sparse}) {
+                        std::string result_name = name + (result == &dense ? ", dense" : ", sparse");
+                        if (result->status == SolveStatus::NOT_CONVERGED) {
+                            failed += !report(result_name, "did not converge");
+                        } else {
+                            failed += !check_result(result_name, system.second, *result, reference);
+                        }
+                    }
+                }
+            }
+        }
+        return failed;
+    }
+
+    /**
+     * Checks the fixed size kernels against the general elimination and the batched solver against the fixed size
+     * kernels on random systems, including the singular ones.
+     *
+     * @return number of failed checks
+     */
+    int test_small_systems() {
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<double> distribution(-1, 1);
+        std::unique_ptr<ResultSink> sink;
+        std::ostringstream details;
+        int failed = 0;
+        for (int unknowns = FIXED_SIZE_MIN; unknowns <= FIXED_SIZE_MAX; ++unknowns) {
+            // 2 lanes more than full blocks, so the padding of the last block is used
+            const int count = 3 * BATCHED_LANES + 2;
+            std::vector<Matrix> systems;
+            SystemBatch batch(unknowns, count);
+            for (int i = 0; i < count; ++i) {
+                Matrix matrix(unknowns + 1, unknowns, true);
+                for (size_t j = 0; j < matrix.size(); ++j) {
+                    matrix.data[j] = distribution(generator);
+                }
+                if (i % 5 == 4) {
+                    // singular system, the last row is the copy of the first one
+                    for (int x = 0; x <= unknowns; ++x) {
+                        matrix.field(x, unknowns - 1) = matrix.field(x, 0);
+                    }
+                }
+                batch.set_system(i, matrix);
+                systems.push_back(std::move(matrix));
+            }
+            const BatchedSolution batched = BatchedSolver::solve(batch, 2);
+
+            std::string fixed_error;
+            std::string batched_error;
+            for (int i = 0; i < count; ++i) {
+                const Matrix &matrix = systems[i];
+                std::vector<double> fixed;
+                const bool regular = FixedSizeSolver::solve(matrix, fixed);
+                if (regular == (i % 5 == 4)) {
+                    fixed_error = "system " + std::to_string(i) + " has wrong singularity";
+                    continue;
+                }
+                if (batched.singular[i] != !regular) {
+                    batched_error = "system " + std::to_string(i) + " has wrong singularity flag";
+                    continue;
+                }
+                if (!regular) continue;
+
+                // the sink with details forces the general elimination
+                details.str("");
+                sink = ResultSink::create(OutputLevel::FULL, details);
+                SolveResult general = SystemSolver::solve_with_method(*sink, matrix, SolverContext());
+                if (general.particular != fixed) {
+                    fixed_error = "system " + std::to_string(i) + " differs from the general elimination";
+                }
+                // the batched kernels fuse the multiply-adds, so only the residuals are compared
+                if (get_relative_residual(matrix, batched.get_solution(i), true) > TEST_RESIDUAL_TOLERANCE) {
+                    batched_error = "residual of system " + std::to_string(i) + " is too large";
+                }
+            }
+            failed += !report("fixed size " + std::to_string(unknowns) + ", bit-identical to elimination", fixed_error);
+            failed += !report("batched " + std::to_string(unknowns), batched_error);
+        }
+        return failed;
+    }
+
+    /**
+     * Checks the out-of-core solver with tiles smaller than the system against the in-core solve.
+     *
+     * @return number of failed checks
+     */
+    int test_out_of_core() {
+        std::mt19937 generator(11);
+        const int unknowns = 150;
+        const Matrix matrix = create_system(unknowns, unknowns, unknowns, true, generator);
+        const std::string path = "lss_test_out_of_core.bin";
+        BinaryMatrixFile::write(path, matrix);
+
+        // budget for about three panels of 32 columns
+        OutOfCoreSettings settings;
+        settings.memory_budget = OUT_OF_CORE_PANELS_IN_MEMORY * sizeof(double) * unknowns * 32;
+        std::string error;
+        try {
+            OutOfCoreResult out_of_core = OutOfCoreSolver::solve(path, settings);
+            SolveResult in_core = SystemSolver::solve_with_method(matrix, SolverContext());
+            double difference = 0;
+            for (int i = 0; i < unknowns; ++i) {
+                difference = std::max(difference, std::fabs(out_of_core.solution[i] - in_core.particular[i]));
+            }
+            if (out_of_core.tile_rows < 2) {
+                error = "the system fits in one tile of " + std::to_string(out_of_core.tile_size);
+            } else if (get_relative_residual(matrix, out_of_core.solution, true) > TEST_RESIDUAL_TOLERANCE) {
+                error = "residual of the solution is too large";
+            } else if (difference > 1e-8) {
+                error = "solution differs from the in-core one by " + std::to_string(difference);
+            }
+        } catch (std::exception &e) {
+            error = e.what();
+        }
+        std::remove(path.c_str());
+        return !report("out-of-core, tiled", error);
+    }
+
+    /**
+     * Checks the txt parser on valid and malformed texts.
+     *
+     * @return number of failed checks
+     */
+    int test_text_parser() {
+        int failed = 0;
+        const std::string text = "3 2\n\n1 -2.5 3e2\n  0.125\t-1E-3 +4\n";
+        Matrix expected = create_from_rows({{1, -2.5, 300}, {0.125, -0.001, 4}});
+        Matrix parsed = TextMatrixParser::parse(text.data(), text.data() + text.size());
+        failed += !report("text parser, doubles", is_equal(parsed, expected) ? "" : "parsed values differ");
+
+        const std::string complex_text = "2 2 complex\n1+2i (3,-4)\n-5i 6\n";
+        BasicMatrix<std::complex<double>> complex = TextMatrixParser::parse_as<std::complex<double>>(
+                complex_text.data(), complex_text.data() + complex_text.size());
+        bool complex_equal = complex.field(0, 0) == std::complex<double>(1, 2)
+                             && complex.field(1, 0) == std::complex<double>(3, -4)
+                             && complex.field(0, 1) == std::complex<double>(0, -5)
+                             && complex.field(1, 1) == std::complex<double>(6, 0);
+        failed += !report("text parser, complex", complex_equal ? "" : "parsed values differ");
+
+        const std::vector<std::pair<std::string, std::string>> malformed = {
+                {"missing value",   "3 2\n1 2 3\n4 5\n"},
+                {"extra value",     "2 1\n1 2 3\n"},
+                {"not a number",    "2 1\n1 x\n"},
+                {"missing row",     "2 2\n1 2\n"},
+                {"wrong type",      "2 1 float\n1 2\n"},
+                {"bad header",      "2\n1 2\n"},
+        };
+        for (const auto &input : malformed) {
+            bool rejected = throws_domain_error([&]() {
+                TextMatrixParser::parse(input.second.data(), input.second.data() + input.second.size());
+            });
+            failed += !report("text parser rejects " + input.first, rejected ? "" : "text accepted");
+        }
+        return failed;
+    }
+
+    /**
+     * Checks that the formatted numbers read back as the same doubles by strtod and by the txt parser.
+     *
+     * @return number of failed checks
+     */
+    int test_number_formatter() {
+        std::vector<double> values = {0.0, 1.0, -1.0, 0.1, 1.0 / 3, 123456789012345.0, 1e15, 1e16, 1e17, 1e-5,
+                                      1e-6, 5e-324, std::numeric_limits<double>::min(),
+                                      std::numeric_limits<double>::max(), -2.5e-300};
+        std::mt19937_64 generator(5);
+        std::uniform_real_distribution<double> uniform(-1e6, 1e6);
+        for (int i = 0; i < 100000; ++i) {
+            // random bit patterns cover all exponents, the uniform values the common range
+            uint64_t bits = generator();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            values.push_back(std::isfinite(value) ? value : uniform(generator));
+            values.push_back(uniform(generator));
+        }
+
+        std::string error;
+        char buffer[NUMBER_BUFFER_SIZE + 1];
+        for (double value : values) {
+            int length = NumberFormatter::format(value, buffer);
+            buffer[length] = '\0';
+            double read_back = std::strtod(buffer, nullptr);
+            const char *position = buffer;
+            double parsed = 0;
+            bool valid = TextMatrixParser::parse_double(position, buffer + length, parsed);
+            if (read_back != value || !valid || parsed != value || position != buffer + length) {
+                error = std::string(buffer) + " does not read back as the formatted number";
+                break;
+            }
+        }
+        return !report("number formatter round trip", error);
+    }
+
+    /**
+     * Checks the conversions between the dense, CSR and CSC matrices.
+     *
+     * @return number of failed checks
+     */
+    int test_sparse_formats() {
+        std::mt19937 generator(3);
+        int failed = 0;
+        for (double zero_fraction : {0.0, 0.9, 1.0}) {
+            const Matrix matrix = create_random_sparse(37, 23, zero_fraction, generator);
+            const SparseMatrix csr(matrix, SparseFormat::CSR);
+            const SparseMatrix csc = csr.to_format(SparseFormat::CSC);
+            const SparseMatrix csr_again = csc.to_format(SparseFormat::CSR);
+            std::string error;
+            size_t non_zeros = std::count_if(matrix.data, matrix.data + matrix.size(), [](double e) { return e != 0; });
+            if (csr.non_zeros() != non_zeros || csc.non_zeros() != non_zeros) {
+                error = "wrong number of non-zero elements";
+            } else if (!is_equal(csr.to_dense(), matrix) || !is_equal(csc.to_dense(), matrix)) {
+                error = "dense copy differs";
+            } else if (csr_again.offsets != csr.offsets || csr_again.indexes != csr.indexes
+                       || csr_again.values != csr.values) {
+                error = "CSR -> CSC -> CSR differs";
+            }
+            for (int y = 0; y < matrix.height && error.empty(); ++y) {
+                for (int x = 0; x < matrix.width && error.empty(); ++x) {
+                    if (csr.get_field(x, y) != matrix.field(x, y) || csc.get_field(x, y) != matrix.field(x, y)) {
+                        error = "field [" + std::to_string(x) + "," + std::to_string(y) + "] differs";
+                    }
+                }
+            }
+            failed += !report("sparse formats, " + std::to_string(static_cast<int>(zero_fraction * 100))
+                              + " % zeros", error);
+        }
+        return failed;
+    }
+
+    /**
+     * Checks that the binary files read back unchanged and that damaged files are rejected.
+     *
+     * @return number of failed checks
+     */
+    int test_binary_format() {
+        std::mt19937 generator(9);
+        int failed = 0;
+        const std::string path = "lss_test_binary.bin";
+
+        const Matrix dense = create_random_sparse(7, 5, 0.2, generator);
+        BinaryMatrixFile::write(path, dense);
+        failed += !report("binary dense round trip",
+                          is_equal(BinaryMatrixFile::load_dense(path), dense) ? "" : "loaded matrix differs");
+
+        BasicMatrix<float> dense_float(5, 3, true);
+        for (size_t i = 0; i < dense_float.size(); ++i) dense_float.data[i] = static_cast<float>(i) / 7;
+        BinaryMatrixFile::write(path, dense_float);
+        failed += !report("binary float round trip", is_equal(BinaryMatrixFile::load_dense_as<float>(path), dense_float)
+                                                     ? "" : "loaded matrix differs");
+
+        for (SparseFormat format : {SparseFormat::CSR, SparseFormat::CSC}) {
+            const SparseMatrix sparse(create_random_sparse(40, 30, 0.9, generator), format);
+            BinaryMatrixFile::write(path, sparse);
+            SparseMatrix loaded = BinaryMatrixFile::load_sparse(path);
+            bool equal = loaded.format == sparse.format && loaded.offsets == sparse.offsets
+                         && loaded.indexes == sparse.indexes && loaded.values == sparse.values;
+            failed += !report(std::string("binary sparse round trip, ") + (format == SparseFormat::CSR ? "CSR" : "CSC"),
+                              equal ? "" : "loaded matrix differs");
+        }
+
+        // one flipped bit of the data is caught by the checksum, unless the check is skipped
+        BinaryMatrixFile::write(path, dense);
+        std::vector<char> bytes = read_bytes(path);
+        bytes[sizeof(BinaryHeader) + 3] ^= 1;
+        failed += !report("binary rejects bad checksum", throws_domain_error([&]() {
+            BinaryMatrixFile::parse_dense(bytes.data(), bytes.size());
+        }) ? "" : "damaged data accepted");
+        failed += !report("binary skips checksum", !throws_domain_error([&]() {
+            BinaryMatrixFile::parse_dense(bytes.data(), bytes.size(), false);
+        }) ? "" : "damaged data rejected without the check");
+
+        bytes = read_bytes(path);
+        failed += !report("binary rejects truncated file", throws_domain_error([&]() {
+            BinaryMatrixFile::parse_dense(bytes.data(), bytes.size() - 8);
+        }) ? "" : "truncated data accepted");
+        bytes[0] = 'X';
+        failed += !report("binary rejects bad magic", throws_domain_error([&]() {
+            BinaryMatrixFile::parse_header(bytes.data(), bytes.size());
+        }) ? "" : "bad magic accepted");
+        failed += !report("binary rejects sparse as dense", throws_domain_error([&]() {
+            BinaryMatrixFile::write(path, SparseMatrix(dense));
+            BinaryMatrixFile::load_dense(path);
+        }) ? "" : "sparse file loaded as dense");
+
+        // structures with valid checksum, but not usable for indexing
+        const std::vector<std::pair<std::string, std::vector<int>>> structures = {
+                {"unsorted indexes",        {1, 0, 2}},
+                {"duplicate indexes",       {1, 1, 2}},
+                {"index out of range",      {0, 1, 3}},
+                {"negative index",          {-1, 1, 2}},
+        };
+        for (const auto &structure : structures) {
+            SparseMatrix sparse(3, 2, false, SparseFormat::CSR);
+            sparse.offsets = {0, 2, 3};
+            sparse.indexes = structure.second;
+            sparse.values = {1, 2, 3};
+            BinaryMatrixFile::write(path, sparse);
+            failed += !report("binary rejects " + structure.first, throws_domain_error([&]() {
+                BinaryMatrixFile::load_sparse(path);
+            }) ? "" : "invalid structure accepted");
+        }
+        std::remove(path.c_str());
+        return failed;
+    }
+
+    /**
+     * Checks the C interface against the C++ one, including the invalid arguments.
+     *
+     * @return number of failed checks
+     */
+    int test_c_interface() {
+        std::mt19937 generator(13);
+        int failed = 0;
+        const Matrix matrix = create_system(6, 6, 4, true, generator);
+        const SolveResult expected = SystemSolver::solve_with_method(matrix, SolverContext());
+
+        lss_context *context = lss_context_create();
+        lss_result *result = nullptr;
+        std::string error;
+        if (lss_context_set_threads(context, 2) != LSS_OK
+            || lss_solve(context, matrix.data, matrix.width, matrix.height, &result) != LSS_OK) {
+            error = lss_last_error();
+        } else if (lss_result_status(result) != LSS_STATUS_KERNEL || lss_result_rank(result) != expected.rank
+                   || lss_result_unknowns(result) != 6 || lss_result_kernel_size(result) != 2) {
+            error = "result differs";
+        } else if (!std::equal(expected.particular.begin(), expected.particular.end(),
+                               lss_result_particular(result))
+                   || !std::equal(expected.kernel[1].begin(), expected.kernel[1].end(),
+                                  lss_result_kernel_vector(result, 1))
+                   || lss_result_kernel_vector(result, 2) != nullptr || lss_result_total_ms(result) < 0) {
+            error = "solution differs";
+        }
+        lss_result_destroy(result);
+        failed += !report("C interface solve", error);
+
+        result = nullptr;
+        error.clear();
+        if (lss_context_set_method(context, LSS_METHOD_GMRES) != LSS_OK
+            || lss_context_set_preconditioner(context, LSS_PRECONDITIONER_ILU0) != LSS_OK) {
+            error = lss_last_error();
+        } else {
+            const Matrix iterative = create_tridiagonal_system(50, 1.5, 0.5);
+            if (lss_solve(context, iterative.data, iterative.width, iterative.height, &result) != LSS_OK) {
+                error = lss_last_error();
+            } else if (lss_result_status(result) != LSS_STATUS_UNIQUE || lss_result_rank(result) != -1) {
+                error = "GMRES did not converge";
+            }
+        }
+        lss_result_destroy(result);
+        failed += !report("C interface iterative solve", error);
+
+        error.clear();
+        if (lss_solve(context, matrix.data, 1, 1, &result) != LSS_ERROR_INVALID_ARGUMENT
+            || lss_solve(nullptr, matrix.data, matrix.width, matrix.height, &result) != LSS_ERROR_INVALID_ARGUMENT
+            || lss_context_set_method(context, 42) != LSS_ERROR_INVALID_ARGUMENT
+            || lss_context_set_threads(context, 0) != LSS_ERROR_INVALID_ARGUMENT
+            || lss_context_set_tolerance(context, -1) != LSS_ERROR_INVALID_ARGUMENT) {
+            error = "invalid argument accepted";
+        } else if (lss_context_set_threads(nullptr, 4) != LSS_ERROR_INVALID_ARGUMENT
+                   || std::string(lss_last_error()) != "context is null") {
+            error = "null context reported as \"" + std::string(lss_last_error()) + "\"";
+        }
+        failed += !report("C interface rejects invalid arguments", error);
+        lss_context_destroy(context);
+
+        bool sentinels = lss_result_status(nullptr) == LSS_STATUS_INVALID && lss_result_rank(nullptr) == -1
+                         && lss_result_unknowns(nullptr) == 0 && lss_result_particular(nullptr) == nullptr
+                         && lss_result_kernel_size(nullptr) == 0 && lss_result_kernel_vector(nullptr, 0) == nullptr
+                         && lss_result_factor_ms(nullptr) == -1 && lss_result_substitution_ms(nullptr) == -1
+                         && lss_result_total_ms(nullptr) == -1 && std::string(lss_last_error()) == "result is null";
+        failed += !report("C interface null result sentinels", sentinels ? "" : "sentinel differs");
+        return failed;
+    }
+}
+
+int main() {
+    int failed = test_systems();
+    failed += test_iterative();
+    failed += test_small_systems();
+    failed += test_out_of_core();
+    failed += test_text_parser();
+    failed += test_number_formatter();
+    failed += test_sparse_formats();
+    failed += test_binary_format();
+    failed += test_c_interface();
+
+    std::cout << failed << " checks failed." << std::endl;
+    return failed == 0 ? 0 : 1;
+}
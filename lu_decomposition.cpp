@@ -0,0 +1,489 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "lu_decomposition.hpp"
+#include "gemm.hpp"
+#include "thread_pool.hpp"
+#include "statistics.hpp"
+
+namespace {
+    /**
+     * Struct representing factored panel of the blocked decomposition.
+     */
+    template<typename T>
+    struct PanelFactors {
+        /**
+         * Row of the first pivot of the panel.
+         */
+        int first_row = 0;
+        /**
+         * Row swaps in the order they were done, the first row of the pair is swapped with the second one.
+         */
+        std::vector<std::pair<int, int>> swaps;
+        std::vector<int> pivots_columns;
+        /**
+         * Multipliers of the pivot rows (strictly lower part of rank * rank matrix), row after row.
+         */
+        std::vector<T> L11;
+        /**
+         * Multipliers of the rows below the pivot rows ((height - first_row - rank) * rank matrix), row after row.
+         */
+        std::vector<T> L21;
+
+        int rank() const {
+            return static_cast<int>(pivots_columns.size());
+        }
+    };
+
+    template<typename T>
+    inline void swap_row_parts(T *data, int width, int row, int other_row, int column_begin, int column_end) {
+        std::swap_ranges(data + static_cast<size_t>(width) * row + column_begin,
+                         data + static_cast<size_t>(width) * row + column_end,
+                         data + static_cast<size_t>(width) * other_row + column_begin);
+    }
+
+    /**
+     * Copies the multipliers from the pivot columns to L11 and L21, so they are contiguous even if some
+     * columns of the panel have no pivot.
+     */
+    template<typename T>
+    void pack_multipliers(const T *data, int width, int height, PanelFactors<T> &panel) {
+        const int rank = panel.rank();
+        const int below = height - panel.first_row - rank;
+        panel.L11.assign(static_cast<size_t>(rank) * rank, T(0));
+        panel.L21.assign(static_cast<size_t>(below) * rank, T(0));
+        for (int a = 0; a < rank; ++a) {
+            const T *row = data + static_cast<size_t>(width) * (panel.first_row + a);
+            for (int i = 0; i < a; ++i) {
+                panel.L11[static_cast<size_t>(rank) * a + i] = row[panel.pivots_columns[i]];
+            }
+        }
+        for (int y = 0; y < below; ++y) {
+            const T *row = data + static_cast<size_t>(width) * (panel.first_row + rank + y);
+            for (int i = 0; i < rank; ++i) {
+                panel.L21[static_cast<size_t>(rank) * y + i] = row[panel.pivots_columns[i]];
+            }
+        }
+    }
+
+    /**
+     * Updates columns column_begin to column_end - 1 by the factored panel: applies its row swaps,
+     * solves the pivot rows with L11 and subtracts L21 times the pivot rows from the rows below.
+     */
+    template<typename T>
+    void apply_panel(T *data, int width, int height, const PanelFactors<T> &panel,
+                     int column_begin, int column_end) {
+        if (column_begin >= column_end) return;
+        for (const auto &swap : panel.swaps) {
+            if (swap.first != swap.second) {
+                swap_row_parts(data, width, swap.first, swap.second, column_begin, column_end);
+            }
+        }
+
+        const int rank = panel.rank();
+        for (int a = 1; a < rank; ++a) {
+            T *row = data + static_cast<size_t>(width) * (panel.first_row + a);
+            for (int i = 0; i < a; ++i) {
+                T multiplier = panel.L11[static_cast<size_t>(rank) * a + i];
+                if (multiplier == 0) continue;
+                const T *pivot_row = data + static_cast<size_t>(width) * (panel.first_row + i);
+                for (int x = column_begin; x < column_end; ++x) {
+                    row[x] -= multiplier * pivot_row[x];
+                }
+            }
+        }
+
+        const int below = height - panel.first_row - rank;
+        if (rank > 0 && below > 0) {
+            T *pivot_rows = data + static_cast<size_t>(width) * panel.first_row + column_begin;
+            GemmEngine::multiply_add(below, column_end - column_begin, rank, T(-1), panel.L21.data(), rank,
+                                     pivot_rows, width, pivot_rows + static_cast<size_t>(width) * rank, width);
+        }
+    }
+
+    /**
+     * Factors columns column_begin to column_end - 1 from the row first_row down, the columns are expected
+     * to be updated by all previous panels. Row swaps are applied only to the columns of the panel.
+     */
+    template<typename T>
+    PanelFactors<T> factor_panel(T *data, int width, int height, T tolerance,
+                              int column_begin, int column_end, int first_row) {
+        PanelFactors<T> panel;
+        panel.first_row = first_row;
+
+        if (column_end - column_begin <= LU_PANEL_BASE_WIDTH) {
+            // the same elimination as LUDecomposer::decompose_in_place, limited to the columns of the panel
+            int pivot_row_index = first_row;
+            for (int x = column_begin; x < column_end && pivot_row_index < height; ++x) {
+                int current_pivot = pivot_row_index;
+                T current_max = std::abs(data[x + static_cast<size_t>(width) * pivot_row_index]);
+                for (int y = pivot_row_index + 1; y < height; ++y) {
+                    T e = std::abs(data[x + static_cast<size_t>(width) * y]);
+                    if (e > current_max) {
+                        current_max = e;
+                        current_pivot = y;
+                    }
+                }
+
+                if (current_max <= tolerance) {
+                    for (int y = pivot_row_index; y < height; ++y) {
+                        data[x + static_cast<size_t>(width) * y] = 0;
+                    }
+                    continue;
+                }
+
+                if (current_pivot != pivot_row_index) {
+                    swap_row_parts(data, width, pivot_row_index, current_pivot, column_begin, column_end);
+                }
+                panel.swaps.emplace_back(pivot_row_index, current_pivot);
+
+                const T *pivot_row = data + static_cast<size_t>(width) * pivot_row_index;
+                const T pivot = pivot_row[x];
+                for (int y = pivot_row_index + 1; y < height; ++y) {
+                    T *row = data + static_cast<size_t>(width) * y;
+                    T multiplier = row[x] / pivot;
+                    row[x] = multiplier;
+                    if (multiplier == 0) continue;
+                    for (int k = x + 1; k < column_end; ++k) {
+                        row[k] -= multiplier * pivot_row[k];
+                    }
+                }
+
+                panel.pivots_columns.push_back(x);
+                pivot_row_index++;
+            }
+            return panel;
+        }
+
+        // factor the left half, update the right half by it and factor the right half
+        const int middle = column_begin + (column_end - column_begin) / 2;
+        PanelFactors<T> left = factor_panel(data, width, height, tolerance, column_begin, middle, first_row);
+        pack_multipliers(data, width, height, left);
+        apply_panel(data, width, height, left, middle, column_end);
+        PanelFactors<T> right = factor_panel(data, width, height, tolerance, middle, column_end,
+                                          first_row + left.rank());
+        for (const auto &swap : right.swaps) {
+            if (swap.first != swap.second) {
+                swap_row_parts(data, width, swap.first, swap.second, column_begin, middle);
+            }
+        }
+
+        panel.swaps = std::move(left.swaps);
+        panel.swaps.insert(panel.swaps.end(), right.swaps.begin(), right.swaps.end());
+        panel.pivots_columns = std::move(left.pivots_columns);
+        panel.pivots_columns.insert(panel.pivots_columns.end(), right.pivots_columns.begin(),
+                                    right.pivots_columns.end());
+        return panel;
+    }
+}
+
+namespace {
+    /**
+     * Decomposes the factors of long double and complex matrices without blocking, GemmEngine multiplies
+     * only floats and doubles.
+     */
+    template<typename T>
+    int decompose_factors(BasicLUDecomposition<T> &lu, const RealType<T> &tolerance,
+                          std::vector<int> &pivots_columns, int /*thread_count*/) {
+        return LUDecomposer::decompose_in_place(lu.factors.data, lu.factors.width, lu.factors.height, tolerance,
+                                                lu.permutation, pivots_columns);
+    }
+
+    template<typename T>
+    int decompose_blocked_factors(BasicLUDecomposition<T> &lu, const T &tolerance, std::vector<int> &pivots_columns,
+                                  int thread_count) {
+        if (std::min(lu.factors.width, lu.factors.height) >= LU_BLOCKED_THRESHOLD) {
+            return LUDecomposer::decompose_blocked(lu.factors.data, lu.factors.width, lu.factors.height, tolerance,
+                                                   lu.permutation, pivots_columns, thread_count);
+        }
+        return LUDecomposer::decompose_in_place(lu.factors.data, lu.factors.width, lu.factors.height, tolerance,
+                                                lu.permutation, pivots_columns);
+    }
+
+    int decompose_factors(BasicLUDecomposition<float> &lu, const float &tolerance, std::vector<int> &pivots_columns,
+                          int thread_count) {
+        return decompose_blocked_factors(lu, tolerance, pivots_columns, thread_count);
+    }
+
+    int decompose_factors(LUDecomposition &lu, const double &tolerance, std::vector<int> &pivots_columns,
+                          int thread_count) {
+        return decompose_blocked_factors(lu, tolerance, pivots_columns, thread_count);
+    }
+}
+
+template<typename T>
+BasicLUDecomposition<T>::BasicLUDecomposition(BasicMatrix<T> factors) :
+        factors(std::move(factors)), row_swaps(0) {
+    permutation.reserve(this->factors.height);
+    for (int y = 0; y < this->factors.height; ++y) {
+        permutation.push_back(y);
+    }
+}
+
+template<typename T>
+int BasicLUDecomposition<T>::rank() const {
+    return echelon.rank();
+}
+
+template<typename T>
+BasicMatrix<T> BasicLUDecomposition<T>::get_upper() const {
+    ScopedTimer timer(Phase::COPY);
+    BasicMatrix<T> matrix_U(factors.width, factors.height, factors.augmented);
+    for (int y = 0; y < rank(); ++y) {
+        std::copy(factors.data + factors.index(echelon.pivots_columns[y], y),
+                  factors.data + factors.index(factors.width - 1, y) + 1,
+                  matrix_U.data + matrix_U.index(echelon.pivots_columns[y], y));
+        Statistics::add(Counter::BYTES_COPIED, (factors.width - echelon.pivots_columns[y]) * sizeof(T));
+    }
+    return matrix_U;
+}
+
+template<typename T>
+BasicMatrix<T> BasicLUDecomposition<T>::get_lower() const {
+    BasicMatrix<T> matrix_L = BasicMatrixCreator<T>::get_identity(factors.height);
+    for (int x = 0; x < rank(); ++x) {
+        for (int y = x + 1; y < factors.height; ++y) {
+            matrix_L.set_field(x, y, factors.get_field(echelon.pivots_columns[x], y));
+        }
+    }
+    return matrix_L;
+}
+
+template<typename T>
+RealType<T> LUDecomposer::get_zero_tolerance(const BasicMatrix<T> &matrix) {
+    // vector b does not take part, large right-hand side must not turn the pivots of A into round-off
+    const int unknowns = matrix.augmented ? matrix.width - 1 : matrix.width;
+    RealType<T> max_abs = 0;
+    for (int y = 0; y < matrix.height; ++y) {
+        const T *row = matrix.data + static_cast<size_t>(matrix.width) * y;
+        for (int x = 0; x < unknowns; ++x) {
+            max_abs = std::max(max_abs, ScalarTraits<T>::magnitude(row[x]));
+        }
+    }
+    return std::max(matrix.width, matrix.height) * std::numeric_limits<RealType<T>>::epsilon() * max_abs;
+}
+
+template<typename T>
+RealType<T> LUDecomposer::get_rhs_tolerance(const BasicMatrix<T> &matrix) {
+    RealType<T> max_abs = 0;
+    for (size_t i = 0; i < matrix.size(); ++i) {
+        max_abs = std::max(max_abs, ScalarTraits<T>::magnitude(matrix.data[i]));
+    }
+    return std::max(matrix.width, matrix.height) * std::numeric_limits<RealType<T>>::epsilon() * max_abs;
+}
+
+template<typename T>
+int LUDecomposer::decompose_in_place(T *data, const int &width, const int &height, const RealType<T> &tolerance,
+                                     std::vector<int> &permutation, std::vector<int> &pivots_columns) {
+    int row_swaps = 0;
+    int pivot_row_index = 0;
+
+    for (int x = 0; x < width && pivot_row_index < height; ++x) {
+        // find the element with the largest magnitude in the rest of the column
+        int current_pivot = pivot_row_index;
+        RealType<T> current_max = ScalarTraits<T>::magnitude(data[x + static_cast<size_t>(width) * pivot_row_index]);
+        for (int y = pivot_row_index + 1; y < height; ++y) {
+            RealType<T> e = ScalarTraits<T>::magnitude(data[x + static_cast<size_t>(width) * y]);
+            if (e > current_max) {
+                current_max = e;
+                current_pivot = y;
+            }
+        }
+
+        if (current_max <= tolerance) {
+            // no pivot in this column, drop the round-off so it does not appear in U
+            for (int y = pivot_row_index; y < height; ++y) {
+                data[x + static_cast<size_t>(width) * y] = 0;
+            }
+            continue;
+        }
+
+        if (current_pivot != pivot_row_index) {
+            std::swap_ranges(data + static_cast<size_t>(width) * pivot_row_index,
+                             data + static_cast<size_t>(width) * (pivot_row_index + 1),
+                             data + static_cast<size_t>(width) * current_pivot);
+            std::swap(permutation[pivot_row_index], permutation[current_pivot]);
+            row_swaps++;
+        }
+
+        const T *pivot_row = data + static_cast<size_t>(width) * pivot_row_index;
+        const T pivot = pivot_row[x];
+        for (int y = pivot_row_index + 1; y < height; ++y) {
+            T *row = data + static_cast<size_t>(width) * y;
+            T multiplier = row[x] / pivot;
+            row[x] = multiplier;
+            if (multiplier == T(0)) continue;
+            ScalarKernels::subtract_scaled(row + x + 1, pivot_row + x + 1, multiplier, width - x - 1);
+        }
+
+        pivots_columns.push_back(x);
+        pivot_row_index++;
+    }
+
+    return row_swaps;
+}
+
+template int LUDecomposer::decompose_in_place<float>(float *, const int &, const int &, const float &,
+                                                     std::vector<int> &, std::vector<int> &);
+
+template int LUDecomposer::decompose_in_place<double>(double *, const int &, const int &, const double &,
+                                                      std::vector<int> &, std::vector<int> &);
+
+template int LUDecomposer::decompose_in_place<long double>(long double *, const int &, const int &,
+                                                           const long double &, std::vector<int> &,
+                                                           std::vector<int> &);
+
+template int LUDecomposer::decompose_in_place<std::complex<double>>(std::complex<double> *, const int &, const int &,
+                                                                    const double &, std::vector<int> &,
+                                                                    std::vector<int> &);
+
+template<typename T>
+int LUDecomposer::decompose_blocked(T *data, const int &width, const int &height, const T &tolerance,
+                                    std::vector<int> &permutation, std::vector<int> &pivots_columns,
+                                    int thread_count) {
+    std::shared_ptr<ThreadPool> pool;
+    if (thread_count > 1) {
+        pool = ThreadPool::get_shared(thread_count - 1);
+    }
+
+    std::vector<PanelFactors<T>> panels;
+    std::vector<int> panels_begins;
+    int panel_begin = 0;
+    int panel_end = std::min(width, LU_PANEL_WIDTH);
+    PanelFactors<T> panel = factor_panel(data, width, height, tolerance, panel_begin, panel_end, 0);
+
+    while (true) {
+        pack_multipliers(data, width, height, panel);
+        const int next_row = panel.first_row + panel.rank();
+        const int next_end = std::min(width, panel_end + LU_PANEL_WIDTH);
+        const bool has_next = panel_end < width && next_row < height;
+
+        // lookahead, the next panel is updated first so it can be factored while the rest is being updated
+        int tiles_begin = panel_end;
+        if (has_next) {
+            apply_panel(data, width, height, panel, panel_end, next_end);
+            tiles_begin = next_end;
+        }
+        std::vector<std::future<void>> updates;
+        for (int tile = tiles_begin; tile < width; tile += LU_UPDATE_TILE) {
+            const int tile_end = std::min(width, tile + LU_UPDATE_TILE);
+            if (pool) {
+                updates.push_back(pool->submit([data, width, height, &panel, tile, tile_end]() {
+                    apply_panel(data, width, height, panel, tile, tile_end);
+                }));
+            } else {
+                apply_panel(data, width, height, panel, tile, tile_end);
+            }
+        }
+
+        PanelFactors<T> next;
+        if (has_next) {
+            next = factor_panel(data, width, height, tolerance, panel_end, next_end, next_row);
+        }
+        for (auto &update : updates) {
+            // help with the remaining tiles instead of blocking
+            while (update.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                if (!pool->run_pending_task()) {
+                    std::this_thread::yield();
+                }
+            }
+            update.get();
+        }
+
+        panels_begins.push_back(panel_begin);
+        panels.push_back(std::move(panel));
+        if (!has_next) break;
+        panel = std::move(next);
+        panel_begin = panel_end;
+        panel_end = next_end;
+    }
+
+    // the swaps of the later panels were not applied to the multipliers of the earlier ones yet
+    int row_swaps = 0;
+    for (size_t k = 0; k < panels.size(); ++k) {
+        for (const auto &swap : panels[k].swaps) {
+            if (swap.first == swap.second) continue;
+            swap_row_parts(data, width, swap.first, swap.second, 0, panels_begins[k]);
+            std::swap(permutation[swap.first], permutation[swap.second]);
+            row_swaps++;
+        }
+        pivots_columns.insert(pivots_columns.end(), panels[k].pivots_columns.begin(), panels[k].pivots_columns.end());
+    }
+    return row_swaps;
+}
+
+template int LUDecomposer::decompose_blocked<float>(float *, const int &, const int &, const float &,
+                                                    std::vector<int> &, std::vector<int> &, int);
+
+template int LUDecomposer::decompose_blocked<double>(double *, const int &, const int &, const double &,
+                                                     std::vector<int> &, std::vector<int> &, int);
+
+template<typename T>
+BasicLUDecomposition<T> LUDecomposer::decompose(BasicMatrix<T> matrix, int thread_count) {
+    ScopedTimer timer(Phase::FACTOR);
+    const RealType<T> tolerance = get_zero_tolerance(matrix);
+    const RealType<T> rhs_tolerance = matrix.augmented ? get_rhs_tolerance(matrix) : tolerance;
+    BasicLUDecomposition<T> lu(std::move(matrix));
+    std::vector<int> pivots_columns;
+    lu.row_swaps = decompose_factors(lu, tolerance, pivots_columns, thread_count);
+
+    // the pivot in vector b is the largest remaining residual, it is round-off if it is small against b as well
+    const int last_column = lu.factors.width - 1;
+    if (lu.factors.augmented && !pivots_columns.empty() && pivots_columns.back() == last_column) {
+        const int row = static_cast<int>(pivots_columns.size()) - 1;
+        if (ScalarTraits<T>::magnitude(lu.factors.field(last_column, row)) <= rhs_tolerance) {
+            for (int y = row; y < lu.factors.height; ++y) {
+                lu.factors.field(last_column, y) = 0;
+            }
+            pivots_columns.pop_back();
+        }
+    }
+    {
+        ScopedTimer pivot_timer(Phase::PIVOT_SEARCH);
+        const int unknowns = lu.factors.augmented ? lu.factors.width - 1 : lu.factors.width;
+        lu.echelon = EchelonStructure(std::move(pivots_columns), lu.factors.width, unknowns);
+    }
+    Statistics::add(Counter::ROW_SWAPS, lu.row_swaps);
+    return lu;
+}
+
+template struct BasicLUDecomposition<float>;
+
+template struct BasicLUDecomposition<double>;
+
+template struct BasicLUDecomposition<long double>;
+
+template struct BasicLUDecomposition<std::complex<double>>;
+
+template BasicLUDecomposition<float> LUDecomposer::decompose<float>(BasicMatrix<float>, int);
+
+template BasicLUDecomposition<double> LUDecomposer::decompose<double>(BasicMatrix<double>, int);
+
+template BasicLUDecomposition<long double> LUDecomposer::decompose<long double>(BasicMatrix<long double>, int);
+
+template BasicLUDecomposition<std::complex<double>>
+LUDecomposer::decompose<std::complex<double>>(BasicMatrix<std::complex<double>>, int);
+
+template float LUDecomposer::get_zero_tolerance<float>(const BasicMatrix<float> &);
+
+template double LUDecomposer::get_zero_tolerance<double>(const BasicMatrix<double> &);
+
+template long double LUDecomposer::get_zero_tolerance<long double>(const BasicMatrix<long double> &);
+
+template double LUDecomposer::get_zero_tolerance<std::complex<double>>(const BasicMatrix<std::complex<double>> &);
+
+template float LUDecomposer::get_rhs_tolerance<float>(const BasicMatrix<float> &);
+
+template double LUDecomposer::get_rhs_tolerance<double>(const BasicMatrix<double> &);
+
+template long double LUDecomposer::get_rhs_tolerance<long double>(const BasicMatrix<long double> &);
+
+template double LUDecomposer::get_rhs_tolerance<std::complex<double>>(const BasicMatrix<std::complex<double>> &);
@@ -0,0 +1,164 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_LU_DECOMPOSITION_HPP
+#define LINEAR_SYSTEM_SOLVER_LU_DECOMPOSITION_HPP
+
+#include <vector>
+
+#include "matrix.hpp"
+#include "echelon_structure.hpp"
+#include "scalar_type.hpp"
+
+/**
+ * Constant representing size (smaller of width and height) from which the matrices are decomposed by blocks.
+ */
+#define LU_BLOCKED_THRESHOLD 192
+
+/**
+ * Constant representing number of columns of one panel of the blocked decomposition.
+ */
+#define LU_PANEL_WIDTH 96
+
+/**
+ * Constant representing number of columns under which the panel is factored without further recursion.
+ */
+#define LU_PANEL_BASE_WIDTH 8
+
+/**
+ * Constant representing number of columns of the trailing matrix updated by one task.
+ */
+#define LU_UPDATE_TILE 192
+
+/**
+ * Struct representing compact result of the LU decomposition with partial pivoting (PA = LU).
+ * <p>
+ * Both factors share one matrix. Row k of the upper triangular (echelon) matrix U starts on the column
+ * echelon.pivots_columns[k], the multipliers of the lower triangular matrix L are stored below the pivots
+ * in the pivot columns. Rows of the matrix are permuted, original index of k-th row is permutation[k].
+ * Instantiated for the same types as BasicMatrix, LUDecomposition holds the double factors.
+ *
+ * @tparam T type of the elements
+ */
+template<typename T>
+struct BasicLUDecomposition {
+    BasicMatrix<T> factors;
+    std::vector<int> permutation;
+    EchelonStructure echelon;
+    int row_swaps;
+
+    /**
+     * @param factors compact factors of the decomposition
+     */
+    explicit BasicLUDecomposition(BasicMatrix<T> factors);
+
+    /**
+     * @return number of found pivots (rank of the decomposed matrix)
+     */
+    int rank() const;
+
+    /**
+     * Extracts upper triangular (row echelon) matrix U from the compact factors.
+     *
+     * @return Matrix U with the same dimensions and augmented flag as the decomposed matrix
+     */
+    BasicMatrix<T> get_upper() const;
+
+    /**
+     * Extracts lower triangular matrix L with ones on diagonal from the compact factors.
+     *
+     * @return Matrix L (size height * height)
+     */
+    BasicMatrix<T> get_lower() const;
+};
+
+using LUDecomposition = BasicLUDecomposition<double>;
+
+/**
+ * Class responsible for computing the LU decomposition.
+ */
+class LUDecomposer {
+public:
+    /**
+     * Decomposes the given matrix in place with partial pivoting, the pivot in each column
+     * is the element with the largest magnitude. Elements not larger than the tolerance derived from
+     * the magnitude of the elements of matrix A are considered zero, so the round-off does not create false pivots.
+     * The pivot in vector b of augmented matrix is kept only if it is larger than get_rhs_tolerance.
+     * <p>
+     * Runs in O(width * height * rank) time. Float and double matrices from LU_BLOCKED_THRESHOLD up are decomposed
+     * by decompose_blocked, smaller ones and the matrices of the other scalar types by decompose_in_place.
+     *
+     * @tparam T type of the elements
+     * @param matrix matrix to be decomposed, its buffer is reused for the factors
+     * @param thread_count number of threads used by the blocked decomposition
+     * @return LUDecomposition compact factors of the given matrix
+     */
+    template<typename T>
+    static BasicLUDecomposition<T> decompose(BasicMatrix<T> matrix, int thread_count = 1);
+
+    /**
+     * Decomposes the row-major buffer in place with the same pivots as decompose_in_place, but the work
+     * is done by blocks so that most of it is matrix multiplication.
+     * <p>
+     * The matrix is processed in panels of LU_PANEL_WIDTH columns (right-looking). The panel is factored
+     * recursively: the left half is factored, the right half is updated by it (row swaps, triangular solve
+     * and GEMM) and then factored, down to LU_PANEL_BASE_WIDTH columns. The trailing matrix is updated
+     * in tiles of LU_UPDATE_TILE columns by the tasks of the shared ThreadPool. Tile with the next panel
+     * is updated first and the next panel is factored while the other tiles are still being updated.
+     * Columns without a pivot are allowed, the multipliers of the pivot columns are packed before the updates.
+     * Row swaps of each panel are applied to the columns left of it at the end. Instantiated for float and double,
+     * the types GemmEngine multiplies.
+     *
+     * @tparam T type of the elements
+     * @param data buffer with width * height elements, overwritten by the compact factors
+     * @param width number of columns
+     * @param height number of rows
+     * @param tolerance magnitude under which the elements are considered zero
+     * @param permutation identity permutation of size height, the row swaps are applied to it
+     * @param pivots_columns vector the pivot columns are appended to
+     * @param thread_count number of threads, 1 means no worker threads
+     * @return number of row swaps
+     */
+    template<typename T>
+    static int decompose_blocked(T *data, const int &width, const int &height, const T &tolerance,
+                                 std::vector<int> &permutation, std::vector<int> &pivots_columns,
+                                 int thread_count);
+
+    /**
+     * Decomposes the row-major buffer in place with the same algorithm as decompose. Instantiated for float,
+     * double, long double and std::complex<double>, the magnitude of the complex pivots is |re| + |im|
+     * and the row updates of all types are done by ScalarKernels::subtract_scaled.
+     *
+     * @tparam T type of the elements
+     * @param data buffer with width * height elements, overwritten by the compact factors
+     * @param width number of columns
+     * @param height number of rows
+     * @param tolerance magnitude under which the elements are considered zero
+     * @param permutation identity permutation of size height, the row swaps are applied to it
+     * @param pivots_columns vector the pivot columns are appended to
+     * @return number of row swaps
+     */
+    template<typename T>
+    static int decompose_in_place(T *data, const int &width, const int &height, const RealType<T> &tolerance,
+                                  std::vector<int> &permutation, std::vector<int> &pivots_columns);
+
+    /**
+     * @tparam T type of the elements
+     * @param matrix matrix to compute the tolerance for, vector b of augmented matrix is not taken into account
+     * @return magnitude under which the elements of the matrix are considered zero during the decomposition
+     */
+    template<typename T>
+    static RealType<T> get_zero_tolerance(const BasicMatrix<T> &matrix);
+
+    /**
+     * @tparam T type of the elements
+     * @param matrix augmented matrix to compute the tolerance for
+     * @return magnitude under which the residual of vector b is considered zero, it is derived from both
+     * matrix A and vector b like in Factorization::solve
+     */
+    template<typename T>
+    static RealType<T> get_rhs_tolerance(const BasicMatrix<T> &matrix);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_LU_DECOMPOSITION_HPP
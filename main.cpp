@@ -2,13 +2,70 @@
 // Created by tomanm10 on 23.11.2019.
 //
 
+#include <algorithm>
+#include <csignal>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "command.hpp"
+#include "batch_runner.hpp"
+#include "server.hpp"
+#include "statistics.hpp"
+#include "result_sink.hpp"
+#include "scalar_type.hpp"
 
 int main(int argc, char **argv) {
-    auto cmd_itp = std::make_unique<CommandInterpreter>();
+    SolverContext context;
+    try {
+        // --stats, --output and --type are accepted in all modes, the rest of the arguments belongs to the batch
+        // or the server mode
+        std::vector<char *> arguments;
+        for (int i = 0; i < argc; ++i) {
+            if (i == 0 || (!Statistics::parse_argument(argv[i]) &&
+                           !ResultSink::parse_argument(argv[i], context.output_level) &&
+                           !ScalarTypes::parse_argument(argv[i], context.scalar_type))) {
+                arguments.push_back(argv[i]);
+            }
+        }
+        // the batch and the server modes are built around the double solver (factorization cache, sparse path)
+        bool double_type = context.scalar_type == ScalarType::FLOAT64;
+        ServerSettings server_settings;
+        server_settings.context = context;
+        if (SolverServer::parse_arguments(static_cast<int>(arguments.size()), arguments.data(), server_settings)) {
+            if (!double_type) {
+                throw std::domain_error("Server mode solves only double systems.");
+            }
+            std::signal(SIGINT, [](int) { SolverServer::request_stop(); });
+            std::signal(SIGTERM, [](int) { SolverServer::request_stop(); });
+            SolverServer::run(std::cout, server_settings);
+            Statistics::print(std::cout, Statistics::get_snapshot());
+            return 0;
+        }
+        BatchSettings batch_settings;
+        batch_settings.context = context;
+        if (BatchRunner::parse_arguments(static_cast<int>(arguments.size()), arguments.data(), batch_settings)) {
+            if (!double_type) {
+                throw std::domain_error("Batch mode solves only double systems.");
+            }
+            std::vector<BatchFileResult> results = BatchRunner::run(std::cout, batch_settings);
+            Statistics::print(std::cout, Statistics::get_snapshot());
+            bool all_succeeded = std::all_of(results.begin(), results.end(),
+                                             [](const BatchFileResult &result) { return result.succeeded; });
+            return all_succeeded ? 0 : 1;
+        }
+    } catch (std::exception &e) {
+        std::cerr << "An exception occurred: " << e.what() << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [--type=float|double|long-double|complex] [--stats=json|text]"
+                  << " [--output=quiet|summary|full|csv|binary]" << std::endl;
+        std::cerr << "       " << argv[0] << " [--batch PATH ...] [--jobs N] [--out DIR] [--stats=json|text]"
+                  << " [--output=quiet|summary|full|csv|binary]" << std::endl;
+        std::cerr << "       " << argv[0] << " --serve SOCKET [--jobs N] [--threads N] [--cache N]"
+                  << " [--stats=json|text] [--output=quiet|summary|full|csv|binary]" << std::endl;
+        return 2;
+    }
+
+    auto cmd_itp = std::make_unique<CommandInterpreter>(context);
     cmd_itp->print_help(std::cout);
     Command cmd_to_process = Command::UNKNOWN;
 
@@ -16,4 +73,4 @@ int main(int argc, char **argv) {
         cmd_to_process = cmd_itp->get_command(std::cout, std::cin);
         cmd_itp->process_command(std::cout, std::cin, cmd_to_process);
     }
-}
\ No newline at end of file
+}
@@ -6,49 +6,113 @@
 #include <iomanip>
 #include <exception>
 #include <algorithm>
+#include <functional>
+#include <iterator>
 
 #include "matrix.hpp"
+#include "gemm.hpp"
+#include "buffer_pool.hpp"
+#include "text_parser.hpp"
+#include "statistics.hpp"
+
+namespace {
+    /**
+     * BufferPool hands out buffers of doubles, the elements of other sizes take the number of doubles
+     * covering them, the buffers stay aligned to BUFFER_ALIGNMENT.
+     */
+    template<typename T>
+    size_t get_buffer_count(size_t size) {
+        return (size * sizeof(T) + sizeof(double) - 1) / sizeof(double);
+    }
+
+    template<typename T>
+    void multiply(const BasicMatrix<T> &A, const BasicMatrix<T> &B, BasicMatrix<T> &result) {
+        for (int y = 0; y < A.height; ++y) {
+            T *target = result.data + static_cast<size_t>(result.width) * y;
+            for (int k = 0; k < A.width; ++k) {
+                ScalarKernels::subtract_scaled(target, B.data + static_cast<size_t>(B.width) * k,
+                                               T(-A.field(k, y)), B.width);
+            }
+        }
+    }
+
+    void multiply(const Matrix &A, const Matrix &B, Matrix &result) {
+        GemmEngine::multiply_add(A.height, B.width, A.width, 1.0, A.data, A.width, B.data, B.width,
+                                 result.data, result.width);
+    }
+
+    template<typename T>
+    void print_vector(std::ostream &ostream, const std::vector<T> &vector) {
+        ostream << "Vector ( ";
+        for (auto n : vector) {
+            ostream << n << " ";
+        }
+        ostream << ")" << std::endl;
+    }
+}
 
-Matrix::Matrix(const int &width, const int &height, const bool &augmented) :
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const int &width, const int &height, const bool &augmented) :
         width(width), height(height), augmented(augmented) {
-    data = new double[width * height](); // all elements set to 0
+    data = reinterpret_cast<T *>(BufferPool::allocate(get_buffer_count<T>(size())));
+    std::fill(data, data + size(), T(0)); // all elements set to 0
 }
 
-Matrix::~Matrix() {
-    delete[] data;
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const int &width, const int &height, const bool &augmented, T *data,
+                            std::shared_ptr<void> storage) :
+        width(width), height(height), data(data), augmented(augmented), storage(std::move(storage)) {}
+
+template<typename T>
+BasicMatrix<T>::~BasicMatrix() {
+    if (!storage) {
+        BufferPool::release(reinterpret_cast<double *>(data), get_buffer_count<T>(size()));
+    }
 }
 
-Matrix::Matrix(const Matrix &rhs) :
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix &rhs) :
         width(rhs.width), height(rhs.height), augmented(rhs.augmented) {
-    data = new double[width * height]();
-    std::copy(rhs.data, rhs.data + rhs.width * rhs.height, data);
+    ScopedTimer timer(Phase::COPY);
+    data = reinterpret_cast<T *>(BufferPool::allocate(get_buffer_count<T>(size())));
+    std::copy(rhs.data, rhs.data + rhs.size(), data);
+    Statistics::add(Counter::BYTES_COPIED, size() * sizeof(T));
 }
 
-Matrix::Matrix(Matrix &&rhs) noexcept :
-        width(rhs.width), height(rhs.height), augmented(rhs.augmented) {
-    data = new double[width * height]();
-    std::move(rhs.data, rhs.data + rhs.width * rhs.height, data);
+template<typename T>
+BasicMatrix<T>::BasicMatrix(BasicMatrix &&rhs) noexcept :
+        width(rhs.width), height(rhs.height), data(rhs.data), augmented(rhs.augmented),
+        storage(std::move(rhs.storage)) {
+    // the moved from matrix is left empty
+    rhs.width = 0;
+    rhs.height = 0;
+    rhs.data = nullptr;
 }
 
-Matrix &Matrix::operator=(const Matrix &rhs) {
-    Matrix temp(rhs);
+template<typename T>
+BasicMatrix<T> &BasicMatrix<T>::operator=(const BasicMatrix &rhs) {
+    BasicMatrix temp(rhs);
     swap(temp);
     return *this;
 }
 
-Matrix &Matrix::operator=(Matrix &&rhs) noexcept {
+template<typename T>
+BasicMatrix<T> &BasicMatrix<T>::operator=(BasicMatrix &&rhs) noexcept {
     swap(rhs);
     return *this;
 }
 
-void Matrix::swap(Matrix &rhs) {
+template<typename T>
+void BasicMatrix<T>::swap(BasicMatrix &rhs) {
     std::swap(width, rhs.width);
     std::swap(height, rhs.height);
     std::swap(augmented, rhs.augmented);
     std::swap(data, rhs.data);
+    std::swap(storage, rhs.storage);
 }
 
-size_t Matrix::index(const int &x, const int &y) const {
+template<typename T>
+size_t BasicMatrix<T>::index(const int &x, const int &y) const {
     if (x >= width || y >= height) {
         std::cerr << x << "; " << y << std::endl;
         throw std::out_of_range("trying to access matrix field that does not exit!");
@@ -56,72 +120,109 @@ size_t Matrix::index(const int &x, const int &y) const {
     return x + width * y;
 }
 
-double Matrix::get_field(const int &x, const int &y) const {
+template<typename T>
+T BasicMatrix<T>::get_field(const int &x, const int &y) const {
     return data[index(x, y)];
 }
 
-void Matrix::set_field(const int &x, const int &y, double value) {
+template<typename T>
+void BasicMatrix<T>::set_field(const int &x, const int &y, T value) {
     data[index(x, y)] = value;
 }
 
-std::vector<double> Matrix::get_row(const int &y) const {
-    std::vector<double> row;
-    row.reserve(width);
-    for (int x = 0; x < width; ++x) {
-        row.push_back(get_field(x, y));
-    }
-    return row;
+template<typename T>
+BasicRowView<T> BasicMatrix<T>::row(const int &y) {
+    return BasicRowView<T>(data + index(0, y), width);
 }
 
-std::vector<double> Matrix::get_column(const int &x) const {
-    std::vector<double> column;
-    column.reserve(height);
-    for (int y = 0; y < height; ++y) {
-        column.push_back(get_field(x, y));
-    }
-    return column;
+template<typename T>
+BasicRowView<const T> BasicMatrix<T>::row(const int &y) const {
+    return BasicRowView<const T>(data + index(0, y), width);
 }
 
-void Matrix::set_row(const int &y, std::vector<double> values) {
-    if (values.size() != width) {
-        throw std::domain_error("not right number of new values given");
-    }
-    for (int x = 0; x < width; ++x) {
-        data[index(x, y)] = values[x];
-    }
+template<typename T>
+BasicColumnView<T> BasicMatrix<T>::column(const int &x) {
+    return BasicColumnView<T>(data + index(x, 0), height, width);
+}
+
+template<typename T>
+BasicColumnView<const T> BasicMatrix<T>::column(const int &x) const {
+    return BasicColumnView<const T>(data + index(x, 0), height, width);
 }
 
-void Matrix::set_column(const int &x, std::vector<double> values) {
-    if (values.size() != height) {
-        throw std::domain_error("not right number of new values given");
+template<typename T>
+BasicBlockView<T> BasicMatrix<T>::block(const int &x, const int &y, const int &block_width, const int &block_height) {
+    if (block_width < 0 || block_height < 0 || x + block_width > width || y + block_height > height) {
+        throw std::out_of_range("trying to access matrix block that does not exit!");
     }
-    for (int y = 0; y < height; ++y) {
-        data[index(x, y)] = values[y];
+    return BasicBlockView<T>(data + x + static_cast<size_t>(width) * y, block_width, block_height, width);
+}
+
+template<typename T>
+BasicBlockView<const T>
+BasicMatrix<T>::block(const int &x, const int &y, const int &block_width, const int &block_height) const {
+    if (block_width < 0 || block_height < 0 || x + block_width > width || y + block_height > height) {
+        throw std::out_of_range("trying to access matrix block that does not exit!");
     }
+    return BasicBlockView<const T>(data + x + static_cast<size_t>(width) * y, block_width, block_height, width);
+}
+
+template<typename T>
+std::vector<T> BasicMatrix<T>::get_row(const int &y) const {
+    return row(y).to_vector();
+}
+
+template<typename T>
+std::vector<T> BasicMatrix<T>::get_column(const int &x) const {
+    return column(x).to_vector();
 }
 
-bool Matrix::is_square() const {
+template<typename T>
+void BasicMatrix<T>::set_row(const int &y, const std::vector<T> &values) {
+    row(y).assign(values);
+}
+
+template<typename T>
+void BasicMatrix<T>::set_column(const int &x, const std::vector<T> &values) {
+    column(x).assign(values);
+}
+
+template<typename T>
+bool BasicMatrix<T>::is_square() const {
     return height == width;
 }
 
-Matrix Matrix::get_matrix_A() const {
-    Matrix matrix_A = Matrix(width - 1, height, false);
-    matrix_A.augmented = false;
-    for (int x = 0; x < width - 1; ++x) {
-        matrix_A.set_column(x, get_column(x));
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::get_matrix_A() const {
+    ScopedTimer timer(Phase::COPY);
+    BasicMatrix matrix_A(width - 1, height, false);
+    for (int y = 0; y < height; ++y) {
+        BasicRowView<const T> source = row(y);
+        std::copy(source.begin(), source.end() - 1, matrix_A.row(y).begin());
     }
+    Statistics::add(Counter::BYTES_COPIED, matrix_A.size() * sizeof(T));
     return matrix_A;
 }
 
-Matrix Matrix::get_transposition() const {
-    Matrix transposition = Matrix(height, width, augmented);
-    for (int y = 0; y < height; ++y) {
-        transposition.set_column(y, get_row(y));
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::get_transposition() const {
+    // transposes tile after tile, so both the read rows and the written rows stay in cache
+    const int tile = 32;
+    BasicMatrix transposition(height, width, augmented);
+    for (int y0 = 0; y0 < height; y0 += tile) {
+        for (int x0 = 0; x0 < width; x0 += tile) {
+            for (int y = y0; y < std::min(y0 + tile, height); ++y) {
+                for (int x = x0; x < std::min(x0 + tile, width); ++x) {
+                    transposition.field(y, x) = field(x, y);
+                }
+            }
+        }
     }
     return transposition;
 }
 
-std::ostream &operator<<(std::ostream &ostream, const Matrix &matrix) {
+template<typename T>
+std::ostream &operator<<(std::ostream &ostream, const BasicMatrix<T> &matrix) {
     ostream << "Matrix:" << std::endl;
     ostream << std::setprecision(2);
     for (int y = 0; y < matrix.height; ++y) {
@@ -135,57 +236,65 @@ std::ostream &operator<<(std::ostream &ostream, const Matrix &matrix) {
     return ostream;
 }
 
+std::ostream &operator<<(std::ostream &ostream, const std::vector<float> &vector) {
+    print_vector(ostream, vector);
+    return ostream;
+}
+
 std::ostream &operator<<(std::ostream &ostream, const std::vector<double> &vector) {
-    ostream << "Vector ( ";
-    for (auto n : vector) {
-        ostream << n << " ";
-    }
-    ostream << ")" << std::endl;
+    print_vector(ostream, vector);
+    return ostream;
+}
+
+std::ostream &operator<<(std::ostream &ostream, const std::vector<long double> &vector) {
+    print_vector(ostream, vector);
     return ostream;
 }
 
-Matrix operator*(const Matrix &A, const Matrix &B) {
+std::ostream &operator<<(std::ostream &ostream, const std::vector<std::complex<double>> &vector) {
+    print_vector(ostream, vector);
+    return ostream;
+}
+
+std::ostream &operator<<(std::ostream &ostream, const std::vector<int> &vector) {
+    print_vector(ostream, vector);
+    return ostream;
+}
+
+template<typename T>
+BasicMatrix<T> operator*(const BasicMatrix<T> &A, const BasicMatrix<T> &B) {
     if (A.width != B.height) {
         throw std::domain_error("matrices cannot be multiplied");
     }
-    Matrix result(B.width, A.height, false);
-    for (int i = 0; i < A.height; ++i) {
-        for (int j = 0; j < B.width; ++j) {
-            for (int k = 0; k < A.width; ++k) {
-                result.set_field(j, i, result.get_field(j, i) + A.get_field(k, i) * B.get_field(j, k));
-            }
-        }
-    }
+    BasicMatrix<T> result(B.width, A.height, false);
+    multiply(A, B, result);
     return result;
 }
 
-Matrix operator+(const Matrix &A, const Matrix &B) {
+template<typename T>
+BasicMatrix<T> operator+(const BasicMatrix<T> &A, const BasicMatrix<T> &B) {
     if (A.width != B.width || A.height != B.height) {
         throw std::domain_error("matrices cannot be summarized");
     }
-    Matrix result(A);
-    for (int y = 0; y < result.height; ++y) {
-        for (int x = 0; x < result.width; ++x) {
-            result.set_field(x, y, result.get_field(x, y) + B.get_field(x, y));
-        }
-    }
+    BasicMatrix<T> result(A);
+    std::transform(result.data, result.data + result.size(), B.data, result.data,
+                   std::plus<T>());
     return result;
 }
 
-Matrix operator-(const Matrix &A, const Matrix &B) {
+template<typename T>
+BasicMatrix<T> operator-(const BasicMatrix<T> &A, const BasicMatrix<T> &B) {
     if (A.width != B.width || A.height != B.height) {
         throw std::domain_error("matrices cannot be subtracted");
     }
-    Matrix result(A);
-    for (int y = 0; y < result.height; ++y) {
-        for (int x = 0; x < result.width; ++x) {
-            result.set_field(x, y, result.get_field(x, y) - B.get_field(x, y));
-        }
-    }
+    BasicMatrix<T> result(A);
+    std::transform(result.data, result.data + result.size(), B.data, result.data,
+                   std::minus<T>());
     return result;
 }
 
-Matrix MatrixCreator::parse_from_cmd_line(std::ostream &ostream, std::istream &istream) {
+template<typename T>
+BasicMatrix<T> BasicMatrixCreator<T>::parse_from_cmd_line(std::ostream &ostream, std::istream &istream) {
     int width;
     int height;
     ostream << "Enter width of the linear system matrix: ";
@@ -193,13 +302,19 @@ Matrix MatrixCreator::parse_from_cmd_line(std::ostream &ostream, std::istream &i
     ostream << "Enter height of the linear system matrix: ";
     istream >> height;
 
-    Matrix matrix(width, height, true);
+    BasicMatrix<T> matrix(width, height, true);
 
     for (int y = 0; y < height; ++y) {
         ostream << "Enter " << y + 1 << ". row of the matrix:" << std::endl;
         for (int x = 0; x < width; ++x) {
-            double d;
-            istream >> d;
+            // the values are read as tokens, so the complex ones can be written as in the txt files
+            std::string token;
+            istream >> token;
+            const char *position = token.data();
+            T d;
+            if (!TextMatrixParser::parse_number(position, token.data() + token.size(), d)) {
+                throw std::domain_error("Invalid number " + token + " entered.");
+            }
             matrix.set_field(x, y, d);
         }
     }
@@ -207,41 +322,55 @@ Matrix MatrixCreator::parse_from_cmd_line(std::ostream &ostream, std::istream &i
     return matrix;
 }
 
-Matrix MatrixCreator::parse_from_txt_file(std::ostream &ostream, std::istream &istream) {
+template<typename T>
+BasicMatrix<T> BasicMatrixCreator<T>::parse_from_txt_file(std::ostream &ostream, std::istream &istream) {
     ostream << "Choose file from shown below:" << std::endl;
-    std::ifstream file = FileReader::choose_file(ostream, istream);
-
-    std::string line;
-    std::getline(file, line);
-    std::stringstream line_stream;
-    line_stream << line;
-    int width, height;
-    line_stream >> width >> height;
-    if (!file || !line_stream) {
-        throw std::domain_error("Failed to load matrix from file.");
-    }
+    std::string path = FileReader::choose_file_path(ostream, istream);
+    return parse_from_txt_file(ostream, path);
+}
 
-    Matrix matrix(width, height, true);
+template<typename T>
+BasicMatrix<T> BasicMatrixCreator<T>::parse_from_txt_file(std::ostream &ostream, const std::string &path) {
+    ParseStats stats;
+    BasicMatrix<T> matrix = TextMatrixParser::parse_file_as<T>(path, stats);
+    ostream << "Parsed " << stats.bytes << " bytes in " << stats.microseconds / 1000 << " ms ("
+            << stats.get_throughput() << " MB/s)." << std::endl;
+    return matrix;
+}
 
-    for (int y = 0; y < height; ++y) {
-        std::getline(file, line);
-        line_stream << line;
-        for (int x = 0; x < width; ++x) {
-            double d;
-            line_stream >> d;
-            matrix.set_field(x, y, d);
-        }
-    }
+template<typename T>
+BasicMatrix<T> BasicMatrixCreator<T>::parse_from_txt_file(const std::string &path) {
+    ParseStats stats;
+    return TextMatrixParser::parse_file_as<T>(path, stats);
+}
 
-    return matrix;
+template<typename T>
+BasicMatrix<T> BasicMatrixCreator<T>::parse_from_txt_stream(std::istream &file) {
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return TextMatrixParser::parse_as<T>(text.data(), text.data() + text.size());
 }
 
-Matrix MatrixCreator::get_identity(const int &dimension) {
-    Matrix identity(dimension, dimension, false);
+template<typename T>
+BasicMatrix<T> BasicMatrixCreator<T>::get_identity(const int &dimension) {
+    BasicMatrix<T> identity(dimension, dimension, false);
     for (int i = 0; i < dimension; ++i) {
-        std::vector<double> e(dimension, 0.0);
-        e[i] = 1;
-        identity.set_column(i, e);
+        identity.field(i, i) = 1;
     }
     return identity;
 }
+
+#define LSS_INSTANTIATE_MATRIX(T) \
+    template struct BasicMatrix<T>; \
+    template class BasicMatrixCreator<T>; \
+    template BasicMatrix<T> operator*(const BasicMatrix<T> &A, const BasicMatrix<T> &B); \
+    template BasicMatrix<T> operator+(const BasicMatrix<T> &A, const BasicMatrix<T> &B); \
+    template BasicMatrix<T> operator-(const BasicMatrix<T> &A, const BasicMatrix<T> &B); \
+    template std::ostream &operator<<(std::ostream &ostream, const BasicMatrix<T> &matrix);
+
+LSS_INSTANTIATE_MATRIX(float)
+
+LSS_INSTANTIATE_MATRIX(double)
+
+LSS_INSTANTIATE_MATRIX(long double)
+
+LSS_INSTANTIATE_MATRIX(std::complex<double>)
@@ -5,21 +5,37 @@
 #ifndef LINEAR_SYSTEM_SOLVER_MATRIX_HPP
 #define LINEAR_SYSTEM_SOLVER_MATRIX_HPP
 
+#include <complex>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "utils.hpp"
+#include "matrix_view.hpp"
+#include "scalar_type.hpp"
 
 /**
  * Struct representing matrix.
  * <p>
  * If augmented is set to true, than the matrix represents system of linear equations.
+ * Elements are stored row after row in buffer aligned to BUFFER_ALIGNMENT, the buffers are recycled by BufferPool.
+ * Matrix can also wrap external buffer (e.g. memory mapped file), which is then kept alive by the storage.
+ * Instantiated for float, double, long double and std::complex<double>, Matrix is the double one.
+ *
+ * @tparam T type of the elements
  */
-struct Matrix {
+template<typename T>
+struct BasicMatrix {
+    typedef T value_type;
+
     int width;
     int height;
-    double *data{};
+    T *data{};
     bool augmented;
+    /**
+     * Owner of the external buffer the data point into, nullptr if the buffer comes from BufferPool.
+     */
+    std::shared_ptr<void> storage;
 
     /**
      * @param x index of the column
@@ -28,6 +44,13 @@ struct Matrix {
      */
     size_t index(const int &x, const int &y) const;
 
+    /**
+     * @return number of elements in the matrix
+     */
+    size_t size() const {
+        return static_cast<size_t>(width) * height;
+    }
+
     /**
      * Matrix constructor.
      *
@@ -35,26 +58,37 @@ struct Matrix {
      * @param height dimension of vectors in the matrix
      * @param augmented true if the matrix is augmented (last column is vector b), false otherwise
      */
-    Matrix(const int &width, const int &height, const bool &augmented);
+    BasicMatrix(const int &width, const int &height, const bool &augmented);
+
+    /**
+     * Wraps the external buffer without copying it. Copies of the matrix get their own buffer from BufferPool.
+     *
+     * @param width number of vectors in the matrix
+     * @param height dimension of vectors in the matrix
+     * @param augmented true if the matrix is augmented (last column is vector b), false otherwise
+     * @param data buffer with width * height elements stored row after row
+     * @param storage owner of the buffer, kept alive as long as the matrix
+     */
+    BasicMatrix(const int &width, const int &height, const bool &augmented, T *data, std::shared_ptr<void> storage);
 
     /**
      * Matrix destructor.
      */
-    virtual ~Matrix();
+    virtual ~BasicMatrix();
 
     /**
      * Copy constructor.
      *
      * @param rhs matrix to copy from
      */
-    Matrix(const Matrix &rhs);
+    BasicMatrix(const BasicMatrix &rhs);
 
     /**
-     * Move constructor.
+     * Move constructor. Takes over the buffer of the given matrix, which is left empty (size 0 * 0).
      *
      * @param rhs matrix to move from
      */
-    Matrix(Matrix &&rhs) noexcept;
+    BasicMatrix(BasicMatrix &&rhs) noexcept;
 
     /**
      * Copy assignment.
@@ -62,7 +96,7 @@ struct Matrix {
      * @param rhs matrix to copy from
      * @return reference to this
      */
-    Matrix &operator=(const Matrix &rhs);
+    BasicMatrix &operator=(const BasicMatrix &rhs);
 
     /**
      * Move assignment.
@@ -70,58 +104,122 @@ struct Matrix {
      * @param rhs matrix to move from
      * @return reference to this
      */
-    Matrix &operator=(Matrix &&rhs) noexcept;
+    BasicMatrix &operator=(BasicMatrix &&rhs) noexcept;
 
     /**
      * Swaps contents of the two matrices.
      *
      * @param rhs
      */
-    void swap(Matrix &rhs);
+    void swap(BasicMatrix &rhs);
 
     /**
      * @param x index of the column in which the field is (zero based)
      * @param y index of the row in which the field is (zero based)
      * @return element on [x,y] coords in the matrix
      */
-    double get_field(const int &x, const int &y) const;
+    T get_field(const int &x, const int &y) const;
 
     /**
      * Sets value of element on [x,y] coords in the matrix.
      *
      * @param x index of the column in which the field is (zero based)
      * @param y index of the row in which the field is (zero based)
-     * @param value double to be inserted into the matrix
+     * @param value element to be inserted into the matrix
+     */
+    void set_field(const int &x, const int &y, T value);
+
+    /**
+     * Unchecked access to the element for hot loops, the coords are not validated.
+     *
+     * @param x index of the column in which the field is (zero based)
+     * @param y index of the row in which the field is (zero based)
+     * @return reference to element on [x,y] coords in the matrix
+     */
+    T &field(const int &x, const int &y) {
+        return data[x + static_cast<size_t>(width) * y];
+    }
+
+    /**
+     * Unchecked read only access to the element for hot loops, the coords are not validated.
+     *
+     * @param x index of the column in which the field is (zero based)
+     * @param y index of the row in which the field is (zero based)
+     * @return reference to element on [x,y] coords in the matrix
+     */
+    const T &field(const int &x, const int &y) const {
+        return data[x + static_cast<size_t>(width) * y];
+    }
+
+    /**
+     * @param y index of the row (zero based)
+     * @return view of the y-th row pointing into the matrix data
+     */
+    BasicRowView<T> row(const int &y);
+
+    /**
+     * @param y index of the row (zero based)
+     * @return read only view of the y-th row pointing into the matrix data
+     */
+    BasicRowView<const T> row(const int &y) const;
+
+    /**
+     * @param x index of the column (zero based)
+     * @return view of the x-th column pointing into the matrix data
+     */
+    BasicColumnView<T> column(const int &x);
+
+    /**
+     * @param x index of the column (zero based)
+     * @return read only view of the x-th column pointing into the matrix data
+     */
+    BasicColumnView<const T> column(const int &x) const;
+
+    /**
+     * @param x index of the left column of the block (zero based)
+     * @param y index of the top row of the block (zero based)
+     * @param block_width number of columns in the block
+     * @param block_height number of rows in the block
+     * @return view of the block pointing into the matrix data
      */
-    void set_field(const int &x, const int &y, double value);
+    BasicBlockView<T> block(const int &x, const int &y, const int &block_width, const int &block_height);
+
+    /**
+     * @param x index of the left column of the block (zero based)
+     * @param y index of the top row of the block (zero based)
+     * @param block_width number of columns in the block
+     * @param block_height number of rows in the block
+     * @return read only view of the block pointing into the matrix data
+     */
+    BasicBlockView<const T> block(const int &x, const int &y, const int &block_width, const int &block_height) const;
 
     /**
      * @param y index of the row to be returned (zero based)
      * @return y-th row of the matrix as vector of elements
      */
-    std::vector<double> get_row(const int &y) const;
+    std::vector<T> get_row(const int &y) const;
 
     /**
      * Sets y-th row of the matrix to be given vector of values.
      *
      * @param y index of the row to be set (zero based)
-     * @param values vector of doubles to be inserted in the given column
+     * @param values vector of elements to be inserted in the given column
      */
-    void set_row(const int &y, std::vector<double> values);
+    void set_row(const int &y, const std::vector<T> &values);
 
     /**
      * @param x index of the column to be returned (zero based)
      * @return x-th column of the matrix as vector of elements
      */
-    std::vector<double> get_column(const int &x) const;
+    std::vector<T> get_column(const int &x) const;
 
     /**
      * Sets x-th column of the matrix to be given vector of values.
      *
      * @param x index of the column to be set (zero based)
-     * @param values vector of doubles to be inserted in the given column
+     * @param values vector of elements to be inserted in the given column
      */
-    void set_column(const int &x, std::vector<double> values);
+    void set_column(const int &x, const std::vector<T> &values);
 
     /**
      * Checks if the matrix is square (size n * n).
@@ -134,45 +232,66 @@ struct Matrix {
      * Copies the matrix and removes the vector b from the copy. The modified copy is returned.
      * @return Matrix matrix A from the augmented linear matrix
      */
-    Matrix get_matrix_A() const;
+    BasicMatrix get_matrix_A() const;
 
     /**
      * Copies the matrix and transposes it. The modified copy is returned.
      *
      * @return Matrix transposition of the matrix
      */
-    Matrix get_transposition() const;
+    BasicMatrix get_transposition() const;
 
     /**
      * Executes modifying lambda function for each field of the matrix.
      *
-     * @tparam T
+     * @tparam F
      * @param lambda function
      */
-    template<typename T>
-    void foreach_field(T &&lambda) {
+    template<typename F>
+    void foreach_field(F &&lambda) {
         for (int y = 0; y < height; ++y) {
             for (int x = 0; x < width; ++x) {
-                set_field(x, y, lambda(x, y, get_field(x, y)));
+                field(x, y) = lambda(x, y, field(x, y));
             }
         }
     };
 };
 
-Matrix operator*(const Matrix &A, const Matrix &B);
+using Matrix = BasicMatrix<double>;
+
+/**
+ * Multiplies the matrices, double matrices are multiplied by GemmEngine.
+ */
+template<typename T>
+BasicMatrix<T> operator*(const BasicMatrix<T> &A, const BasicMatrix<T> &B);
 
-Matrix operator+(const Matrix &A, const Matrix &B);
+template<typename T>
+BasicMatrix<T> operator+(const BasicMatrix<T> &A, const BasicMatrix<T> &B);
 
-Matrix operator-(const Matrix &A, const Matrix &B);
+template<typename T>
+BasicMatrix<T> operator-(const BasicMatrix<T> &A, const BasicMatrix<T> &B);
 
-std::ostream &operator<<(std::ostream &ostream, const Matrix &matrix);
+template<typename T>
+std::ostream &operator<<(std::ostream &ostream, const BasicMatrix<T> &matrix);
+
+std::ostream &operator<<(std::ostream &ostream, const std::vector<float> &vector);
 
 std::ostream &operator<<(std::ostream &ostream, const std::vector<double> &vector);
 
+std::ostream &operator<<(std::ostream &ostream, const std::vector<long double> &vector);
+
+std::ostream &operator<<(std::ostream &ostream, const std::vector<std::complex<double>> &vector);
+
+std::ostream &operator<<(std::ostream &ostream, const std::vector<int> &vector);
+
 /**
- * Class responsible for creating the matrix structs.
+ * Class responsible for creating the matrix structs. Instantiated for the same types as BasicMatrix,
+ * MatrixCreator creates the double matrices.
+ *
+ * @tparam T type of the elements
  */
-class MatrixCreator {
+template<typename T>
+class BasicMatrixCreator {
 public:
     /**
      * Parses matrix from command line. Provides basic user communication.
@@ -181,7 +300,7 @@ public:
      * @param istream input stream to read from
      * @return Matrix read from input stream
      */
-    static Matrix parse_from_cmd_line(std::ostream &ostream, std::istream &istream);
+    static BasicMatrix<T> parse_from_cmd_line(std::ostream &ostream, std::istream &istream);
 
     /**
      * Parses matrix from txt file. Provides also the file choose.
@@ -190,7 +309,32 @@ public:
      * @param istream input stream to read from
      * @return Matrix read from input stream
      */
-    static Matrix parse_from_txt_file(std::ostream &ostream, std::istream &istream);
+    static BasicMatrix<T> parse_from_txt_file(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Parses matrix from txt file on the given path and reports the throughput of the parsing.
+     *
+     * @param ostream output stream to write information to
+     * @param path path to the file
+     * @return Matrix read from the file
+     */
+    static BasicMatrix<T> parse_from_txt_file(std::ostream &ostream, const std::string &path);
+
+    /**
+     * Parses matrix from txt file on the given path, without any user communication.
+     *
+     * @param path path to the file
+     * @return Matrix read from the file
+     */
+    static BasicMatrix<T> parse_from_txt_file(const std::string &path);
+
+    /**
+     * Parses matrix from stream with the txt file format. (width and height on the first line, one row per line)
+     *
+     * @param file input stream to read from
+     * @return Matrix read from the stream
+     */
+    static BasicMatrix<T> parse_from_txt_stream(std::istream &file);
 
     /**
      * Creates identity matrix with given dimension n. (size n * n; 1 in fields on diagonal, 0 in all other fields)
@@ -198,7 +342,9 @@ public:
      * @param dimension size of the returned matrix
      * @return Matrix of identity
      */
-    static Matrix get_identity(const int &dimension);
+    static BasicMatrix<T> get_identity(const int &dimension);
 };
 
+using MatrixCreator = BasicMatrixCreator<double>;
+
 #endif //LINEAR_SYSTEM_SOLVER_MATRIX_HPP
@@ -0,0 +1,211 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_MATRIX_VIEW_HPP
+#define LINEAR_SYSTEM_SOLVER_MATRIX_VIEW_HPP
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * View of one row of the matrix. Points directly into the matrix data, so it does not own any memory
+ * and it is valid only as long as the viewed matrix.
+ *
+ * @tparam T type of the elements for mutable view, const type of the elements for read only view
+ */
+template<typename T>
+class BasicRowView {
+private:
+    T *first;
+    int length;
+
+public:
+    /**
+     * @param first pointer to the first element of the row
+     * @param length number of elements in the row
+     */
+    BasicRowView(T *first, int length) : first(first), length(length) {}
+
+    /**
+     * Mutable view can be converted to read only view.
+     */
+    template<typename U>
+    BasicRowView(const BasicRowView<U> &rhs) : first(rhs.begin()), length(rhs.size()) {}
+
+    /**
+     * @param x index of the element in the row (zero based), it is not checked
+     * @return reference to the element
+     */
+    T &operator[](const int &x) const { return first[x]; }
+
+    int size() const { return length; }
+
+    T *begin() const { return first; }
+
+    T *end() const { return first + length; }
+
+    /**
+     * @return copy of the viewed elements
+     */
+    std::vector<typename std::remove_const<T>::type> to_vector() const {
+        return std::vector<typename std::remove_const<T>::type>(begin(), end());
+    }
+
+    /**
+     * Copies the given values into the viewed row.
+     *
+     * @param values container with size() equal to size of the row
+     */
+    template<typename V>
+    void assign(const V &values) const {
+        if (static_cast<int>(values.size()) != length) {
+            throw std::domain_error("not right number of new values given");
+        }
+        std::copy(values.begin(), values.end(), first);
+    }
+
+    /**
+     * Swaps elements of this row with elements of the other row of the same size.
+     *
+     * @param rhs row to swap the elements with
+     */
+    void swap_elements(const BasicRowView &rhs) const {
+        std::swap_ranges(first, first + length, rhs.first);
+    }
+};
+
+/**
+ * View of one column of the matrix. Elements of the column are stride elements apart in the matrix data.
+ * Points directly into the matrix data, so it does not own any memory and it is valid only as long as the viewed matrix.
+ *
+ * @tparam T type of the elements for mutable view, const type of the elements for read only view
+ */
+template<typename T>
+class BasicColumnView {
+private:
+    T *first;
+    int length;
+    int stride;
+
+public:
+    /**
+     * @param first pointer to the first element of the column
+     * @param length number of elements in the column
+     * @param stride distance between two consecutive elements of the column
+     */
+    BasicColumnView(T *first, int length, int stride) : first(first), length(length), stride(stride) {}
+
+    /**
+     * Mutable view can be converted to read only view.
+     */
+    template<typename U>
+    BasicColumnView(const BasicColumnView<U> &rhs) :
+            first(&rhs[0]), length(rhs.size()), stride(rhs.get_stride()) {}
+
+    /**
+     * @param y index of the element in the column (zero based), it is not checked
+     * @return reference to the element
+     */
+    T &operator[](const int &y) const { return first[static_cast<size_t>(y) * stride]; }
+
+    int size() const { return length; }
+
+    int get_stride() const { return stride; }
+
+    /**
+     * @return copy of the viewed elements
+     */
+    std::vector<typename std::remove_const<T>::type> to_vector() const {
+        std::vector<typename std::remove_const<T>::type> values(length);
+        for (int y = 0; y < length; ++y) {
+            values[y] = (*this)[y];
+        }
+        return values;
+    }
+
+    /**
+     * Copies the given values into the viewed column.
+     *
+     * @param values container with size() equal to size of the column
+     */
+    template<typename V>
+    void assign(const V &values) const {
+        if (static_cast<int>(values.size()) != length) {
+            throw std::domain_error("not right number of new values given");
+        }
+        for (int y = 0; y < length; ++y) {
+            (*this)[y] = values[y];
+        }
+    }
+};
+
+/**
+ * View of the rectangular block of the matrix.
+ * Points directly into the matrix data, so it does not own any memory and it is valid only as long as the viewed matrix.
+ *
+ * @tparam T type of the elements for mutable view, const type of the elements for read only view
+ */
+template<typename T>
+class BasicBlockView {
+private:
+    T *first;
+    int width;
+    int height;
+    int stride;
+
+public:
+    /**
+     * @param first pointer to the top left element of the block
+     * @param width number of columns in the block
+     * @param height number of rows in the block
+     * @param stride distance between two consecutive rows of the block (width of the viewed matrix)
+     */
+    BasicBlockView(T *first, int width, int height, int stride) :
+            first(first), width(width), height(height), stride(stride) {}
+
+    /**
+     * Mutable view can be converted to read only view.
+     */
+    template<typename U>
+    BasicBlockView(const BasicBlockView<U> &rhs) :
+            first(rhs.data()), width(rhs.get_width()), height(rhs.get_height()), stride(rhs.get_stride()) {}
+
+    /**
+     * @param x index of the column in the block (zero based), it is not checked
+     * @param y index of the row in the block (zero based), it is not checked
+     * @return reference to the element
+     */
+    T &operator()(const int &x, const int &y) const { return first[static_cast<size_t>(y) * stride + x]; }
+
+    T *data() const { return first; }
+
+    int get_width() const { return width; }
+
+    int get_height() const { return height; }
+
+    int get_stride() const { return stride; }
+
+    /**
+     * @param y index of the row in the block (zero based), it is not checked
+     * @return view of the part of the row that lies in the block
+     */
+    BasicRowView<T> row(const int &y) const { return BasicRowView<T>(&(*this)(0, y), width); }
+
+    /**
+     * @param x index of the column in the block (zero based), it is not checked
+     * @return view of the part of the column that lies in the block
+     */
+    BasicColumnView<T> column(const int &x) const { return BasicColumnView<T>(&(*this)(x, 0), height, stride); }
+};
+
+using RowView = BasicRowView<double>;
+using ConstRowView = BasicRowView<const double>;
+using ColumnView = BasicColumnView<double>;
+using ConstColumnView = BasicColumnView<const double>;
+using BlockView = BasicBlockView<double>;
+using ConstBlockView = BasicBlockView<const double>;
+
+#endif //LINEAR_SYSTEM_SOLVER_MATRIX_VIEW_HPP
@@ -0,0 +1,140 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "mixed_precision_solver.hpp"
+#include "lu_decomposition.hpp"
+#include "system_solver.hpp"
+
+namespace {
+    /**
+     * Solves Ad = r in float precision with the factors of the regular matrix A, r and d are in double.
+     */
+    void solve_float(const BasicLUDecomposition<float> &lu, const std::vector<double> &r, std::vector<double> &d) {
+        const int n = lu.factors.height;
+        std::vector<float> y(n);
+        for (int i = 0; i < n; ++i) {
+            y[i] = static_cast<float>(r[lu.permutation[i]]);
+        }
+        for (int i = 1; i < n; ++i) {
+            const float *row = lu.factors.data + static_cast<size_t>(n) * i;
+            float sum = y[i];
+            for (int k = 0; k < i; ++k) {
+                sum -= row[k] * y[k];
+            }
+            y[i] = sum;
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            const float *row = lu.factors.data + static_cast<size_t>(n) * i;
+            float sum = y[i];
+            for (int k = i + 1; k < n; ++k) {
+                sum -= row[k] * y[k];
+            }
+            y[i] = sum / row[i];
+        }
+        d.assign(y.begin(), y.end());
+    }
+
+    /**
+     * Computes r = b - Ax in double precision, b is the last column of the augmented matrix.
+     */
+    void compute_residual(const Matrix &matrix, const std::vector<double> &x, std::vector<double> &r) {
+        const int n = matrix.height;
+        for (int i = 0; i < n; ++i) {
+            const double *row = &matrix.field(0, i);
+            double sum = row[n];
+            for (int k = 0; k < n; ++k) {
+                sum -= row[k] * x[k];
+            }
+            r[i] = sum;
+        }
+    }
+
+    double max_abs(const std::vector<double> &vector) {
+        double result = 0;
+        for (double e : vector) {
+            result = std::max(result, std::abs(e));
+        }
+        return result;
+    }
+
+    /**
+     * Solves the system with the double precision LU.
+     */
+    std::vector<double> solve_double(const Matrix &matrix, int thread_count) {
+        SolverContext context;
+        context.thread_count = thread_count;
+        Factorization factorization = SystemSolver::factor(matrix, context);
+        if (factorization.get_rank() < factorization.get_unknowns()) {
+            throw std::domain_error("matrix of the system is singular");
+        }
+        return factorization.solve(matrix.get_column(matrix.width - 1)).particular_solution;
+    }
+}
+
+bool MixedPrecisionSolver::is_supported(const Matrix &matrix) {
+    return matrix.augmented && matrix.width - 1 == matrix.height;
+}
+
+RefinementResult MixedPrecisionSolver::solve(const Matrix &matrix, int thread_count) {
+    if (!is_supported(matrix)) {
+        throw std::domain_error("mixed precision solver needs square matrix of the system");
+    }
+    const int n = matrix.height;
+    RefinementResult result{std::vector<double>(), 0, false};
+
+    BasicMatrix<float> matrix_A(n, n, false);
+    double norm_A = 0;
+    for (int y = 0; y < n; ++y) {
+        const double *row = &matrix.field(0, y);
+        double row_sum = 0;
+        for (int x = 0; x < n; ++x) {
+            matrix_A.field(x, y) = static_cast<float>(row[x]);
+            row_sum += std::abs(row[x]);
+        }
+        norm_A = std::max(norm_A, row_sum);
+    }
+    // the same decomposition as the double LU, blocked and threaded for the large matrices
+    const BasicLUDecomposition<float> factors = LUDecomposer::decompose(std::move(matrix_A), thread_count);
+
+    if (factors.rank() < n) {
+        // singular in float precision, it still can be regular in double
+        result.solution = solve_double(matrix, thread_count);
+        result.used_fallback = true;
+        return result;
+    }
+
+    std::vector<double> &x = result.solution;
+    std::vector<double> r(n);
+    std::vector<double> d(n);
+    solve_float(factors, matrix.get_column(n), x);
+
+    // the same stopping criterion as LAPACK dsgesv uses
+    const double threshold = norm_A * std::numeric_limits<double>::epsilon() * std::sqrt(static_cast<double>(n));
+    double last_correction = std::numeric_limits<double>::infinity();
+    while (true) {
+        compute_residual(matrix, x, r);
+        if (max_abs(r) <= max_abs(x) * threshold) {
+            return result;
+        }
+        if (result.refinement_steps == MAX_REFINEMENT_STEPS) break;
+
+        solve_float(factors, r, d);
+        double correction = max_abs(d);
+        if (correction > 0.5 * last_correction || !std::isfinite(correction)) break; // the refinement stalled
+        for (int i = 0; i < n; ++i) {
+            x[i] += d[i];
+        }
+        last_correction = correction;
+        result.refinement_steps++;
+    }
+
+    result.solution = solve_double(matrix, thread_count);
+    result.used_fallback = true;
+    return result;
+}
@@ -0,0 +1,61 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_MIXED_PRECISION_SOLVER_HPP
+#define LINEAR_SYSTEM_SOLVER_MIXED_PRECISION_SOLVER_HPP
+
+#include <vector>
+
+#include "matrix.hpp"
+
+/**
+ * Constant representing maximal number of refinement steps before falling back to double precision.
+ */
+#define MAX_REFINEMENT_STEPS 30
+
+/**
+ * Struct representing result of the mixed precision solver.
+ */
+struct RefinementResult {
+    std::vector<double> solution;
+    /**
+     * Number of refinement steps done on top of the float solution.
+     */
+    int refinement_steps;
+    /**
+     * True if the refinement stalled and the system was solved again in double precision.
+     */
+    bool used_fallback;
+};
+
+/**
+ * Class responsible for solving square regular systems with mixed precision LU and iterative refinement.
+ * <p>
+ * The matrix A is decomposed in float precision, which halves the memory traffic of the decomposition.
+ * The solution is then refined in double precision: residual r = b - Ax is computed in double, correction
+ * d is solved from Ad = r with the float factors and added to x. The refinement stops when the residual
+ * is on the level of the double round-off, it falls back to double precision LU when the corrections
+ * stop shrinking or the limit of MAX_REFINEMENT_STEPS is reached.
+ */
+class MixedPrecisionSolver {
+public:
+    /**
+     * Checks if the matrix can be solved by the mixed precision solver.
+     *
+     * @param matrix augmented matrix of the linear system
+     * @return true if the matrix A of the system is square
+     */
+    static bool is_supported(const Matrix &matrix);
+
+    /**
+     * Solves the given linear system.
+     *
+     * @param matrix augmented matrix of the square linear system
+     * @param thread_count number of threads used by the float decomposition and the double precision fallback
+     * @return RefinementResult with the solution, throws std::domain_error if A is singular
+     */
+    static RefinementResult solve(const Matrix &matrix, int thread_count = 1);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_MIXED_PRECISION_SOLVER_HPP
@@ -0,0 +1,344 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "number_formatter.hpp"
+
+namespace {
+    const uint64_t HIDDEN_BIT = 0x0010000000000000ULL;
+    const uint64_t SIGNIFICAND_MASK = 0x000FFFFFFFFFFFFFULL;
+    const int EXPONENT_BIAS = 1075;
+
+    const uint64_t POWERS_OF_10[] = {
+            1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+            1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+            100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+            1000000000000000000ULL, 10000000000000000000ULL
+    };
+
+    /**
+     * Normalized significands of 10^k for k = -348, -340, ..., 340 rounded to 64 bits.
+     */
+    const uint64_t CACHED_POWERS_SIGNIFICANDS[] = {
+            0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+            0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+            0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+            0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+            0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+            0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+            0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+            0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+            0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+            0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+            0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+            0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+            0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+            0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+            0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+            0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+            0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+            0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+            0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+            0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+            0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+            0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+            0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+            0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+            0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+            0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+            0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+            0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+            0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+    };
+
+    /**
+     * Binary exponents of CACHED_POWERS_SIGNIFICANDS.
+     */
+    const int16_t CACHED_POWERS_EXPONENTS[] = {
+            -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+            -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+            -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+            -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+            56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+            375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+            694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+            1013, 1039, 1066,
+    };
+
+    /**
+     * Number f * 2^e with 64-bit significand (do it yourself floating point).
+     */
+    struct DiyFp {
+        uint64_t f;
+        int e;
+
+        DiyFp(uint64_t f, int e) : f(f), e(e) {}
+
+        explicit DiyFp(double value) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            int biased_exponent = static_cast<int>((bits >> 52u) & 0x7FFu);
+            uint64_t significand = bits & SIGNIFICAND_MASK;
+            if (biased_exponent != 0) {
+                f = significand + HIDDEN_BIT;
+                e = biased_exponent - EXPONENT_BIAS;
+            } else {
+                f = significand;
+                e = 1 - EXPONENT_BIAS;
+            }
+        }
+
+        DiyFp operator-(const DiyFp &other) const {
+            return DiyFp(f - other.f, e);
+        }
+
+        /**
+         * Product rounded to the upper 64 bits.
+         */
+        DiyFp operator*(const DiyFp &other) const {
+            const uint64_t mask = 0xFFFFFFFFULL;
+            uint64_t a = f >> 32u, b = f & mask, c = other.f >> 32u, d = other.f & mask;
+            uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+            uint64_t middle = (bd >> 32u) + (ad & mask) + (bc & mask) + (1ULL << 31u);
+            return DiyFp(ac + (ad >> 32u) + (bc >> 32u) + (middle >> 32u), e + other.e + 64);
+        }
+
+        DiyFp normalize() const {
+            DiyFp result = *this;
+            while (!(result.f & (1ULL << 63u))) {
+                result.f <<= 1u;
+                result.e--;
+            }
+            return result;
+        }
+
+        /**
+         * Computes the boundaries m- and m+ halfway to the neighbouring doubles, both with the exponent of m+.
+         */
+        void get_boundaries(DiyFp &minus, DiyFp &plus) const {
+            plus = DiyFp((f << 1u) + 1, e - 1).normalize();
+            minus = f == HIDDEN_BIT ? DiyFp((f << 2u) - 1, e - 2) : DiyFp((f << 1u) - 1, e - 1);
+            minus.f <<= static_cast<unsigned>(minus.e - plus.e);
+            minus.e = plus.e;
+        }
+    };
+
+    /**
+     * @param e binary exponent of the normalized number
+     * @param k set to the decimal exponent, the product of the number and the power has exponent in [-60, -32]
+     * @return cached power 10^-k
+     */
+    DiyFp get_cached_power(int e, int &k) {
+        double dk = (-61 - e) * 0.30102999566398114 + 347;
+        int ceiling = static_cast<int>(dk);
+        if (dk - ceiling > 0.0) ceiling++;
+        unsigned index = static_cast<unsigned>((ceiling >> 3) + 1);
+        k = -(-348 + static_cast<int>(index << 3u));
+        return DiyFp(CACHED_POWERS_SIGNIFICANDS[index], CACHED_POWERS_EXPONENTS[index]);
+    }
+
+    /**
+     * Moves the last digit closer to the exact value while the number stays inside of the boundaries.
+     */
+    void round_weed(char *digits, int length, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t distance) {
+        while (rest < distance && delta - rest >= ten_kappa &&
+               (rest + ten_kappa < distance || distance - rest > rest + ten_kappa - distance)) {
+            digits[length - 1]--;
+            rest += ten_kappa;
+        }
+    }
+
+    int count_digits(uint32_t n) {
+        int count = 1;
+        while (n >= 10) {
+            n /= 10;
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * Generates the shortest digits of the number between the scaled boundaries.
+     */
+    void generate_digits(const DiyFp &w, const DiyFp &plus, uint64_t delta, char *digits, int &length, int &k) {
+        const DiyFp one(1ULL << static_cast<unsigned>(-plus.e), plus.e);
+        const uint64_t distance = (plus - w).f;
+        auto integral = static_cast<uint32_t>(plus.f >> static_cast<unsigned>(-one.e));
+        uint64_t fraction = plus.f & (one.f - 1);
+        int kappa = count_digits(integral);
+        length = 0;
+
+        while (kappa > 0) {
+            auto power = static_cast<uint32_t>(POWERS_OF_10[kappa - 1]);
+            uint32_t digit = integral / power;
+            integral %= power;
+            if (digit || length) {
+                digits[length++] = static_cast<char>('0' + digit);
+            }
+            kappa--;
+            uint64_t rest = (static_cast<uint64_t>(integral) << static_cast<unsigned>(-one.e)) + fraction;
+            if (rest <= delta) {
+                k += kappa;
+                round_weed(digits, length, delta, rest, POWERS_OF_10[kappa] << static_cast<unsigned>(-one.e),
+                           distance);
+                return;
+            }
+        }
+
+        while (true) {
+            fraction *= 10;
+            delta *= 10;
+            auto digit = static_cast<char>(fraction >> static_cast<unsigned>(-one.e));
+            if (digit || length) {
+                digits[length++] = static_cast<char>('0' + digit);
+            }
+            fraction &= one.f - 1;
+            kappa--;
+            if (fraction < delta) {
+                k += kappa;
+                int index = -kappa;
+                round_weed(digits, length, delta, fraction, one.f, index < 20 ? distance * POWERS_OF_10[index] : 0);
+                return;
+            }
+        }
+    }
+
+    /**
+     * Writes the exponent of the exponential form with sign and at least two digits.
+     */
+    int write_exponent(int exponent, char *buffer) {
+        int length = 0;
+        buffer[length++] = 'e';
+        buffer[length++] = exponent < 0 ? '-' : '+';
+        exponent = std::abs(exponent);
+        if (exponent >= 100) {
+            buffer[length++] = static_cast<char>('0' + exponent / 100);
+            exponent %= 100;
+        }
+        buffer[length++] = static_cast<char>('0' + exponent / 10);
+        buffer[length++] = static_cast<char>('0' + exponent % 10);
+        return length;
+    }
+}
+
+int NumberFormatter::format(double value, char *buffer) {
+    if (std::isnan(value)) {
+        std::memcpy(buffer, "nan", 3);
+        return 3;
+    }
+    int length = 0;
+    if (std::signbit(value)) {
+        buffer[length++] = '-';
+        value = -value;
+    }
+    if (std::isinf(value)) {
+        std::memcpy(buffer + length, "inf", 3);
+        return length + 3;
+    }
+
+    // integers are common in the inputs and the solutions, all integers under 10^15 are exact in double
+    if (value < 1e15 && value == std::trunc(value)) {
+        char digits[NUMBER_BUFFER_SIZE];
+        int count = 0;
+        auto integer = static_cast<long long>(value);
+        do {
+            digits[count++] = static_cast<char>('0' + integer % 10);
+            integer /= 10;
+        } while (integer > 0);
+        while (count > 0) {
+            buffer[length++] = digits[--count];
+        }
+        return length;
+    }
+
+    // value = digits * 10^k
+    char digits[NUMBER_BUFFER_SIZE];
+    int count = 0;
+    int k = 0;
+    const DiyFp v(value);
+    DiyFp minus(0, 0), plus(0, 0);
+    v.get_boundaries(minus, plus);
+    const DiyFp cached = get_cached_power(plus.e, k);
+    const DiyFp w = v.normalize() * cached;
+    DiyFp scaled_plus = plus * cached;
+    DiyFp scaled_minus = minus * cached;
+    scaled_minus.f++;
+    scaled_plus.f--;
+    generate_digits(w, scaled_plus, scaled_plus.f - scaled_minus.f, digits, count, k);
+
+    // position of the decimal point counted from the first digit
+    const int point = count + k;
+    if (point > 0 && point <= 17) {
+        if (k >= 0) {
+            std::memcpy(buffer + length, digits, count);
+            std::memset(buffer + length + count, '0', k);
+            return length + point;
+        }
+        std::memcpy(buffer + length, digits, point);
+        buffer[length + point] = '.';
+        std::memcpy(buffer + length + point + 1, digits + point, count - point);
+        return length + count + 1;
+    }
+    if (point > -5 && point <= 0) {
+        buffer[length++] = '0';
+        buffer[length++] = '.';
+        std::memset(buffer + length, '0', -point);
+        length -= point;
+        std::memcpy(buffer + length, digits, count);
+        return length + count;
+    }
+    buffer[length++] = digits[0];
+    if (count > 1) {
+        buffer[length++] = '.';
+        std::memcpy(buffer + length, digits + 1, count - 1);
+        length += count - 1;
+    }
+    return length + write_exponent(point - 1, buffer + length);
+}
+
+BufferedWriter::BufferedWriter(std::ostream &ostream) : ostream(ostream), buffer(OUTPUT_BUFFER_SIZE), used(0) {}
+
+BufferedWriter::~BufferedWriter() {
+    flush();
+}
+
+void BufferedWriter::write(const char *data, size_t size) {
+    if (used + size > buffer.size()) {
+        flush();
+        if (size > buffer.size()) {
+            ostream.write(data, size);
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+}
+
+void BufferedWriter::write(const std::string &text) {
+    write(text.data(), text.size());
+}
+
+void BufferedWriter::write(char character) {
+    if (used == buffer.size()) {
+        flush();
+    }
+    buffer[used++] = character;
+}
+
+void BufferedWriter::write(double value) {
+    if (used + NUMBER_BUFFER_SIZE > buffer.size()) {
+        flush();
+    }
+    used += NumberFormatter::format(value, buffer.data() + used);
+}
+
+void BufferedWriter::flush() {
+    if (used > 0) {
+        ostream.write(buffer.data(), used);
+        used = 0;
+    }
+}
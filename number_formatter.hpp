@@ -0,0 +1,79 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_NUMBER_FORMATTER_HPP
+#define LINEAR_SYSTEM_SOLVER_NUMBER_FORMATTER_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Constant representing size of the buffer of BufferedWriter in bytes.
+ */
+#define OUTPUT_BUFFER_SIZE 65536
+
+/**
+ * Constant representing size of the buffer NumberFormatter writes one number to, it fits 17 significant digits,
+ * the sign, the decimal point with the leading zeros and the exponent.
+ */
+#define NUMBER_BUFFER_SIZE 32
+
+/**
+ * Class responsible for converting the numbers to text.
+ */
+class NumberFormatter {
+public:
+    /**
+     * Writes short decimal number that reads back as the same double, it is the shortest one for all but
+     * about 0.2 % of the numbers, which get one digit more.
+     * <p>
+     * The digits are generated by the Grisu2 algorithm with 64-bit integer arithmetic only, integers under 10^15
+     * are written directly. Numbers with decimal exponent from -5 to 16 are written without the exponent,
+     * the others as d.ddde+XX, so strtod and the txt parser read all of them.
+     *
+     * @param value number to be written
+     * @param buffer buffer with at least NUMBER_BUFFER_SIZE bytes, the text is not terminated by zero
+     * @return number of written characters
+     */
+    static int format(double value, char *buffer);
+};
+
+/**
+ * Class responsible for collecting small writes to the buffer and passing it to the output stream at once.
+ * The rest of the buffer is written in the destructor.
+ */
+class BufferedWriter {
+private:
+    std::ostream &ostream;
+    std::vector<char> buffer;
+    size_t used;
+
+public:
+    explicit BufferedWriter(std::ostream &ostream);
+
+    BufferedWriter(const BufferedWriter &) = delete;
+
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    ~BufferedWriter();
+
+    void write(const char *data, size_t size);
+
+    void write(const std::string &text);
+
+    void write(char character);
+
+    /**
+     * Writes the number formatted by NumberFormatter.
+     */
+    void write(double value);
+
+    /**
+     * Writes the buffer to the output stream.
+     */
+    void flush();
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_NUMBER_FORMATTER_HPP
@@ -0,0 +1,299 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "out_of_core.hpp"
+#include "binary_format.hpp"
+#include "lu_decomposition.hpp"
+#include "gemm.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+
+namespace {
+    /**
+     * Scratch file with the tiles of the matrix, the file is removed in the destructor.
+     * Panel is tile column of tile_rows tiles, stored as row-major matrix with tile_size columns.
+     */
+    class TileFile {
+    private:
+        std::string path;
+        int descriptor;
+        size_t panel_size; // number of elements of one panel
+        size_t tile_elements;
+        std::atomic<size_t> bytes_read{0};
+        std::atomic<size_t> bytes_written{0};
+
+        size_t get_offset(int panel, int first_tile) const {
+            return (panel * panel_size + first_tile * tile_elements) * sizeof(double);
+        }
+
+    public:
+        TileFile(const std::string &path, int tile_size, int tile_rows) :
+                path(path), panel_size(static_cast<size_t>(tile_rows) * tile_size * tile_size),
+                tile_elements(static_cast<size_t>(tile_size) * tile_size) {
+            descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+            if (descriptor < 0) {
+                throw std::domain_error("Failed to create scratch file " + path + ".");
+            }
+        }
+
+        TileFile(const TileFile &) = delete;
+
+        TileFile &operator=(const TileFile &) = delete;
+
+        ~TileFile() {
+            close(descriptor);
+            unlink(path.c_str());
+        }
+
+        /**
+         * Reads tiles first_tile to first_tile + tile_count - 1 of the panel to the buffer.
+         */
+        void read(int panel, int first_tile, int tile_count, double *buffer) {
+            auto *bytes = reinterpret_cast<char *>(buffer);
+            size_t remaining = tile_count * tile_elements * sizeof(double);
+            auto offset = static_cast<off_t>(get_offset(panel, first_tile));
+            while (remaining > 0) {
+                ssize_t done = pread(descriptor, bytes, remaining, offset);
+                if (done <= 0) {
+                    throw std::domain_error("Failed to read scratch file " + path + ".");
+                }
+                bytes += done;
+                offset += done;
+                remaining -= done;
+            }
+            bytes_read += tile_count * tile_elements * sizeof(double);
+        }
+
+        /**
+         * Writes tiles first_tile to first_tile + tile_count - 1 of the panel from the buffer.
+         */
+        void write(int panel, int first_tile, int tile_count, const double *buffer) {
+            auto *bytes = reinterpret_cast<const char *>(buffer);
+            size_t remaining = tile_count * tile_elements * sizeof(double);
+            auto offset = static_cast<off_t>(get_offset(panel, first_tile));
+            while (remaining > 0) {
+                ssize_t done = pwrite(descriptor, bytes, remaining, offset);
+                if (done <= 0) {
+                    throw std::domain_error("Failed to write scratch file " + path + ".");
+                }
+                bytes += done;
+                offset += done;
+                remaining -= done;
+            }
+            bytes_written += tile_count * tile_elements * sizeof(double);
+        }
+
+        size_t get_bytes_read() const {
+            return bytes_read;
+        }
+
+        size_t get_bytes_written() const {
+            return bytes_written;
+        }
+    };
+
+    /**
+     * Converts permutation produced by the decomposition (original index of the k-th row is permutation[k])
+     * to the sequence of swaps, k-th row is swapped with row swaps[k] in the order of k.
+     */
+    std::vector<int> permutation_to_swaps(const std::vector<int> &permutation) {
+        const int count = static_cast<int>(permutation.size());
+        std::vector<int> current(count); // original index of the row currently on the position
+        std::vector<int> position(count); // current position of the original row
+        for (int i = 0; i < count; ++i) {
+            current[i] = i;
+            position[i] = i;
+        }
+        std::vector<int> swaps(count);
+        for (int i = 0; i < count; ++i) {
+            int p = position[permutation[i]];
+            swaps[i] = p;
+            std::swap(current[i], current[p]);
+            position[current[i]] = i;
+            position[current[p]] = p;
+        }
+        return swaps;
+    }
+}
+
+int OutOfCoreSolver::get_tile_size(int unknowns, size_t memory_budget) {
+    // one panel has about unknowns * tile_size elements
+    size_t panel_budget = memory_budget / OUT_OF_CORE_PANELS_IN_MEMORY / sizeof(double);
+    auto tile_size = static_cast<int>(std::min<size_t>(panel_budget / std::max(unknowns, 1), OUT_OF_CORE_MAX_TILE));
+    tile_size = std::min(tile_size, std::max(unknowns, OUT_OF_CORE_MIN_TILE));
+    while (tile_size >= OUT_OF_CORE_MIN_TILE) {
+        size_t tile_rows = (unknowns + tile_size - 1) / tile_size;
+        if (OUT_OF_CORE_PANELS_IN_MEMORY * tile_rows * tile_size * tile_size * sizeof(double) <= memory_budget) {
+            return tile_size;
+        }
+        tile_size--;
+    }
+    throw std::domain_error("Memory budget is too small for the out-of-core solver.");
+}
+
+OutOfCoreResult OutOfCoreSolver::solve(const std::string &binary_path, const OutOfCoreSettings &settings) {
+    BinaryHeader header = BinaryMatrixFile::read_header(binary_path);
+    if (header.storage != StorageType::DENSE || header.scalar_type != ScalarType::FLOAT64 || header.augmented == 0
+        || header.width != header.height + 1) {
+        throw std::domain_error("Out-of-core solver needs dense binary file of doubles with square augmented matrix.");
+    }
+    const int n = static_cast<int>(header.height);
+    const int nb = get_tile_size(n, settings.memory_budget);
+    const int tile_rows = (n + nb - 1) / nb;
+    const int tile_columns = (n + 1 + nb - 1) / nb; // the last column is vector b
+    const size_t panel_size = static_cast<size_t>(tile_rows) * nb * nb;
+    const std::string scratch_path = settings.scratch_path.empty() ? binary_path + ".tiles" : settings.scratch_path;
+
+    TileFile tiles(scratch_path, nb, tile_rows);
+    std::vector<double> panel(panel_size);
+    std::vector<double> factors(panel_size);
+    std::vector<double> prefetched(panel_size);
+
+    // copy the matrix to the tiles, the binary file is only mapped so it does not take the memory
+    double max_abs = 0;
+    {
+        MappedFile file(binary_path);
+        const auto *data = reinterpret_cast<const double *>(file.get_data() + sizeof(BinaryHeader));
+        for (int k = 0; k < tile_columns; ++k) {
+            int first_column = k * nb;
+            int columns = std::min(nb, n + 1 - first_column);
+            std::fill(panel.begin(), panel.end(), 0.0);
+            for (int y = 0; y < n; ++y) {
+                const double *row = data + static_cast<size_t>(n + 1) * y + first_column;
+                std::copy(row, row + columns, panel.data() + static_cast<size_t>(nb) * y);
+                for (int x = 0; x < columns && first_column + x < n; ++x) {
+                    max_abs = std::max(max_abs, std::abs(row[x]));
+                }
+            }
+            tiles.write(k, 0, tile_rows, panel.data());
+        }
+    }
+    const double tolerance = (n + 1) * std::numeric_limits<double>::epsilon() * max_abs;
+
+    ThreadPool prefetcher(1);
+    std::vector<std::vector<int>> swaps(tile_rows);
+    std::vector<double> y(n);
+
+    // left-looking LU, panel k is updated by the factors of panels 0 to k - 1 and then factored
+    for (int k = 0; k < tile_columns; ++k) {
+        tiles.read(k, 0, tile_rows, panel.data());
+        const int sources = std::min(k, tile_rows);
+
+        std::future<void> next_read;
+        if (sources > 0) {
+            next_read = prefetcher.submit([&]() { tiles.read(0, 0, tile_rows, prefetched.data()); });
+        }
+        for (int j = 0; j < sources; ++j) {
+            next_read.get();
+            std::swap(factors, prefetched);
+            if (j + 1 < sources) {
+                // only the tiles from the diagonal down hold L of the panel
+                next_read = prefetcher.submit([&, j]() {
+                    tiles.read(j + 1, j + 1, tile_rows - j - 1,
+                               prefetched.data() + static_cast<size_t>(j + 1) * nb * nb);
+                });
+            }
+
+            // apply the row swaps of panel j
+            for (int i = 0; i < static_cast<int>(swaps[j].size()); ++i) {
+                int row = j * nb + i;
+                int other = j * nb + swaps[j][i];
+                if (row != other) {
+                    std::swap_ranges(panel.data() + static_cast<size_t>(nb) * row,
+                                     panel.data() + static_cast<size_t>(nb) * (row + 1),
+                                     panel.data() + static_cast<size_t>(nb) * other);
+                }
+            }
+
+            // U of the block row j: solve with the unit lower triangular diagonal block of L
+            const double *L = factors.data() + static_cast<size_t>(j) * nb * nb;
+            double *U = panel.data() + static_cast<size_t>(j) * nb * nb;
+            for (int r = 1; r < nb; ++r) {
+                for (int c = 0; c < r; ++c) {
+                    double multiplier = L[static_cast<size_t>(nb) * r + c];
+                    if (multiplier == 0) continue;
+                    for (int x = 0; x < nb; ++x) {
+                        U[static_cast<size_t>(nb) * r + x] -= multiplier * U[static_cast<size_t>(nb) * c + x];
+                    }
+                }
+            }
+
+            // rows below the block row: A -= L * U
+            int below = n - (j + 1) * nb;
+            if (below > 0) {
+                GemmEngine::multiply_add(below, nb, nb, -1.0, L + static_cast<size_t>(nb) * nb, nb, U, nb,
+                                         U + static_cast<size_t>(nb) * nb, nb);
+            }
+        }
+
+        if (k < tile_rows) {
+            // factor the rest of the panel with partial pivoting
+            int rows = n - k * nb;
+            int columns = std::min(nb, rows);
+            std::vector<int> permutation(rows);
+            for (int i = 0; i < rows; ++i) {
+                permutation[i] = i;
+            }
+            std::vector<int> pivots_columns;
+            LUDecomposer::decompose_in_place(panel.data() + static_cast<size_t>(k) * nb * nb, nb, rows, tolerance,
+                                             permutation, pivots_columns);
+            if (static_cast<int>(pivots_columns.size()) < columns || pivots_columns[columns - 1] != columns - 1) {
+                throw std::domain_error("Matrix of the system is singular, out-of-core solver needs regular matrix.");
+            }
+            swaps[k] = permutation_to_swaps(permutation);
+            swaps[k].resize(columns); // rows below the pivots are not moved by other swaps
+        }
+
+        if (k == n / nb) {
+            // the panel holds vector b, which is now L^-1 * P * b
+            for (int i = 0; i < n; ++i) {
+                y[i] = panel[static_cast<size_t>(nb) * i + n % nb];
+            }
+        }
+        tiles.write(k, 0, tile_rows, panel.data());
+    }
+
+    // back-substitution streams the panels of U from the last one, only tiles above the diagonal are read
+    std::vector<double> &x = y;
+    std::future<void> next_read = prefetcher.submit([&]() {
+        tiles.read(tile_rows - 1, 0, tile_rows, prefetched.data());
+    });
+    for (int k = tile_rows - 1; k >= 0; --k) {
+        next_read.get();
+        std::swap(factors, prefetched);
+        if (k > 0) {
+            next_read = prefetcher.submit([&, k]() { tiles.read(k - 1, 0, k, prefetched.data()); });
+        }
+
+        const double *U = factors.data();
+        int first = k * nb;
+        int columns = std::min(nb, n - first);
+        for (int c = columns - 1; c >= 0; --c) {
+            int row = first + c;
+            double value = x[row];
+            for (int i = c + 1; i < columns; ++i) {
+                value -= U[static_cast<size_t>(nb) * row + i] * x[first + i];
+            }
+            x[row] = value / U[static_cast<size_t>(nb) * row + c];
+        }
+        for (int row = 0; row < first; ++row) {
+            double value = 0;
+            for (int i = 0; i < columns; ++i) {
+                value += U[static_cast<size_t>(nb) * row + i] * x[first + i];
+            }
+            x[row] -= value;
+        }
+    }
+
+    return {x, nb, tile_rows, tile_columns, tiles.get_bytes_read(), tiles.get_bytes_written()};
+}
@@ -0,0 +1,87 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_OUT_OF_CORE_HPP
+#define LINEAR_SYSTEM_SOLVER_OUT_OF_CORE_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * Constant representing the largest tile size (number of rows and columns of one tile). Larger tiles
+ * lower the disk traffic, but the panel factorization without blocking then takes most of the time.
+ */
+#define OUT_OF_CORE_MAX_TILE 256
+
+/**
+ * Constant representing the smallest tile size, smaller tiles would make the disk traffic too large.
+ */
+#define OUT_OF_CORE_MIN_TILE 16
+
+/**
+ * Constant representing number of panels kept in the memory at once (the factored panel and two panels
+ * of the factors, one of them being read from the disk while the other one is applied).
+ */
+#define OUT_OF_CORE_PANELS_IN_MEMORY 3
+
+/**
+ * Struct representing settings of the out-of-core solver.
+ */
+struct OutOfCoreSettings {
+    /**
+     * Maximal number of bytes of the panel buffers, the vectors of size of the system are not counted.
+     */
+    size_t memory_budget = 1ULL << 30u;
+    /**
+     * Path to the file the tiles are stored in during the solve, the file is removed afterwards.
+     */
+    std::string scratch_path;
+};
+
+/**
+ * Struct representing result of the out-of-core solver.
+ */
+struct OutOfCoreResult {
+    std::vector<double> solution;
+    int tile_size;
+    int tile_rows;
+    int tile_columns;
+    size_t bytes_read;
+    size_t bytes_written;
+};
+
+/**
+ * Class responsible for solving dense systems larger than the memory.
+ * <p>
+ * The augmented matrix is copied from the binary file to the scratch file as tiles of tile_size * tile_size
+ * elements. Tiles of one tile column (panel) are stored after each other, so the panel is a row-major matrix
+ * with tile_size columns and it is read and written by one call. The LU decomposition is left-looking:
+ * panel k is read, updated by the factors of all previous panels (row swaps, triangular solve with L and GEMM
+ * with the rows below), factored with partial pivoting and written back. While one panel of the factors
+ * is applied, the next one is already being read by the prefetching thread. Vector b is a column of
+ * the augmented matrix, so it is eliminated together with A and the back-substitution streams the panels
+ * of U from the last to the first.
+ */
+class OutOfCoreSolver {
+public:
+    /**
+     * @param unknowns number of unknowns of the system
+     * @param memory_budget maximal number of bytes of the panel buffers
+     * @return largest tile size for which OUT_OF_CORE_PANELS_IN_MEMORY panels fit in the budget,
+     * throws std::domain_error if the budget is not enough even for OUT_OF_CORE_MIN_TILE
+     */
+    static int get_tile_size(int unknowns, size_t memory_budget);
+
+    /**
+     * Solves the square regular system from the dense binary file without loading the whole matrix.
+     *
+     * @param binary_path path to the dense binary file with the augmented matrix [A | b]
+     * @param settings memory budget and path to the scratch file
+     * @return OutOfCoreResult with the unique solution, throws std::domain_error if the system is not square
+     * or A is singular
+     */
+    static OutOfCoreResult solve(const std::string &binary_path, const OutOfCoreSettings &settings);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_OUT_OF_CORE_HPP
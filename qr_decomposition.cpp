@@ -0,0 +1,420 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <stdexcept>
+
+#include "qr_decomposition.hpp"
+#include "gemm.hpp"
+#include "thread_pool.hpp"
+#include "statistics.hpp"
+
+namespace {
+    /**
+     * @return norm of the column of the row-major buffer from the first row down
+     */
+    double column_norm(const double *data, int width, int height, int first_row, int column) {
+        double sum = 0;
+        for (int y = first_row; y < height; ++y) {
+            double value = data[static_cast<size_t>(width) * y + column];
+            sum += value * value;
+        }
+        return std::sqrt(sum);
+    }
+
+    /**
+     * Generates Householder reflection zeroing the column below the diagonal element (row, column).
+     * The diagonal element is overwritten by beta, the elements below it by the vector v without its leading 1.
+     *
+     * @return tau of the reflection, 0 if the column is already zero below the diagonal
+     */
+    double generate_reflection(double *data, int width, int height, int row, int column) {
+        double &alpha = data[static_cast<size_t>(width) * row + column];
+        double sum = 0;
+        for (int y = row + 1; y < height; ++y) {
+            double value = data[static_cast<size_t>(width) * y + column];
+            sum += value * value;
+        }
+        if (sum == 0) {
+            return 0;
+        }
+        double beta = -std::copysign(std::sqrt(alpha * alpha + sum), alpha);
+        double tau = (beta - alpha) / beta;
+        double scale = 1 / (alpha - beta);
+        for (int y = row + 1; y < height; ++y) {
+            data[static_cast<size_t>(width) * y + column] *= scale;
+        }
+        alpha = beta;
+        return tau;
+    }
+
+    /**
+     * Applies reflection stored in the column of the row-major buffer (diagonal on the row) to the vector.
+     */
+    void apply_reflection(const double *data, int width, int height, int row, int column, double tau,
+                          std::vector<double> &vector) {
+        if (tau == 0) return;
+        double dot = vector[row];
+        for (int y = row + 1; y < height; ++y) {
+            dot += data[static_cast<size_t>(width) * y + column] * vector[y];
+        }
+        dot *= tau;
+        vector[row] -= dot;
+        for (int y = row + 1; y < height; ++y) {
+            vector[y] -= dot * data[static_cast<size_t>(width) * y + column];
+        }
+    }
+
+    /**
+     * Computes C = H_0 * ... * H_(count-1) * C for the reflections stored in the columns of the row-major buffer.
+     * The reflections are applied by blocks of QR_PANEL_WIDTH as I - V * T * V^T, so the work is done by GEMM.
+     */
+    void apply_reflections(const double *data, int width, int height, const std::vector<double> &tau, int count,
+                           double *matrix_C, int columns) {
+        std::vector<double> packed_V, packed_Vt, matrix_T, product, scaled;
+        const int last_block = (count - 1) / QR_PANEL_WIDTH * QR_PANEL_WIDTH;
+        for (int first = last_block; first >= 0; first -= QR_PANEL_WIDTH) {
+            const int block = std::min(QR_PANEL_WIDTH, count - first);
+            const int rows = height - first;
+
+            // V (rows * block) and V^T with explicit ones and zeros
+            packed_V.assign(static_cast<size_t>(rows) * block, 0.0);
+            packed_Vt.assign(static_cast<size_t>(block) * rows, 0.0);
+            for (int j = 0; j < block; ++j) {
+                packed_V[static_cast<size_t>(block) * j + j] = 1;
+                packed_Vt[static_cast<size_t>(rows) * j + j] = 1;
+                for (int y = j + 1; y < rows; ++y) {
+                    double v = data[static_cast<size_t>(width) * (first + y) + first + j];
+                    packed_V[static_cast<size_t>(block) * y + j] = v;
+                    packed_Vt[static_cast<size_t>(rows) * j + y] = v;
+                }
+            }
+
+            // upper triangular T of the block, T(0..j-1, j) = -tau_j * T(0..j-1, 0..j-1) * V(0..j-1)^T * v_j
+            matrix_T.assign(static_cast<size_t>(block) * block, 0.0);
+            std::vector<double> dots(block);
+            for (int j = 0; j < block; ++j) {
+                const double t = tau[first + j];
+                for (int i = 0; i < j; ++i) {
+                    double dot = 0;
+                    for (int y = j; y < rows; ++y) {
+                        dot += packed_Vt[static_cast<size_t>(rows) * i + y] * packed_Vt[static_cast<size_t>(rows) * j + y];
+                    }
+                    dots[i] = -t * dot;
+                }
+                for (int i = 0; i < j; ++i) {
+                    double value = 0;
+                    for (int l = i; l < j; ++l) {
+                        value += matrix_T[static_cast<size_t>(block) * i + l] * dots[l];
+                    }
+                    matrix_T[static_cast<size_t>(block) * i + j] = value;
+                }
+                matrix_T[static_cast<size_t>(block) * j + j] = t;
+            }
+
+            // C -= V * (T * (V^T * C))
+            double *rows_C = matrix_C + static_cast<size_t>(columns) * first;
+            product.assign(static_cast<size_t>(block) * columns, 0.0);
+            GemmEngine::multiply_add(block, columns, rows, 1.0, packed_Vt.data(), rows, rows_C, columns,
+                                     product.data(), columns);
+            scaled.assign(static_cast<size_t>(block) * columns, 0.0);
+            GemmEngine::multiply_add(block, columns, block, 1.0, matrix_T.data(), block, product.data(), columns,
+                                     scaled.data(), columns);
+            GemmEngine::multiply_add(rows, columns, block, -1.0, packed_V.data(), block, scaled.data(), columns,
+                                     rows_C, columns);
+        }
+    }
+
+    double norm(const std::vector<double> &vector, size_t first = 0) {
+        double sum = 0;
+        for (size_t i = first; i < vector.size(); ++i) {
+            sum += vector[i] * vector[i];
+        }
+        return std::sqrt(sum);
+    }
+}
+
+QRDecomposition::QRDecomposition(Matrix factors) : factors(std::move(factors)), tolerance(0) {
+    permutation.resize(this->factors.width);
+    for (int x = 0; x < this->factors.width; ++x) {
+        permutation[x] = x;
+    }
+}
+
+int QRDecomposition::rank() const {
+    return static_cast<int>(tau.size());
+}
+
+std::vector<double> QRDecomposition::apply_transposed_q(std::vector<double> vector_b) const {
+    if (static_cast<int>(vector_b.size()) != factors.height) {
+        throw std::domain_error("Vector b has to have one element for each row of the matrix.");
+    }
+    // Q^T = H_(rank-1) ... H_0, so the reflections are applied from the first one
+    for (int k = 0; k < rank(); ++k) {
+        apply_reflection(factors.data, factors.width, factors.height, k, k, tau[k], vector_b);
+    }
+    return vector_b;
+}
+
+int QRDecomposer::decompose_in_place(double *data, const int &width, const int &height, const double &tolerance,
+                                     const bool &pivoting, std::vector<int> &permutation, std::vector<double> &tau,
+                                     int thread_count) {
+    std::shared_ptr<ThreadPool> pool;
+    if (thread_count > 1) {
+        pool = ThreadPool::get_shared(thread_count - 1);
+    }
+    auto at = [data, width](int y, int x) -> double & { return data[static_cast<size_t>(width) * y + x]; };
+
+    // downdated norms of the remaining parts of the columns and the norms they were last computed exactly
+    std::vector<double> norms(width);
+    std::vector<double> exact_norms(width);
+    if (pivoting) {
+        for (int x = 0; x < width; ++x) {
+            norms[x] = exact_norms[x] = column_norm(data, width, height, 0, x);
+        }
+    }
+    const double downdate_limit = std::sqrt(std::numeric_limits<double>::epsilon());
+
+    const int steps = std::min(width, height);
+    std::vector<double> matrix_F; // F^T, row i holds effect of i-th reflection of the panel on the columns
+    std::vector<double> aux(QR_PANEL_WIDTH);
+    std::vector<int> recompute;
+    int offset = 0;
+    bool finished = false;
+
+    while (offset < steps && !finished) {
+        const int panel_width = std::min(QR_PANEL_WIDTH, steps - offset);
+        const int columns = width - offset;
+        matrix_F.assign(static_cast<size_t>(panel_width) * columns, 0.0);
+        auto f = [&matrix_F, columns](int i, int x) -> double & {
+            return matrix_F[static_cast<size_t>(columns) * i + x];
+        };
+        recompute.clear();
+
+        int k = 0;
+        while (k < panel_width) {
+            const int rk = offset + k;
+            if (pivoting) {
+                int pivot = static_cast<int>(std::max_element(norms.begin() + rk, norms.end()) - norms.begin());
+                if (norms[pivot] <= tolerance) {
+                    finished = true;
+                    break;
+                }
+                if (pivot != rk) {
+                    for (int y = 0; y < height; ++y) {
+                        std::swap(at(y, pivot), at(y, rk));
+                    }
+                    for (int i = 0; i < panel_width; ++i) {
+                        std::swap(f(i, pivot - offset), f(i, k));
+                    }
+                    std::swap(permutation[pivot], permutation[rk]);
+                    norms[pivot] = norms[rk];
+                    exact_norms[pivot] = exact_norms[rk];
+                }
+            }
+
+            // the column was not updated by the previous reflections of the panel yet
+            for (int y = rk; y < height && k > 0; ++y) {
+                double sum = 0;
+                for (int i = 0; i < k; ++i) {
+                    sum += at(y, offset + i) * f(i, k);
+                }
+                at(y, rk) -= sum;
+            }
+
+            double t = generate_reflection(data, width, height, rk, rk);
+            tau.push_back(t);
+            const double diagonal = at(rk, rk);
+            at(rk, rk) = 1;
+
+            // F(k) = tau * A^T * v - tau * F(0..k-1) * V^T * v, the columns of A below the row rk are not updated
+            if (t != 0) {
+                double *row_F = &f(k, 0);
+                std::fill(aux.begin(), aux.begin() + k, 0.0);
+                for (int y = rk; y < height; ++y) {
+                    const double v = at(y, rk);
+                    if (v == 0) continue;
+                    const double *row = &at(y, 0);
+                    for (int x = rk + 1; x < width; ++x) {
+                        row_F[x - offset] += row[x] * v;
+                    }
+                    for (int i = 0; i < k; ++i) {
+                        aux[i] += row[offset + i] * v;
+                    }
+                }
+                for (int x = rk + 1; x < width; ++x) {
+                    row_F[x - offset] *= t;
+                }
+                for (int i = 0; i < k; ++i) {
+                    const double factor = -t * aux[i];
+                    if (factor == 0) continue;
+                    const double *row_Fi = &f(i, 0);
+                    for (int x = 0; x < columns; ++x) {
+                        row_F[x] += factor * row_Fi[x];
+                    }
+                }
+            }
+
+            // the current row is needed in its final form for the norm downdates and the next pivots
+            for (int i = 0; i <= k; ++i) {
+                const double factor = at(rk, offset + i);
+                if (factor == 0) continue;
+                const double *row_Fi = &f(i, 0);
+                for (int x = rk + 1; x < width; ++x) {
+                    at(rk, x) -= factor * row_Fi[x - offset];
+                }
+            }
+            at(rk, rk) = diagonal;
+            ++k;
+
+            if (pivoting) {
+                for (int x = rk + 1; x < width; ++x) {
+                    if (norms[x] == 0) continue;
+                    double ratio = std::abs(at(rk, x)) / norms[x];
+                    double factor = std::max(0.0, (1 + ratio) * (1 - ratio));
+                    double relative = factor * (norms[x] / exact_norms[x]) * (norms[x] / exact_norms[x]);
+                    if (relative <= downdate_limit) {
+                        recompute.push_back(x);
+                    } else {
+                        norms[x] *= std::sqrt(factor);
+                    }
+                }
+                // the norms can be computed again only after the whole matrix is updated
+                if (!recompute.empty()) break;
+            }
+        }
+
+        // the rest of the matrix is considered zero when the decomposition finishes
+        const int next = offset + k;
+        if (!finished && k > 0 && next < height && next < width) {
+            auto update = [=, &matrix_F](int first, int last) {
+                GemmEngine::multiply_add(height - next, last - first, k, -1.0, data + static_cast<size_t>(width) * next
+                                         + offset, width, matrix_F.data() + (first - offset), columns,
+                                         data + static_cast<size_t>(width) * next + first, width);
+            };
+            std::vector<std::future<void>> updates;
+            for (int tile = next; tile < width; tile += QR_UPDATE_TILE) {
+                const int tile_end = std::min(width, tile + QR_UPDATE_TILE);
+                if (pool) {
+                    updates.push_back(pool->submit([&update, tile, tile_end]() { update(tile, tile_end); }));
+                } else {
+                    update(tile, tile_end);
+                }
+            }
+            for (auto &task : updates) {
+                task.get();
+            }
+        }
+        for (int x : recompute) {
+            norms[x] = exact_norms[x] = column_norm(data, width, height, next, x);
+        }
+        offset = next;
+    }
+    return offset;
+}
+
+QRDecomposition QRDecomposer::decompose(Matrix matrix, int thread_count) {
+    ScopedTimer timer(Phase::FACTOR);
+    QRDecomposition qr(std::move(matrix));
+    const int width = qr.factors.width;
+    const int height = qr.factors.height;
+
+    double max_norm = 0;
+    for (int x = 0; x < width; ++x) {
+        max_norm = std::max(max_norm, column_norm(qr.factors.data, width, height, 0, x));
+    }
+    qr.tolerance = std::max(width, height) * std::numeric_limits<double>::epsilon() * max_norm;
+    decompose_in_place(qr.factors.data, width, height, qr.tolerance, true, qr.permutation, qr.tau, thread_count);
+    return qr;
+}
+
+QRSolution QRDecomposer::solve(const Matrix &matrix, int thread_count) {
+    if (!matrix.augmented) {
+        throw std::domain_error("QR decomposition solves only augmented matrices.");
+    }
+    const int unknowns = matrix.width - 1;
+    const std::vector<double> vector_b = matrix.get_column(unknowns);
+    QRDecomposition qr = decompose(matrix.get_matrix_A(), thread_count);
+    const int rank = qr.rank();
+    const Matrix &R = qr.factors;
+
+    QRSolution solution{true, rank, 0, std::vector<double>(unknowns, 0.0), {}};
+    std::vector<double> vector_c = qr.apply_transposed_q(vector_b);
+    solution.residual_norm = norm(vector_c, rank);
+
+    // y = [u; 0] in the coordinates of the rows of [R11 R12] for the particular solution
+    std::vector<double> vector_y(unknowns, 0.0);
+    Matrix matrix_W(0, 0, false);
+    std::vector<double> tau_Z;
+    if (rank == unknowns) {
+        for (int y = rank - 1; y >= 0; --y) {
+            double value = vector_c[y];
+            for (int x = y + 1; x < unknowns; ++x) {
+                value -= R.field(x, y) * vector_y[x];
+            }
+            vector_y[y] = value / R.field(y, y);
+        }
+    } else if (rank > 0) {
+        // [R11 R12]^T = Z * T, the rows of [R11 R12] span the same space as the first rank columns of Z
+        matrix_W = Matrix(rank, unknowns, false);
+        for (int y = 0; y < rank; ++y) {
+            for (int x = y; x < unknowns; ++x) {
+                matrix_W.field(y, x) = R.field(x, y);
+            }
+        }
+        std::vector<int> identity(rank);
+        for (int i = 0; i < rank; ++i) {
+            identity[i] = i;
+        }
+        decompose_in_place(matrix_W.data, rank, unknowns, 0, false, identity, tau_Z, thread_count);
+
+        // T^T * u = c, T^T is lower triangular
+        for (int i = 0; i < rank; ++i) {
+            double value = vector_c[i];
+            for (int j = 0; j < i; ++j) {
+                value -= matrix_W.field(i, j) * vector_y[j];
+            }
+            vector_y[i] = value / matrix_W.field(i, i);
+        }
+        for (int i = rank - 1; i >= 0; --i) {
+            apply_reflection(matrix_W.data, rank, unknowns, i, i, tau_Z[i], vector_y);
+        }
+    }
+    for (int x = 0; x < unknowns; ++x) {
+        solution.particular[qr.permutation[x]] = vector_y[x];
+    }
+
+    // the dropped part of R is smaller than the tolerance, so it can leave residual up to tolerance * |x|
+    const double residual_tolerance = qr.tolerance * std::max(norm(solution.particular), 1.0) +
+                                      std::max(R.width, R.height) * std::numeric_limits<double>::epsilon() *
+                                      norm(vector_b);
+    if (solution.residual_norm > residual_tolerance) {
+        solution.solution_exists = false;
+        solution.particular.clear();
+        return solution;
+    }
+
+    // the last unknowns - rank columns of P * Z are orthonormal basis of the kernel
+    const int defect = unknowns - rank;
+    if (defect == 0) {
+        return solution;
+    }
+    Matrix basis(defect, unknowns, false);
+    for (int j = 0; j < defect; ++j) {
+        basis.field(j, rank + j) = 1;
+    }
+    if (rank > 0) {
+        apply_reflections(matrix_W.data, rank, unknowns, tau_Z, rank, basis.data, defect);
+    }
+    solution.kernel.assign(defect, std::vector<double>(unknowns));
+    for (int x = 0; x < unknowns; ++x) {
+        for (int j = 0; j < defect; ++j) {
+            solution.kernel[j][qr.permutation[x]] = basis.field(j, x);
+        }
+    }
+    return solution;
+}
@@ -0,0 +1,130 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_QR_DECOMPOSITION_HPP
+#define LINEAR_SYSTEM_SOLVER_QR_DECOMPOSITION_HPP
+
+#include <vector>
+
+#include "matrix.hpp"
+
+/**
+ * Constant representing number of columns factored together before the rest of the matrix is updated.
+ */
+#define QR_PANEL_WIDTH 32
+
+/**
+ * Constant representing number of columns of the trailing matrix updated by one task.
+ */
+#define QR_UPDATE_TILE 192
+
+/**
+ * Struct representing compact result of the QR decomposition with column pivoting (AP = QR).
+ * <p>
+ * R is stored on and above the diagonal of the first rank rows. The Householder vectors
+ * H_k = I - tau[k] * v * v^T are stored below the diagonal (v has implicit 1 on the diagonal), Q = H_0 ... H_(rank-1).
+ * Rows from rank down are the rest of the matrix, which is considered zero. Column k of AP is column
+ * permutation[k] of A.
+ */
+struct QRDecomposition {
+    Matrix factors;
+    std::vector<double> tau;
+    std::vector<int> permutation;
+    double tolerance;
+
+    /**
+     * @param factors compact factors of the decomposition
+     */
+    explicit QRDecomposition(Matrix factors);
+
+    /**
+     * @return number of the Householder reflections (numerical rank of the decomposed matrix)
+     */
+    int rank() const;
+
+    /**
+     * Computes Q^T * b.
+     *
+     * @param vector_b vector with one element for each row of the decomposed matrix
+     * @return vector Q^T * b
+     */
+    std::vector<double> apply_transposed_q(std::vector<double> vector_b) const;
+};
+
+/**
+ * Struct representing the solution of the system found by the QR decomposition.
+ */
+struct QRSolution {
+    bool solution_exists;
+    int rank;
+    /**
+     * Norm of the part of b outside of the column space of A.
+     */
+    double residual_norm;
+    /**
+     * Particular solution with the smallest norm, it is orthogonal to the kernel.
+     */
+    std::vector<double> particular;
+    /**
+     * Orthonormal basis of the kernel.
+     */
+    std::vector<std::vector<double>> kernel;
+};
+
+/**
+ * Class responsible for computing the QR decomposition with column pivoting and solving the systems with it.
+ */
+class QRDecomposer {
+public:
+    /**
+     * Decomposes the given matrix with Householder reflections, the column with the largest remaining norm
+     * is taken in each step. The decomposition stops when the largest remaining norm is not larger than
+     * the tolerance, which reveals the rank.
+     * <p>
+     * Columns are processed in panels of QR_PANEL_WIDTH. The reflections of the panel update only the panel
+     * and the current rows, their effect on the rest of the matrix is collected to matrix F and applied
+     * at the end of the panel by one matrix multiplication A -= V * F^T split into tiles of QR_UPDATE_TILE columns.
+     * The remaining column norms are downdated after each reflection and computed again when the downdate
+     * loses too much precision.
+     *
+     * @param matrix matrix to be decomposed, its buffer is reused for the factors
+     * @param thread_count number of threads updating the trailing matrix
+     * @return QRDecomposition compact factors of the given matrix
+     */
+    static QRDecomposition decompose(Matrix matrix, int thread_count = 1);
+
+    /**
+     * Decomposes the row-major buffer in place with the same algorithm as decompose.
+     *
+     * @param data buffer with width * height elements, overwritten by the compact factors
+     * @param width number of columns
+     * @param height number of rows
+     * @param tolerance remaining column norm under which the decomposition stops
+     * @param pivoting false to keep the columns in their order, the decomposition then does all min(width, height)
+     * reflections
+     * @param permutation identity permutation of size width, the column swaps are applied to it
+     * @param tau vector the coefficients of the reflections are appended to
+     * @param thread_count number of threads updating the trailing matrix
+     * @return number of the reflections (rank)
+     */
+    static int decompose_in_place(double *data, const int &width, const int &height, const double &tolerance,
+                                  const bool &pivoting, std::vector<int> &permutation, std::vector<double> &tau,
+                                  int thread_count);
+
+    /**
+     * Solves the system given by the augmented matrix.
+     * <p>
+     * A is decomposed to AP = QR, the first rank rows of R form [R11 R12]. If the part of Q^T * b below
+     * the rank is not negligible, the system has no solution. Otherwise [R11 R12]^T = Z * T is decomposed
+     * without pivoting, the particular solution is P * Z * [T^-T * c; 0] and the last width - rank
+     * columns of P * Z form the orthonormal basis of the kernel.
+     *
+     * @param matrix augmented matrix of the system
+     * @param thread_count number of threads updating the trailing matrix
+     * @return QRSolution of the system
+     */
+    static QRSolution solve(const Matrix &matrix, int thread_count = 1);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_QR_DECOMPOSITION_HPP
@@ -0,0 +1,252 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include "result_sink.hpp"
+#include "matrix.hpp"
+#include "scalar_type.hpp"
+#include "statistics.hpp"
+
+namespace {
+    /**
+     * Base of the sinks, implements write_result for all scalar types by the template method write
+     * of the derived sink.
+     *
+     * @tparam Derived the sink with the method write
+     * @tparam Base ResultSink or the sink the derived sink extends
+     */
+    template<typename Derived, typename Base = ResultSink>
+    class TypedSink : public Base {
+    public:
+        explicit TypedSink(std::ostream &ostream) : Base(ostream) {}
+
+        void write_result(const SolveResult &result) override {
+            static_cast<Derived *>(this)->write(result);
+        }
+
+        void write_result(const BasicSolveResult<float> &result) override {
+            static_cast<Derived *>(this)->write(result);
+        }
+
+        void write_result(const BasicSolveResult<long double> &result) override {
+            static_cast<Derived *>(this)->write(result);
+        }
+
+        void write_result(const BasicSolveResult<std::complex<double>> &result) override {
+            static_cast<Derived *>(this)->write(result);
+        }
+    };
+
+    /**
+     * Sink writing nothing.
+     */
+    class QuietSink : public TypedSink<QuietSink> {
+    public:
+        explicit QuietSink(std::ostream &ostream) : TypedSink(ostream) {}
+
+        template<typename T>
+        void write(const BasicSolveResult<T> &/*result*/) {}
+    };
+
+    /**
+     * Sink writing the messages, one line about the result and the time.
+     */
+    class SummarySink : public TypedSink<SummarySink> {
+    public:
+        explicit SummarySink(std::ostream &ostream) : TypedSink(ostream) {}
+
+        void write_message(const std::string &message) override {
+            ostream << message << std::endl;
+        }
+
+        template<typename T>
+        void write(const BasicSolveResult<T> &result) {
+            ScopedTimer timer(Phase::OUTPUT);
+            if (result.rank >= 0) {
+                ostream << "Rank of the matrix is " << result.rank << "." << std::endl;
+            }
+            if (result.status == SolveStatus::NO_SOLUTION) {
+                ostream << "Given linear system has no solution." << std::endl;
+            } else if (result.status == SolveStatus::NOT_CONVERGED) {
+                ostream << "Given linear system has approximate solution with " << result.particular.size()
+                        << " unknowns." << std::endl;
+            } else if (result.status == SolveStatus::UNIQUE) {
+                ostream << "Given linear system has unique solution with " << result.particular.size()
+                        << " unknowns." << std::endl;
+            } else {
+                ostream << "Given linear system has solution with " << result.particular.size()
+                        << " unknowns and kernel of dimension " << result.kernel.size() << "." << std::endl;
+            }
+        }
+
+        void write_time(long long milliseconds) override {
+            ostream << "Needed " << milliseconds << " ms to finish." << std::endl;
+        }
+    };
+
+    /**
+     * Sink writing the details and the solution as text, the numbers are printed by operator<<.
+     */
+    class FullTextSink : public TypedSink<FullTextSink, SummarySink> {
+    public:
+        explicit FullTextSink(std::ostream &ostream) : TypedSink(ostream) {}
+
+        std::ostream *get_details() override {
+            return &ostream;
+        }
+
+        template<typename T>
+        void write(const BasicSolveResult<T> &result) {
+            ScopedTimer timer(Phase::OUTPUT);
+            if (result.status == SolveStatus::NO_SOLUTION) {
+                ostream << "Given linear system has no solution." << std::endl;
+            } else if (result.status == SolveStatus::NOT_CONVERGED) {
+                ostream << "Last approximation of the solution is:" << std::endl << result.particular;
+            } else {
+                ostream << "Solution of the linear system:" << std::endl;
+                if (!result.kernel.empty()) {
+                    ostream << "Particular solution is:" << std::endl << result.particular;
+                    ostream << "Basis of the kernel is:" << std::endl;
+                    for (const auto &vector : result.kernel) {
+                        ostream << vector;
+                    }
+                } else {
+                    ostream << "Unique solution is:" << std::endl << result.particular;
+                }
+            }
+        }
+    };
+
+    /**
+     * Sink writing the solution vectors as CSV lines, first field of the line names the vector
+     * (particular, approximation or kernel), no_solution is written if the solution does not exist.
+     */
+    class CsvSink : public TypedSink<CsvSink> {
+    private:
+        static void write_value(BufferedWriter &writer, double value) {
+            writer.write(value);
+        }
+
+        static void write_value(BufferedWriter &writer, float value) {
+            char buffer[32];
+            int length = std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+            writer.write(buffer, length);
+        }
+
+        static void write_value(BufferedWriter &writer, long double value) {
+            char buffer[48];
+            int length = std::snprintf(buffer, sizeof(buffer), "%.21Lg", value);
+            writer.write(buffer, length);
+        }
+
+        /**
+         * Writes the complex number as a+bi or a-bi, the form read by TextMatrixParser.
+         */
+        static void write_value(BufferedWriter &writer, const std::complex<double> &value) {
+            writer.write(value.real());
+            if (!std::signbit(value.imag())) {
+                writer.write('+');
+            }
+            writer.write(value.imag());
+            writer.write('i');
+        }
+
+        template<typename T>
+        static void write_vector(BufferedWriter &writer, const char *name, const std::vector<T> &vector) {
+            writer.write(name, std::strlen(name));
+            for (const T &value : vector) {
+                writer.write(',');
+                write_value(writer, value);
+            }
+            writer.write('\n');
+        }
+
+    public:
+        explicit CsvSink(std::ostream &ostream) : TypedSink(ostream) {}
+
+        template<typename T>
+        void write(const BasicSolveResult<T> &result) {
+            ScopedTimer timer(Phase::OUTPUT);
+            BufferedWriter writer(ostream);
+            if (!result.has_solution()) {
+                writer.write(std::string("no_solution\n"));
+                return;
+            }
+            write_vector(writer, result.status == SolveStatus::NOT_CONVERGED ? "approximation" : "particular",
+                         result.particular);
+            for (const auto &vector : result.kernel) {
+                write_vector(writer, "kernel", vector);
+            }
+        }
+    };
+
+    /**
+     * Sink writing the result in the binary format described by BinaryResultHeader.
+     */
+    class BinarySink : public TypedSink<BinarySink> {
+    public:
+        explicit BinarySink(std::ostream &ostream) : TypedSink(ostream) {}
+
+        template<typename T>
+        void write(const BasicSolveResult<T> &result) {
+            ScopedTimer timer(Phase::OUTPUT);
+            BinaryResultHeader header{};
+            std::memcpy(header.magic, RESULT_MAGIC, sizeof(header.magic));
+            header.version = RESULT_VERSION;
+            header.flags = (result.has_solution() ? 1u : 0u) |
+                           (result.status != SolveStatus::NOT_CONVERGED ? 2u : 0u) |
+                           static_cast<uint32_t>(ScalarTraits<T>::get_type()) << 8u;
+            header.unknowns = result.particular.size();
+            header.rank = result.rank;
+            header.kernel_size = result.kernel.size();
+
+            BufferedWriter writer(ostream);
+            writer.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            if (!result.has_solution()) return;
+            writer.write(reinterpret_cast<const char *>(result.particular.data()),
+                         result.particular.size() * sizeof(T));
+            for (const auto &vector : result.kernel) {
+                writer.write(reinterpret_cast<const char *>(vector.data()), vector.size() * sizeof(T));
+            }
+        }
+    };
+}
+
+std::unique_ptr<ResultSink> ResultSink::create(const OutputLevel &level, std::ostream &ostream) {
+    switch (level) {
+        case OutputLevel::QUIET:
+            return std::unique_ptr<ResultSink>(new QuietSink(ostream));
+        case OutputLevel::SUMMARY:
+            return std::unique_ptr<ResultSink>(new SummarySink(ostream));
+        case OutputLevel::CSV:
+            return std::unique_ptr<ResultSink>(new CsvSink(ostream));
+        case OutputLevel::BINARY:
+            return std::unique_ptr<ResultSink>(new BinarySink(ostream));
+        case OutputLevel::FULL:
+            break;
+    }
+    return std::unique_ptr<ResultSink>(new FullTextSink(ostream));
+}
+
+OutputLevel ResultSink::parse_level(const std::string &name) {
+    if (name == "quiet") return OutputLevel::QUIET;
+    if (name == "summary") return OutputLevel::SUMMARY;
+    if (name == "full") return OutputLevel::FULL;
+    if (name == "csv") return OutputLevel::CSV;
+    if (name == "binary") return OutputLevel::BINARY;
+    throw std::domain_error("Unknown output level " + name + ", use quiet, summary, full, csv or binary.");
+}
+
+bool ResultSink::parse_argument(const std::string &argument, OutputLevel &level) {
+    const std::string prefix = "--output=";
+    if (argument.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    level = parse_level(argument.substr(prefix.size()));
+    return true;
+}
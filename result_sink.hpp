@@ -0,0 +1,137 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_RESULT_SINK_HPP
+#define LINEAR_SYSTEM_SOLVER_RESULT_SINK_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "number_formatter.hpp"
+#include "solve_result.hpp"
+
+/**
+ * Constant representing the first 8 bytes of every binary result.
+ */
+#define RESULT_MAGIC "LSSRESLT"
+
+/**
+ * Constant representing current version of the binary result.
+ */
+#define RESULT_VERSION 1
+
+/**
+ * Enumeration for the levels of the output of the solve.
+ */
+enum class OutputLevel {
+    QUIET, // nothing is written, the result is only returned
+    SUMMARY, // rank, existence of the solution, dimension of the kernel and time
+    FULL, // the input, the intermediate matrices and the solution as text
+    CSV, // one line per solution vector with all digits
+    BINARY // BinaryResultHeader followed by the solution vectors
+};
+
+/**
+ * Struct representing header of the binary result, the particular solution (if it exists) and the kernel
+ * basis vectors follow right after it as values of the scalar type of the system (float64 for the double systems).
+ * All numbers are little-endian.
+ */
+struct BinaryResultHeader {
+    char magic[8];
+    uint32_t version;
+    /**
+     * Bit 0 is set if the solution exists, bit 1 if the method converged, bits 8 to 15 hold the ScalarType
+     * of the values.
+     */
+    uint32_t flags;
+    int64_t unknowns;
+    int64_t rank;
+    int64_t kernel_size;
+};
+
+static_assert(sizeof(BinaryResultHeader) == 40, "binary result header has to be packed");
+
+/**
+ * Class responsible for writing the progress and the result of the solve in one OutputLevel.
+ * <p>
+ * The solvers ask for the details stream first, the input and the intermediate matrices are extracted
+ * and printed only if the sink has one. The messages are short notes about the method (convergence, fallback),
+ * the result and the time are written at the end of each solve.
+ */
+class ResultSink {
+protected:
+    std::ostream &ostream;
+
+public:
+    /**
+     * @param ostream output stream the sink writes to
+     */
+    explicit ResultSink(std::ostream &ostream) : ostream(ostream) {}
+
+    virtual ~ResultSink() = default;
+
+    /**
+     * @return stream for the input, the intermediate matrices and the other details, nullptr if they are not written
+     */
+    virtual std::ostream *get_details() {
+        return nullptr;
+    }
+
+    /**
+     * @param message one line of note about the method, without the line end
+     */
+    virtual void write_message(const std::string &/*message*/) {}
+
+    /**
+     * @param result solution of the system
+     */
+    virtual void write_result(const SolveResult &result) = 0;
+
+    /**
+     * @param result solution of the float system
+     */
+    virtual void write_result(const BasicSolveResult<float> &result) = 0;
+
+    /**
+     * @param result solution of the long double system
+     */
+    virtual void write_result(const BasicSolveResult<long double> &result) = 0;
+
+    /**
+     * @param result solution of the complex system
+     */
+    virtual void write_result(const BasicSolveResult<std::complex<double>> &result) = 0;
+
+    /**
+     * @param milliseconds time needed by the whole solve
+     */
+    virtual void write_time(long long /*milliseconds*/) {}
+
+    /**
+     * @param level output level of the sink
+     * @param ostream output stream the sink writes to
+     * @return ResultSink writing in the given level
+     */
+    static std::unique_ptr<ResultSink> create(const OutputLevel &level, std::ostream &ostream);
+
+    /**
+     * @param name name of the level (quiet, summary, full, csv, binary)
+     * @return OutputLevel with the given name, throws std::domain_error for unknown name
+     */
+    static OutputLevel parse_level(const std::string &name);
+
+    /**
+     * Parses the command line argument --output=LEVEL.
+     *
+     * @param argument the argument
+     * @param level set to the parsed level if the argument was --output
+     * @return true if the argument was --output, throws std::domain_error for unknown level
+     */
+    static bool parse_argument(const std::string &argument, OutputLevel &level);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_RESULT_SINK_HPP
@@ -0,0 +1,52 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <stdexcept>
+
+#include "scalar_type.hpp"
+
+std::string ScalarTypes::get_name(const ScalarType &type) {
+    switch (type) {
+        case ScalarType::FLOAT32:
+            return "float";
+        case ScalarType::FLOAT64:
+            return "double";
+        case ScalarType::LONG_DOUBLE:
+            return "long-double";
+        case ScalarType::COMPLEX128:
+            return "complex";
+    }
+    return "unknown";
+}
+
+ScalarType ScalarTypes::parse_name(const std::string &name) {
+    if (name == "float") return ScalarType::FLOAT32;
+    if (name == "double") return ScalarType::FLOAT64;
+    if (name == "long-double") return ScalarType::LONG_DOUBLE;
+    if (name == "complex") return ScalarType::COMPLEX128;
+    throw std::domain_error("Unknown scalar type " + name + ", use float, double, long-double or complex.");
+}
+
+bool ScalarTypes::parse_argument(const std::string &argument, ScalarType &type) {
+    const std::string prefix = "--type=";
+    if (argument.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    type = parse_name(argument.substr(prefix.size()));
+    return true;
+}
+
+size_t ScalarTypes::get_size(const ScalarType &type) {
+    switch (type) {
+        case ScalarType::FLOAT32:
+            return sizeof(float);
+        case ScalarType::LONG_DOUBLE:
+            return sizeof(long double);
+        case ScalarType::COMPLEX128:
+            return sizeof(std::complex<double>);
+        case ScalarType::FLOAT64:
+            break;
+    }
+    return sizeof(double);
+}
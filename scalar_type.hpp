@@ -0,0 +1,192 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_SCALAR_TYPE_HPP
+#define LINEAR_SYSTEM_SOLVER_SCALAR_TYPE_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <string>
+
+/**
+ * Enumeration for the types of the matrix elements. The values are stored in the binary files and results.
+ */
+enum class ScalarType : uint32_t {
+    FLOAT64 = 0, // double
+    FLOAT32 = 1, // float
+    LONG_DOUBLE = 2, // long double of the platform, stored in sizeof(long double) bytes
+    COMPLEX128 = 3 // std::complex<double>, real and imaginary part as float64
+};
+
+/**
+ * Struct describing the type of the matrix elements for the templated matrix and solver.
+ * Specialized for float, double, long double and std::complex<double>.
+ *
+ * @tparam T type of the elements
+ */
+template<typename T>
+struct ScalarTraits;
+
+template<>
+struct ScalarTraits<float> {
+    typedef float Real;
+
+    static ScalarType get_type() { return ScalarType::FLOAT32; }
+
+    static float magnitude(const float &value) { return std::abs(value); }
+};
+
+template<>
+struct ScalarTraits<double> {
+    typedef double Real;
+
+    static ScalarType get_type() { return ScalarType::FLOAT64; }
+
+    static double magnitude(const double &value) { return std::abs(value); }
+};
+
+template<>
+struct ScalarTraits<long double> {
+    typedef long double Real;
+
+    static ScalarType get_type() { return ScalarType::LONG_DOUBLE; }
+
+    static long double magnitude(const long double &value) { return std::abs(value); }
+};
+
+template<>
+struct ScalarTraits<std::complex<double>> {
+    typedef double Real;
+
+    static ScalarType get_type() { return ScalarType::COMPLEX128; }
+
+    /**
+     * Sum of the magnitudes of the parts, it is cheaper than the modulus and it chooses equally good pivots.
+     */
+    static double magnitude(const std::complex<double> &value) {
+        return std::abs(value.real()) + std::abs(value.imag());
+    }
+};
+
+/**
+ * Real type of the magnitudes and the tolerances of the elements of type T.
+ */
+template<typename T>
+using RealType = typename ScalarTraits<T>::Real;
+
+/**
+ * Empty struct carrying the type of the elements, ScalarTypes::visit passes it to the body.
+ *
+ * @tparam T type of the elements
+ */
+template<typename T>
+struct ScalarTag {
+    typedef T type;
+};
+
+/**
+ * Class responsible for the names of the scalar types and for choosing the template instantiation at runtime.
+ */
+class ScalarTypes {
+public:
+    /**
+     * @param type scalar type
+     * @return name of the type used in the arguments and the txt files (float, double, long-double, complex)
+     */
+    static std::string get_name(const ScalarType &type);
+
+    /**
+     * @param name name of the type
+     * @return ScalarType with the given name, throws std::domain_error for unknown name
+     */
+    static ScalarType parse_name(const std::string &name);
+
+    /**
+     * Parses the command line argument --type=NAME.
+     *
+     * @param argument the argument
+     * @param type set to the parsed type if the argument was --type
+     * @return true if the argument was --type, throws std::domain_error for unknown type
+     */
+    static bool parse_argument(const std::string &argument, ScalarType &type);
+
+    /**
+     * @param type scalar type
+     * @return size of one element in bytes
+     */
+    static size_t get_size(const ScalarType &type);
+
+    /**
+     * Calls the body with ScalarTag of the type, so the templated code is chosen by the value known at runtime.
+     *
+     * @tparam F generic callable with one parameter
+     * @param type scalar type
+     * @param body function called with ScalarTag<float>, ScalarTag<double>, ScalarTag<long double>
+     * or ScalarTag<std::complex<double>>
+     */
+    template<typename F>
+    static void visit(const ScalarType &type, F &&body) {
+        switch (type) {
+            case ScalarType::FLOAT32:
+                body(ScalarTag<float>());
+                return;
+            case ScalarType::LONG_DOUBLE:
+                body(ScalarTag<long double>());
+                return;
+            case ScalarType::COMPLEX128:
+                body(ScalarTag<std::complex<double>>());
+                return;
+            case ScalarType::FLOAT64:
+                break;
+        }
+        body(ScalarTag<double>());
+    }
+};
+
+/**
+ * Class responsible for the loops shared by the eliminations of all scalar types.
+ */
+class ScalarKernels {
+public:
+    /**
+     * Computes target[i] -= multiplier * source[i] for i from 0 to count - 1. The loop vectorizes for float
+     * and double, long double has no vector instructions.
+     *
+     * @tparam T type of the elements
+     * @param target elements to be updated
+     * @param source elements to be subtracted
+     * @param multiplier multiplier of the source
+     * @param count number of the elements
+     */
+    template<typename T>
+    static void subtract_scaled(T *target, const T *source, const T &multiplier, const int &count) {
+        for (int i = 0; i < count; ++i) {
+            target[i] -= multiplier * source[i];
+        }
+    }
+};
+
+/**
+ * The product of std::complex checks the result for NaN and calls the library on each element, so the loop
+ * does not vectorize. The parts are multiplied directly instead, std::complex is stored as two doubles.
+ */
+template<>
+inline void ScalarKernels::subtract_scaled<std::complex<double>>(std::complex<double> *target,
+                                                                 const std::complex<double> *source,
+                                                                 const std::complex<double> &multiplier,
+                                                                 const int &count) {
+    auto *t = reinterpret_cast<double *>(target);
+    const auto *s = reinterpret_cast<const double *>(source);
+    const double re = multiplier.real();
+    const double im = multiplier.imag();
+    for (int i = 0; i < count; ++i) {
+        const double s_re = s[2 * i];
+        const double s_im = s[2 * i + 1];
+        t[2 * i] -= re * s_re - im * s_im;
+        t[2 * i + 1] -= re * s_im + im * s_re;
+    }
+}
+
+#endif //LINEAR_SYSTEM_SOLVER_SCALAR_TYPE_HPP
@@ -0,0 +1,553 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "server.hpp"
+#include "binary_format.hpp"
+#include "bounded_queue.hpp"
+#include "factorization.hpp"
+#include "fixed_matrix.hpp"
+#include "result_sink.hpp"
+#include "system_solver.hpp"
+#include "text_parser.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+
+namespace {
+    std::atomic<bool> stop_requested(false);
+
+    /**
+     * Struct representing the response ready to be written.
+     */
+    struct Response {
+        /**
+         * ResponseHeader followed by the payload.
+         */
+        std::string bytes;
+        bool failed;
+        /**
+         * False for the responses not counted in the latency (reports).
+         */
+        bool measured;
+        std::chrono::high_resolution_clock::time_point received;
+    };
+
+    /**
+     * Struct representing parsed request waiting for the solving job.
+     */
+    struct SolveTask {
+        std::unique_ptr<Matrix> matrix;
+        std::unique_ptr<SparseMatrix> sparse;
+        std::promise<Response> promise;
+        std::chrono::high_resolution_clock::time_point received;
+    };
+
+    std::string create_response(ResponseStatus status, const std::string &payload) {
+        ResponseHeader header{};
+        std::memcpy(header.magic, RESPONSE_MAGIC, sizeof(header.magic));
+        header.status = status;
+        header.length = payload.size();
+        std::string bytes(reinterpret_cast<const char *>(&header), sizeof(header));
+        return bytes + payload;
+    }
+
+    /**
+     * @return false if the connection was closed before all bytes were read
+     */
+    bool read_fully(int descriptor, char *data, size_t size) {
+        while (size > 0) {
+            ssize_t count = ::recv(descriptor, data, size, 0);
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) return false;
+            data += count;
+            size -= count;
+        }
+        return true;
+    }
+
+    /**
+     * Reads the payload by chunks of SERVER_READ_CHUNK_SIZE bytes, so the length announced in the header
+     * is not allocated before the client really sends the data.
+     *
+     * @return false if the connection was closed before all bytes were read
+     */
+    bool read_payload(int descriptor, std::string &payload, uint64_t length) {
+        payload.clear();
+        while (payload.size() < length) {
+            const size_t offset = payload.size();
+            const size_t chunk = static_cast<size_t>(std::min<uint64_t>(SERVER_READ_CHUNK_SIZE, length - offset));
+            payload.resize(offset + chunk);
+            if (!read_fully(descriptor, &payload[offset], chunk)) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @return false if the connection was closed before all bytes were written
+     */
+    bool write_fully(int descriptor, const char *data, size_t size) {
+        while (size > 0) {
+            // the closed connection returns error instead of SIGPIPE
+            ssize_t count = ::send(descriptor, data, size, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) return false;
+            data += count;
+            size -= count;
+        }
+        return true;
+    }
+
+    /**
+     * Hash of the matrix A of the augmented matrix, vector b is not part of it.
+     */
+    uint64_t hash_matrix_A(const Matrix &matrix) {
+        uint64_t hash = 14695981039346656037ULL ^ (static_cast<uint64_t>(matrix.width) << 32u | matrix.height);
+        for (int y = 0; y < matrix.height; ++y) {
+            const double *row = &matrix.field(0, y);
+            for (int x = 0; x + 1 < matrix.width; ++x) {
+                uint64_t word;
+                std::memcpy(&word, row + x, sizeof(word));
+                hash = (hash ^ word) * 1099511628211ULL;
+            }
+        }
+        return hash;
+    }
+
+    bool is_matrix_A_of(const Matrix &matrix_A, const Matrix &matrix) {
+        if (matrix_A.width != matrix.width - 1 || matrix_A.height != matrix.height) {
+            return false;
+        }
+        for (int y = 0; y < matrix.height; ++y) {
+            if (std::memcmp(&matrix_A.field(0, y), &matrix.field(0, y), matrix_A.width * sizeof(double)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Least recently used factorizations of the matrices A, the matrix A is compared element by element,
+     * so the equal hash is not enough to get the other matrix's factorization.
+     */
+    class FactorizationCache {
+    private:
+        struct Entry {
+            uint64_t hash;
+            Matrix matrix_A;
+            std::shared_ptr<const Factorization> factorization;
+        };
+
+        std::mutex mutex;
+        std::list<Entry> entries;
+        size_t capacity;
+
+    public:
+        std::atomic<long long> hits{0};
+        std::atomic<long long> misses{0};
+
+        explicit FactorizationCache(size_t capacity) : capacity(capacity) {}
+
+        /**
+         * @param matrix augmented matrix of the system
+         * @param context settings of the factorization
+         * @return factorization of the matrix A, created if it is not in the cache
+         */
+        std::shared_ptr<const Factorization> get(const Matrix &matrix, const SolverContext &context) {
+            uint64_t hash = hash_matrix_A(matrix);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+                    if (entry->hash == hash && is_matrix_A_of(entry->matrix_A, matrix)) {
+                        entries.splice(entries.begin(), entries, entry);
+                        ++hits;
+                        return entries.front().factorization;
+                    }
+                }
+            }
+
+            // the factorization runs without the lock, two jobs can factor the same matrix at worst
+            ++misses;
+            Matrix matrix_A = matrix.get_matrix_A();
+            auto factorization = std::make_shared<const Factorization>(SystemSolver::factor(matrix_A, context));
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.push_front(Entry{hash, std::move(matrix_A), factorization});
+            if (entries.size() > capacity) {
+                entries.pop_back();
+            }
+            return factorization;
+        }
+    };
+
+    /**
+     * Latencies of the last SERVER_LATENCY_WINDOW requests.
+     */
+    class LatencyRecorder {
+    private:
+        std::mutex mutex;
+        std::vector<double> window;
+        size_t next = 0;
+        long long requests = 0;
+        long long failed_requests = 0;
+
+    public:
+        void record(double milliseconds, bool failed) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (window.size() < SERVER_LATENCY_WINDOW) {
+                window.push_back(milliseconds);
+            } else {
+                window[next] = milliseconds;
+                next = (next + 1) % SERVER_LATENCY_WINDOW;
+            }
+            ++requests;
+            if (failed) ++failed_requests;
+        }
+
+        /**
+         * @return ServerReport without the cache counters
+         */
+        ServerReport get_report() {
+            std::vector<double> times;
+            ServerReport report{};
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                times = window;
+                report.requests = requests;
+                report.failed_requests = failed_requests;
+            }
+            if (times.empty()) {
+                return report;
+            }
+            // nearest rank, the same as the benchmark uses for p99
+            std::sort(times.begin(), times.end());
+            auto rank = [&times](double percentile) {
+                auto position = static_cast<size_t>(std::ceil(percentile * times.size()));
+                return times[std::max<size_t>(position, 1) - 1];
+            };
+            report.p50_ms = rank(0.5);
+            report.p99_ms = rank(0.99);
+            report.max_ms = times.back();
+            return report;
+        }
+    };
+
+    /**
+     * Struct representing one client, its reader and writer thread.
+     */
+    struct Connection {
+        int descriptor;
+        /**
+         * Responses in the order of the requests, the reader blocks when SERVER_PIPELINE_DEPTH of them wait.
+         */
+        BoundedQueue<std::future<Response>> responses{SERVER_PIPELINE_DEPTH};
+        std::thread reader;
+        std::thread writer;
+        std::atomic<bool> finished{false};
+
+        explicit Connection(int descriptor) : descriptor(descriptor) {}
+    };
+
+    /**
+     * State shared by the connections and the jobs.
+     */
+    struct ServerState {
+        SolverContext context;
+        BoundedQueue<SolveTask> tasks;
+        std::unique_ptr<FactorizationCache> cache;
+        LatencyRecorder latency;
+
+        ServerState(const ServerSettings &settings, int jobs) :
+                context(settings.context), tasks(static_cast<size_t>(jobs) * SERVER_QUEUE_SLOTS_PER_JOB) {
+            if (settings.cache_size > 0) {
+                cache.reset(new FactorizationCache(settings.cache_size));
+            }
+        }
+
+        ServerReport get_report() {
+            ServerReport report = latency.get_report();
+            report.cache_hits = cache ? cache->hits.load() : 0;
+            report.cache_misses = cache ? cache->misses.load() : 0;
+            return report;
+        }
+    };
+
+    /**
+     * Parses the payload to the matrix of the task, sparse binary matrices stay sparse.
+     */
+    void parse_request(RequestType type, const std::string &payload, SolveTask &task) {
+        if (type == RequestType::TEXT) {
+            task.matrix.reset(new Matrix(TextMatrixParser::parse(payload.data(), payload.data() + payload.size())));
+        } else if (BinaryMatrixFile::parse_header(payload.data(), payload.size()).storage == StorageType::DENSE) {
+            task.matrix.reset(new Matrix(BinaryMatrixFile::parse_dense(payload.data(), payload.size())));
+        } else {
+            task.sparse.reset(new SparseMatrix(BinaryMatrixFile::parse_sparse(payload.data(), payload.size())));
+        }
+        const bool augmented = task.sparse ? task.sparse->augmented : task.matrix->augmented;
+        const int width = task.sparse ? task.sparse->width : task.matrix->width;
+        if (!augmented || width < 2) {
+            throw std::domain_error("Request has to hold augmented matrix.");
+        }
+    }
+
+    /**
+     * Reads and parses the requests of the connection until the client closes it.
+     */
+    void read_requests(ServerState &state, Connection &connection) {
+        RequestHeader header{};
+        while (read_fully(connection.descriptor, reinterpret_cast<char *>(&header), sizeof(header))) {
+            std::promise<Response> promise;
+            connection.responses.push(promise.get_future());
+
+            bool valid = std::memcmp(header.magic, REQUEST_MAGIC, sizeof(header.magic)) == 0
+                         && header.type <= RequestType::STATISTICS && header.length <= SERVER_MAX_REQUEST_SIZE;
+            if (!valid) {
+                // the stream cannot be synchronized again, the connection is closed after the error
+                promise.set_value(Response{create_response(ResponseStatus::ERROR, "Invalid request header."),
+                                           true, true, std::chrono::high_resolution_clock::now()});
+                break;
+            }
+            std::string payload;
+            try {
+                if (!read_payload(connection.descriptor, payload, header.length)) {
+                    promise.set_value(Response{"", true, false, std::chrono::high_resolution_clock::now()});
+                    break;
+                }
+            } catch (std::exception &e) {
+                // the rest of the payload is not read, so the connection is closed after the error as well
+                promise.set_value(Response{create_response(ResponseStatus::ERROR,
+                                                           "Failed to read the request: " + std::string(e.what())),
+                                           true, true, std::chrono::high_resolution_clock::now()});
+                break;
+            }
+            auto received = std::chrono::high_resolution_clock::now();
+
+            if (header.type == RequestType::STATISTICS) {
+                std::ostringstream report;
+                SolverServer::print_report(report, state.get_report());
+                promise.set_value(Response{create_response(ResponseStatus::OK, report.str()), false, false, received});
+                continue;
+            }
+            try {
+                SolveTask task{nullptr, nullptr, std::promise<Response>(), received};
+                parse_request(header.type, payload, task);
+                task.promise = std::move(promise);
+                state.tasks.push(std::move(task));
+            } catch (std::exception &e) {
+                promise.set_value(Response{create_response(ResponseStatus::ERROR, e.what()), true, true, received});
+            }
+        }
+        connection.responses.close();
+    }
+
+    /**
+     * Writes the responses of the connection in the order of the requests.
+     */
+    void write_responses(ServerState &state, Connection &connection) {
+        bool connected = true;
+        std::future<Response> future;
+        while (connection.responses.pop(future)) {
+            Response response = future.get();
+            // after the client disconnects the responses are only drained, so the reader is not blocked
+            if (connected && !response.bytes.empty()) {
+                connected = write_fully(connection.descriptor, response.bytes.data(), response.bytes.size());
+            }
+            if (response.measured) {
+                auto written = std::chrono::high_resolution_clock::now();
+                state.latency.record(to_fractional_ms(written - response.received), response.failed || !connected);
+            }
+        }
+        connection.finished = true;
+    }
+
+    /**
+     * Solves the parsed requests of all connections until the queue is closed.
+     */
+    void solve_requests(ServerState &state) {
+        SolveTask task;
+        while (state.tasks.pop(task)) {
+            Response response{"", false, true, task.received};
+            try {
+                std::ostringstream output;
+                std::unique_ptr<ResultSink> sink = ResultSink::create(state.context.output_level, output);
+                if (task.sparse) {
+                    SystemSolver::solve_with_method(*sink, *task.sparse, state.context);
+                } else if (state.cache && state.context.method == SolverMethod::DIRECT
+                           && !FixedSizeSolver::is_supported(*task.matrix)) {
+                    // the fixed size kernels solve the small systems faster than the cache finds their factorization
+                    const Matrix &matrix = *task.matrix;
+                    std::shared_ptr<const Factorization> factorization = state.cache->get(matrix, state.context);
+                    SystemSolver::solve(*sink, *factorization, matrix.get_column(matrix.width - 1));
+                } else {
+                    SystemSolver::solve_with_method(*sink, *task.matrix, state.context);
+                }
+                response.bytes = create_response(ResponseStatus::OK, output.str());
+            } catch (std::exception &e) {
+                response.bytes = create_response(ResponseStatus::ERROR, e.what());
+                response.failed = true;
+            }
+            task.matrix.reset();
+            task.sparse.reset();
+            task.promise.set_value(std::move(response));
+        }
+    }
+
+    int create_listener(const std::string &path) {
+        sockaddr_un address{};
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            throw std::domain_error("Socket path " + path + " is empty or too long.");
+        }
+        struct stat info{};
+        if (::lstat(path.c_str(), &info) == 0) {
+            if (!S_ISSOCK(info.st_mode)) {
+                throw std::domain_error("Path " + path + " exists and it is not a socket.");
+            }
+            ::unlink(path.c_str());
+        }
+
+        int descriptor = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (descriptor < 0) {
+            throw std::domain_error("Failed to create socket: " + std::string(std::strerror(errno)) + ".");
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+        if (::bind(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+            || ::listen(descriptor, SOMAXCONN) != 0) {
+            std::string error = std::strerror(errno);
+            ::close(descriptor);
+            throw std::domain_error("Failed to listen on " + path + ": " + error + ".");
+        }
+        return descriptor;
+    }
+
+    void close_connection(Connection &connection) {
+        connection.reader.join();
+        connection.writer.join();
+        ::close(connection.descriptor);
+    }
+
+    int parse_count(const std::string &value, int minimum, const std::string &error) {
+        int count;
+        try {
+            count = std::stoi(value);
+        } catch (std::exception &e) {
+            count = minimum - 1;
+        }
+        if (count < minimum) {
+            throw std::domain_error(error);
+        }
+        return count;
+    }
+}
+
+bool SolverServer::parse_arguments(int argc, char **argv, ServerSettings &settings) {
+    if (std::none_of(argv + 1, argv + argc, [](const char *argument) { return std::string(argument) == "--serve"; })) {
+        return false;
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::string argument(argv[i]);
+        if (argument != "--serve" && argument != "--jobs" && argument != "--threads" && argument != "--cache") {
+            throw std::domain_error("Unknown argument " + argument + ".");
+        }
+        if (i + 1 == argc) {
+            throw std::domain_error("Missing value of the argument " + argument + ".");
+        }
+        std::string value(argv[++i]);
+        if (argument == "--serve") {
+            settings.socket_path = value;
+        } else if (argument == "--jobs") {
+            settings.jobs = parse_count(value, 1, "Number of jobs has to be positive integer.");
+        } else if (argument == "--threads") {
+            settings.context.thread_count = parse_count(value, 1, "Number of threads has to be positive integer.");
+        } else {
+            settings.cache_size = parse_count(value, 0, "Size of the cache has to be non-negative integer.");
+        }
+    }
+    return true;
+}
+
+ServerReport SolverServer::run(std::ostream &ostream, const ServerSettings &settings) {
+    stop_requested = false;
+    int listener = create_listener(settings.socket_path);
+    int jobs = settings.jobs > 0 ? settings.jobs : ThreadPool::get_hardware_threads();
+    ServerState state(settings, jobs);
+
+    std::vector<std::thread> job_threads;
+    for (int i = 0; i < jobs; ++i) {
+        job_threads.emplace_back(solve_requests, std::ref(state));
+    }
+    ostream << "Listening on " << settings.socket_path << " with " << jobs << " jobs." << std::endl;
+
+    std::list<std::unique_ptr<Connection>> connections;
+    while (!stop_requested) {
+        pollfd listener_poll{listener, POLLIN, 0};
+        int ready = ::poll(&listener_poll, 1, SERVER_POLL_INTERVAL_MS);
+
+        for (auto connection = connections.begin(); connection != connections.end();) {
+            if ((*connection)->finished) {
+                close_connection(**connection);
+                connection = connections.erase(connection);
+            } else {
+                ++connection;
+            }
+        }
+
+        if (ready > 0 && (listener_poll.revents & POLLIN)) {
+            int descriptor = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (descriptor < 0) continue;
+            connections.emplace_back(new Connection(descriptor));
+            Connection &connection = *connections.back();
+            connection.reader = std::thread(read_requests, std::ref(state), std::ref(connection));
+            connection.writer = std::thread(write_responses, std::ref(state), std::ref(connection));
+        }
+    }
+
+    ostream << "Stopping the server with " << connections.size() << " open connections." << std::endl;
+    ::close(listener);
+    ::unlink(settings.socket_path.c_str());
+    // the blocked reads and writes fail, the solved requests are drained by the writers
+    for (auto &connection : connections) {
+        ::shutdown(connection->descriptor, SHUT_RDWR);
+    }
+    for (auto &connection : connections) {
+        close_connection(*connection);
+    }
+    state.tasks.close();
+    for (std::thread &job : job_threads) {
+        job.join();
+    }
+
+    ServerReport report = state.get_report();
+    print_report(ostream, report);
+    return report;
+}
+
+void SolverServer::request_stop() {
+    stop_requested = true;
+}
+
+void SolverServer::print_report(std::ostream &ostream, const ServerReport &report) {
+    ostream << "Served " << report.requests << " requests (" << report.failed_requests << " failed), latency p50 "
+            << report.p50_ms << " ms, p99 " << report.p99_ms << " ms, max " << report.max_ms << " ms." << std::endl;
+    ostream << "Factorization cache: " << report.cache_hits << " hits, " << report.cache_misses << " misses."
+            << std::endl;
+}
@@ -0,0 +1,183 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_SERVER_HPP
+#define LINEAR_SYSTEM_SOLVER_SERVER_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "solver_context.hpp"
+
+/**
+ * Constant representing the first 4 bytes of every request.
+ */
+#define REQUEST_MAGIC "LSSQ"
+
+/**
+ * Constant representing the first 4 bytes of every response.
+ */
+#define RESPONSE_MAGIC "LSSA"
+
+/**
+ * Constant representing largest accepted request payload in bytes.
+ */
+#define SERVER_MAX_REQUEST_SIZE (1ULL << 30u)
+
+/**
+ * Constant representing number of payload bytes read at once, the buffer grows only as the bytes arrive.
+ */
+#define SERVER_READ_CHUNK_SIZE (1ULL << 20u)
+
+/**
+ * Constant representing number of requests of one connection that can be parsed, solved or waiting
+ * for writing at once. The client can send further requests, they are read when the first response is written.
+ */
+#define SERVER_PIPELINE_DEPTH 4
+
+/**
+ * Constant representing number of parsed requests waiting in the queue per solving job.
+ */
+#define SERVER_QUEUE_SLOTS_PER_JOB 4
+
+/**
+ * Constant representing default number of factorizations kept for the repeated matrices.
+ */
+#define SERVER_CACHE_SIZE 16
+
+/**
+ * Constant representing how often the server checks whether it should stop, in milliseconds.
+ */
+#define SERVER_POLL_INTERVAL_MS 100
+
+/**
+ * Constant representing number of the last requests the latency percentiles are computed from.
+ */
+#define SERVER_LATENCY_WINDOW 65536
+
+/**
+ * Enumeration for the types of the requests.
+ */
+enum class RequestType : uint32_t {
+    TEXT = 0, // payload is the matrix in the txt format
+    BINARY = 1, // payload is the binary matrix file
+    STATISTICS = 2 // no payload, the response holds the latency report as text
+};
+
+/**
+ * Enumeration for the statuses of the responses.
+ */
+enum class ResponseStatus : uint32_t {
+    OK = 0, // payload is the result in the output level of the server (or the latency report)
+    ERROR = 1 // payload is the error message
+};
+
+/**
+ * Struct representing header of the request, the payload of the given length follows right after it.
+ * All numbers are little-endian.
+ */
+struct RequestHeader {
+    char magic[4];
+    RequestType type;
+    uint64_t length;
+};
+
+static_assert(sizeof(RequestHeader) == 16, "request header has to be packed");
+
+/**
+ * Struct representing header of the response, the payload of the given length follows right after it.
+ */
+struct ResponseHeader {
+    char magic[4];
+    ResponseStatus status;
+    uint64_t length;
+};
+
+static_assert(sizeof(ResponseHeader) == 16, "response header has to be packed");
+
+/**
+ * Struct representing settings of the server mode.
+ */
+struct ServerSettings {
+    /**
+     * Path of the Unix domain socket, existing socket on the path is replaced.
+     */
+    std::string socket_path;
+    /**
+     * Number of systems solved concurrently, 0 means number of hardware threads.
+     */
+    int jobs = 0;
+    /**
+     * Number of the factorizations kept for the repeated matrices A, 0 disables the cache.
+     */
+    int cache_size = SERVER_CACHE_SIZE;
+    /**
+     * Settings of the solves, the number of threads is used by each job.
+     */
+    SolverContext context;
+};
+
+/**
+ * Struct representing latency of the requests and efficiency of the factorization cache.
+ */
+struct ServerReport {
+    long long requests;
+    long long failed_requests;
+    long long cache_hits;
+    long long cache_misses;
+    /**
+     * Percentiles of the time from receiving the whole request to writing the whole response
+     * over the last SERVER_LATENCY_WINDOW requests.
+     */
+    double p50_ms;
+    double p99_ms;
+    double max_ms;
+};
+
+/**
+ * Class responsible for the long-running server solving the systems sent over the Unix domain socket.
+ * <p>
+ * Each connection sends length-prefixed requests (RequestHeader and payload) and gets the responses
+ * (ResponseHeader and payload) in the same order. The work is pipelined: the reader thread of the connection
+ * parses the next request while the jobs solve the previous ones and the writer thread of the connection
+ * writes the finished responses. The jobs, the shared thread pool and the buffer pool stay warm between
+ * the requests. Systems solved by the direct method (except the ones for FixedSizeSolver) reuse factorizations
+ * of recently seen matrices A, so only the substitution is run for the new vector b. The full output level then
+ * prints only the solution.
+ */
+class SolverServer {
+public:
+    /**
+     * Parses the command line arguments of the server mode. (--serve SOCKET [--jobs N] [--threads N] [--cache N])
+     *
+     * @param argc number of the arguments
+     * @param argv the arguments, including the program name
+     * @param settings settings to fill in
+     * @return true if the server mode was requested, throws std::domain_error for invalid arguments
+     */
+    static bool parse_arguments(int argc, char **argv, ServerSettings &settings);
+
+    /**
+     * Serves the clients until request_stop is called, then closes the connections and prints the report.
+     *
+     * @param ostream output stream for the progress and the report
+     * @param settings settings with the socket path
+     * @return ServerReport of the whole run, throws std::domain_error if the socket cannot be created
+     */
+    static ServerReport run(std::ostream &ostream, const ServerSettings &settings);
+
+    /**
+     * Asks the running server to stop, safe to call from the signal handler.
+     */
+    static void request_stop();
+
+    /**
+     * @param ostream output stream to write to
+     * @param report report to be written
+     */
+    static void print_report(std::ostream &ostream, const ServerReport &report);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_SERVER_HPP
@@ -0,0 +1,74 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_SOLVE_RESULT_HPP
+#define LINEAR_SYSTEM_SOLVER_SOLVE_RESULT_HPP
+
+#include <complex>
+#include <utility>
+#include <vector>
+
+/**
+ * Enumeration for the outcomes of the solve.
+ */
+enum class SolveStatus {
+    UNIQUE, // one solution, the kernel is trivial
+    KERNEL, // particular solution and basis of the non-trivial kernel
+    NO_SOLUTION,
+    NOT_CONVERGED // the iterative method stopped, the particular solution is the last approximation
+};
+
+/**
+ * Struct representing durations of the parts of the solve in milliseconds, parts the method
+ * does not separate are 0.
+ */
+struct SolveTimings {
+    double factor_ms = 0;
+    double substitution_ms = 0;
+    double total_ms = 0;
+};
+
+/**
+ * Struct representing the solution of the linear system found by any of the methods. SolveResult holds
+ * the solution of the double system, the other scalar types are solved only by the elimination.
+ *
+ * @tparam T type of the elements of the solution
+ */
+template<typename T>
+struct BasicSolveResult {
+    SolveStatus status = SolveStatus::NO_SOLUTION;
+    /**
+     * Rank of the matrix A, -1 if the method does not compute it.
+     */
+    int rank = -1;
+    std::vector<T> particular;
+    /**
+     * Basis of the kernel, empty if the solution is unique.
+     */
+    std::vector<std::vector<T>> kernel;
+    SolveTimings timings;
+
+    /**
+     * @return true if the particular solution (or its approximation) is set
+     */
+    bool has_solution() const {
+        return status != SolveStatus::NO_SOLUTION;
+    }
+
+    /**
+     * Sets the solution and the status UNIQUE or KERNEL according to the kernel.
+     *
+     * @param particular_solution particular solution
+     * @param kernel_basis basis of the kernel, empty if the solution is unique
+     */
+    void set_solution(std::vector<T> particular_solution, std::vector<std::vector<T>> kernel_basis = {}) {
+        particular = std::move(particular_solution);
+        kernel = std::move(kernel_basis);
+        status = kernel.empty() ? SolveStatus::UNIQUE : SolveStatus::KERNEL;
+    }
+};
+
+using SolveResult = BasicSolveResult<double>;
+
+#endif //LINEAR_SYSTEM_SOLVER_SOLVE_RESULT_HPP
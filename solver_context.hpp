@@ -0,0 +1,46 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_SOLVER_CONTEXT_HPP
+#define LINEAR_SYSTEM_SOLVER_SOLVER_CONTEXT_HPP
+
+#include "iterative_solver.hpp"
+#include "result_sink.hpp"
+#include "scalar_type.hpp"
+
+/**
+ * Enumeration for all methods the systems can be solved with.
+ */
+enum class SolverMethod {
+    DIRECT,
+    QR,
+    MIXED_PRECISION,
+    ITERATIVE
+};
+
+/**
+ * Struct representing settings of one solve. Every solve gets its own context, so concurrent solves
+ * in one process can use different settings.
+ */
+struct SolverContext {
+    /**
+     * Number of threads the solver uses for the computation, 1 means no worker threads.
+     */
+    int thread_count = 1;
+    SolverMethod method = SolverMethod::DIRECT;
+    /**
+     * Settings of the iterative method, used if method is SolverMethod::ITERATIVE.
+     */
+    IterativeSettings iterative;
+    /**
+     * Level of the output of the sinks created for the context.
+     */
+    OutputLevel output_level = OutputLevel::FULL;
+    /**
+     * Type of the elements of the systems read from the txt files which do not name it and from the command line.
+     */
+    ScalarType scalar_type = ScalarType::FLOAT64;
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_SOLVER_CONTEXT_HPP
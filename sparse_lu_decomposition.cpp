@@ -0,0 +1,185 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "sparse_lu_decomposition.hpp"
+#include "statistics.hpp"
+
+namespace {
+    /**
+     * Row of the matrix during the elimination, columns are sorted.
+     */
+    struct WorkingRow {
+        std::vector<int> columns;
+        std::vector<double> values;
+    };
+
+    /**
+     * Computes target = target - multiplier * source for the columns behind pivot_column.
+     * Columns that were not in the target before are appended to new_columns.
+     */
+    void subtract_row(WorkingRow &target, const WorkingRow &source, double multiplier, int pivot_column,
+                      WorkingRow &buffer, std::vector<int> &new_columns) {
+        buffer.columns.clear();
+        buffer.values.clear();
+        size_t i = 0;
+        size_t j = 0;
+        // the leading element of both rows is in the pivot column and it is eliminated
+        while (i < target.columns.size() && target.columns[i] <= pivot_column) i++;
+        while (j < source.columns.size() && source.columns[j] <= pivot_column) j++;
+        while (i < target.columns.size() || j < source.columns.size()) {
+            if (j == source.columns.size() || (i < target.columns.size() && target.columns[i] < source.columns[j])) {
+                buffer.columns.push_back(target.columns[i]);
+                buffer.values.push_back(target.values[i++]);
+            } else if (i == target.columns.size() || source.columns[j] < target.columns[i]) {
+                buffer.columns.push_back(source.columns[j]);
+                buffer.values.push_back(-multiplier * source.values[j++]);
+                new_columns.push_back(buffer.columns.back());
+            } else {
+                double value = target.values[i++] - multiplier * source.values[j++];
+                if (value != 0) {
+                    buffer.columns.push_back(source.columns[j - 1]);
+                    buffer.values.push_back(value);
+                }
+            }
+        }
+        std::swap(target.columns, buffer.columns);
+        std::swap(target.values, buffer.values);
+    }
+}
+
+SparseLUDecomposition::SparseLUDecomposition(const int &width, const int &height, const bool &augmented) :
+        factor_L(height, height, false), factor_U(width, height, augmented) {}
+
+int SparseLUDecomposition::rank() const {
+    return echelon.rank();
+}
+
+SparseLUDecomposition SparseLUDecomposer::decompose(const SparseMatrix &matrix) {
+    ScopedTimer timer(Phase::FACTOR);
+    const SparseMatrix csr = matrix.to_format(SparseFormat::CSR);
+    const int width = csr.width;
+    const int height = csr.height;
+    SparseLUDecomposition lu(width, height, csr.augmented);
+
+    // the tolerance follows the scale of matrix A, the pivot of vector b is tested against its own scale
+    const int rhs_column = csr.augmented ? width - 1 : -1;
+    double max_abs = 0;
+    double max_abs_all = 0;
+    for (size_t i = 0; i < csr.values.size(); ++i) {
+        const double magnitude = std::abs(csr.values[i]);
+        max_abs_all = std::max(max_abs_all, magnitude);
+        if (csr.indexes[i] != rhs_column) {
+            max_abs = std::max(max_abs, magnitude);
+        }
+    }
+    const double epsilon = std::max(width, height) * std::numeric_limits<double>::epsilon();
+    const double tolerance = epsilon * max_abs;
+    const double rhs_tolerance = epsilon * max_abs_all;
+
+    std::vector<WorkingRow> rows(height);
+    std::vector<std::vector<int>> column_rows(width);
+    for (int y = 0; y < height; ++y) {
+        rows[y].columns.assign(csr.indexes.begin() + csr.offsets[y], csr.indexes.begin() + csr.offsets[y + 1]);
+        rows[y].values.assign(csr.values.begin() + csr.offsets[y], csr.values.begin() + csr.offsets[y + 1]);
+        for (int x : rows[y].columns) {
+            column_rows[x].push_back(y);
+        }
+    }
+
+    // multipliers of each original row, (pivot index, multiplier) pairs
+    std::vector<std::vector<std::pair<int, double>>> multipliers(height);
+    std::vector<bool> eliminated(height, false);
+    std::vector<int> candidates;
+    std::vector<int> new_columns;
+    WorkingRow buffer;
+    std::vector<int> pivots_columns;
+
+    for (int x = 0; x < width && static_cast<int>(pivots_columns.size()) < height; ++x) {
+        // rows whose leading element is in this column, column_rows may hold stale or repeated rows
+        candidates.clear();
+        std::vector<int> &rows_in_column = column_rows[x];
+        std::sort(rows_in_column.begin(), rows_in_column.end());
+        rows_in_column.erase(std::unique(rows_in_column.begin(), rows_in_column.end()), rows_in_column.end());
+        double column_max = 0;
+        for (int y : rows_in_column) {
+            if (!eliminated[y] && !rows[y].columns.empty() && rows[y].columns.front() == x) {
+                candidates.push_back(y);
+                column_max = std::max(column_max, std::abs(rows[y].values.front()));
+            }
+        }
+
+        if (column_max <= (x == rhs_column ? rhs_tolerance : tolerance)) {
+            // no pivot in this column, drop the round-off so it does not appear in U
+            for (int y : candidates) {
+                rows[y].columns.erase(rows[y].columns.begin());
+                rows[y].values.erase(rows[y].values.begin());
+            }
+            std::vector<int>().swap(rows_in_column);
+            continue;
+        }
+
+        int pivot_row = -1;
+        for (int y : candidates) {
+            double magnitude = std::abs(rows[y].values.front());
+            if (magnitude < SPARSE_PIVOT_THRESHOLD * column_max) continue;
+            if (pivot_row == -1 || rows[y].columns.size() < rows[pivot_row].columns.size() ||
+                (rows[y].columns.size() == rows[pivot_row].columns.size() &&
+                 magnitude > std::abs(rows[pivot_row].values.front()))) {
+                pivot_row = y;
+            }
+        }
+
+        const int pivot_index = pivots_columns.size();
+        const WorkingRow &pivot = rows[pivot_row];
+        for (int y : candidates) {
+            if (y == pivot_row) continue;
+            double multiplier = rows[y].values.front() / pivot.values.front();
+            multipliers[y].emplace_back(pivot_index, multiplier);
+            new_columns.clear();
+            subtract_row(rows[y], pivot, multiplier, x, buffer, new_columns);
+            for (int column : new_columns) {
+                column_rows[column].push_back(y);
+            }
+        }
+
+        eliminated[pivot_row] = true;
+        lu.permutation.push_back(pivot_row);
+        pivots_columns.push_back(x);
+        std::vector<int>().swap(rows_in_column);
+    }
+
+    {
+        ScopedTimer pivot_timer(Phase::PIVOT_SEARCH);
+        lu.echelon = EchelonStructure(std::move(pivots_columns), width, csr.augmented ? width - 1 : width);
+    }
+
+    // rows without pivot follow in their original order, all their elements were eliminated
+    for (int y = 0; y < height; ++y) {
+        if (!eliminated[y]) {
+            lu.permutation.push_back(y);
+        }
+    }
+
+    for (int k = 0; k < height; ++k) {
+        int y = lu.permutation[k];
+        if (k < lu.rank()) {
+            lu.factor_U.indexes.insert(lu.factor_U.indexes.end(), rows[y].columns.begin(), rows[y].columns.end());
+            lu.factor_U.values.insert(lu.factor_U.values.end(), rows[y].values.begin(), rows[y].values.end());
+        }
+        lu.factor_U.offsets[k + 1] = lu.factor_U.indexes.size();
+        for (const auto &multiplier : multipliers[y]) {
+            lu.factor_L.indexes.push_back(multiplier.first);
+            lu.factor_L.values.push_back(multiplier.second);
+        }
+        lu.factor_L.offsets[k + 1] = lu.factor_L.indexes.size();
+        std::vector<int>().swap(rows[y].columns);
+        std::vector<double>().swap(rows[y].values);
+    }
+
+    return lu;
+}
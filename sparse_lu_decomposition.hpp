@@ -0,0 +1,65 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_SPARSE_LU_DECOMPOSITION_HPP
+#define LINEAR_SYSTEM_SOLVER_SPARSE_LU_DECOMPOSITION_HPP
+
+#include <vector>
+
+#include "sparse_matrix.hpp"
+#include "echelon_structure.hpp"
+
+/**
+ * Constant representing how much smaller than the largest element in the column the pivot can be.
+ * Among the rows passing this threshold, the sparsest one is chosen to limit the fill-in.
+ */
+#define SPARSE_PIVOT_THRESHOLD 0.1
+
+/**
+ * Struct representing result of the sparse LU decomposition (PA = LU).
+ * <p>
+ * Row k of factor_U is the k-th pivot row of the row echelon matrix U, rows behind the rank are empty.
+ * factor_L holds the multipliers of the unit lower triangular matrix L without its diagonal.
+ * Original index of the k-th row of PA is permutation[k]. The pivots of U are described by echelon.
+ */
+struct SparseLUDecomposition {
+    SparseMatrix factor_L;
+    SparseMatrix factor_U;
+    std::vector<int> permutation;
+    EchelonStructure echelon;
+
+    /**
+     * @param width width of the decomposed matrix
+     * @param height height of the decomposed matrix
+     * @param augmented true if the decomposed matrix is augmented
+     */
+    SparseLUDecomposition(const int &width, const int &height, const bool &augmented);
+
+    /**
+     * @return number of found pivots (rank of the decomposed matrix)
+     */
+    int rank() const;
+};
+
+/**
+ * Class responsible for computing the sparse LU decomposition.
+ */
+class SparseLUDecomposer {
+public:
+    /**
+     * Decomposes the given matrix with sparse Gaussian elimination.
+     * <p>
+     * Columns are eliminated in their natural order, so the pivot columns (and thus the non pivot variables)
+     * are the same as in the dense LUDecomposer. Rows are ordered by threshold Markowitz pivoting:
+     * from the rows with pivot candidate not smaller than SPARSE_PIVOT_THRESHOLD times the largest
+     * candidate, the row with the fewest non-zero elements is chosen, which keeps the fill-in low.
+     * Elements not larger than the tolerance of LUDecomposer are considered zero.
+     *
+     * @param matrix matrix to be decomposed (any format)
+     * @return SparseLUDecomposition of the given matrix
+     */
+    static SparseLUDecomposition decompose(const SparseMatrix &matrix);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_SPARSE_LU_DECOMPOSITION_HPP
@@ -0,0 +1,110 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <iomanip>
+#include <algorithm>
+
+#include "sparse_matrix.hpp"
+
+SparseMatrix::SparseMatrix(const int &width, const int &height, const bool &augmented, const SparseFormat &format) :
+        width(width), height(height), augmented(augmented), format(format),
+        offsets((format == SparseFormat::CSR ? height : width) + 1, 0) {}
+
+SparseMatrix::SparseMatrix(const Matrix &matrix, const SparseFormat &format) :
+        SparseMatrix(matrix.width, matrix.height, matrix.augmented, SparseFormat::CSR) {
+    for (int y = 0; y < height; ++y) {
+        ConstRowView row = matrix.row(y);
+        for (int x = 0; x < width; ++x) {
+            if (row[x] != 0) {
+                indexes.push_back(x);
+                values.push_back(row[x]);
+            }
+        }
+        offsets[y + 1] = indexes.size();
+    }
+    if (format == SparseFormat::CSC) {
+        *this = to_format(SparseFormat::CSC);
+    }
+}
+
+size_t SparseMatrix::non_zeros() const {
+    return values.size();
+}
+
+double SparseMatrix::density() const {
+    if (width == 0 || height == 0) return 0;
+    return static_cast<double>(non_zeros()) / (static_cast<double>(width) * height);
+}
+
+double SparseMatrix::get_field(const int &x, const int &y) const {
+    if (x >= width || y >= height) {
+        throw std::out_of_range("trying to access matrix field that does not exit!");
+    }
+    int outer = format == SparseFormat::CSR ? y : x;
+    int inner = format == SparseFormat::CSR ? x : y;
+    auto first = indexes.begin() + offsets[outer];
+    auto last = indexes.begin() + offsets[outer + 1];
+    auto it = std::lower_bound(first, last, inner);
+    return (it != last && *it == inner) ? values[it - indexes.begin()] : 0.0;
+}
+
+SparseMatrix SparseMatrix::to_format(const SparseFormat &target_format) const {
+    if (target_format == format) {
+        return *this;
+    }
+    // transposition of the storage, counting sort keeps the new inner indexes sorted
+    SparseMatrix result(width, height, augmented, target_format);
+    int outer_count = result.offsets.size() - 1;
+    for (int index : indexes) {
+        result.offsets[index + 1]++;
+    }
+    for (int i = 0; i < outer_count; ++i) {
+        result.offsets[i + 1] += result.offsets[i];
+    }
+    result.indexes.resize(non_zeros());
+    result.values.resize(non_zeros());
+    std::vector<int> next(result.offsets.begin(), result.offsets.end() - 1);
+    for (int outer = 0; outer < static_cast<int>(offsets.size()) - 1; ++outer) {
+        for (int i = offsets[outer]; i < offsets[outer + 1]; ++i) {
+            int position = next[indexes[i]]++;
+            result.indexes[position] = outer;
+            result.values[position] = values[i];
+        }
+    }
+    return result;
+}
+
+Matrix SparseMatrix::to_dense() const {
+    Matrix matrix(width, height, augmented);
+    for (int outer = 0; outer < static_cast<int>(offsets.size()) - 1; ++outer) {
+        for (int i = offsets[outer]; i < offsets[outer + 1]; ++i) {
+            if (format == SparseFormat::CSR) {
+                matrix.field(indexes[i], outer) = values[i];
+            } else {
+                matrix.field(outer, indexes[i]) = values[i];
+            }
+        }
+    }
+    return matrix;
+}
+
+std::ostream &operator<<(std::ostream &ostream, const SparseMatrix &matrix) {
+    const SparseMatrix csr = matrix.to_format(SparseFormat::CSR);
+    ostream << "Matrix:" << std::endl;
+    ostream << std::setprecision(2);
+    for (int y = 0; y < csr.height; ++y) {
+        ostream << "( ";
+        int i = csr.offsets[y];
+        for (int x = 0; x < csr.width; ++x) {
+            if (csr.augmented && x == csr.width - 1) ostream << "| ";
+            double value = 0;
+            if (i < csr.offsets[y + 1] && csr.indexes[i] == x) {
+                value = csr.values[i++];
+            }
+            ostream << value << " ";
+        }
+        ostream << ")" << std::endl;
+    }
+    return ostream;
+}
@@ -0,0 +1,92 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_SPARSE_MATRIX_HPP
+#define LINEAR_SYSTEM_SOLVER_SPARSE_MATRIX_HPP
+
+#include <iostream>
+#include <vector>
+
+#include "matrix.hpp"
+
+/**
+ * Enumeration for the compressed storage formats of the sparse matrix.
+ */
+enum class SparseFormat {
+    CSR,
+    CSC
+};
+
+/**
+ * Struct representing sparse matrix, only non-zero elements are stored.
+ * <p>
+ * In CSR format the elements of the y-th row are stored on positions offsets[y] to offsets[y + 1] - 1,
+ * indexes holds their columns. In CSC format the elements of the x-th column are stored the same way
+ * and indexes holds their rows. Indexes inside one row (column) are sorted.
+ * If augmented is set to true, than the matrix represents system of linear equations.
+ */
+struct SparseMatrix {
+    typedef double value_type;
+
+    int width;
+    int height;
+    bool augmented;
+    SparseFormat format;
+    std::vector<int> offsets;
+    std::vector<int> indexes;
+    std::vector<double> values;
+
+    /**
+     * Creates sparse matrix without any non-zero element.
+     *
+     * @param width number of vectors in the matrix
+     * @param height dimension of vectors in the matrix
+     * @param augmented true if the matrix is augmented (last column is vector b), false otherwise
+     * @param format compressed storage format
+     */
+    SparseMatrix(const int &width, const int &height, const bool &augmented,
+                 const SparseFormat &format = SparseFormat::CSR);
+
+    /**
+     * Converts dense matrix to the sparse one, zero elements are dropped.
+     *
+     * @param matrix dense matrix to be converted
+     * @param format compressed storage format
+     */
+    explicit SparseMatrix(const Matrix &matrix, const SparseFormat &format = SparseFormat::CSR);
+
+    /**
+     * @return number of stored (non-zero) elements
+     */
+    size_t non_zeros() const;
+
+    /**
+     * @return ratio of non-zero elements to all elements of the matrix
+     */
+    double density() const;
+
+    /**
+     * @param x index of the column in which the field is (zero based)
+     * @param y index of the row in which the field is (zero based)
+     * @return element on [x,y] coords in the matrix
+     */
+    double get_field(const int &x, const int &y) const;
+
+    /**
+     * Converts the matrix to the given storage format.
+     *
+     * @param target_format format of the returned matrix
+     * @return SparseMatrix with the same elements in the given format
+     */
+    SparseMatrix to_format(const SparseFormat &target_format) const;
+
+    /**
+     * @return dense Matrix with the same elements
+     */
+    Matrix to_dense() const;
+};
+
+std::ostream &operator<<(std::ostream &ostream, const SparseMatrix &matrix);
+
+#endif //LINEAR_SYSTEM_SOLVER_SPARSE_MATRIX_HPP
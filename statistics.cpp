@@ -0,0 +1,172 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <iomanip>
+#include <stdexcept>
+
+#include "statistics.hpp"
+
+std::atomic<bool> Statistics::ENABLED{false}; // statistics are not recorded as default
+StatisticsFormat Statistics::FORMAT = StatisticsFormat::NONE;
+
+namespace {
+    /**
+     * Struct representing the recorded values, each of them is updated atomically.
+     */
+    struct StatisticsState {
+        std::atomic<long long> calls[STATISTICS_PHASE_COUNT];
+        std::atomic<long long> total_ns[STATISTICS_PHASE_COUNT];
+        std::atomic<long long> max_ns[STATISTICS_PHASE_COUNT];
+        std::atomic<long long> counters[STATISTICS_COUNTER_COUNT];
+
+        StatisticsState() {
+            for (int i = 0; i < STATISTICS_PHASE_COUNT; ++i) {
+                calls[i] = 0;
+                total_ns[i] = 0;
+                max_ns[i] = 0;
+            }
+            for (auto &counter : counters) {
+                counter = 0;
+            }
+        }
+    };
+
+    /**
+     * The state is intentionally never destroyed, so the timers running during static destruction are still valid.
+     */
+    StatisticsState &get_state() {
+        static auto *state = new StatisticsState();
+        return *state;
+    }
+}
+
+void Statistics::set_enabled(bool enabled) {
+    ENABLED = enabled;
+}
+
+void Statistics::reset() {
+    StatisticsState &state = get_state();
+    for (int i = 0; i < STATISTICS_PHASE_COUNT; ++i) {
+        state.calls[i] = 0;
+        state.total_ns[i] = 0;
+        state.max_ns[i] = 0;
+    }
+    for (auto &counter : state.counters) {
+        counter = 0;
+    }
+}
+
+void Statistics::record(const Phase &phase, long long nanoseconds) {
+    StatisticsState &state = get_state();
+    auto i = static_cast<int>(phase);
+    state.calls[i].fetch_add(1, std::memory_order_relaxed);
+    state.total_ns[i].fetch_add(nanoseconds, std::memory_order_relaxed);
+    long long max_ns = state.max_ns[i].load(std::memory_order_relaxed);
+    while (nanoseconds > max_ns && !state.max_ns[i].compare_exchange_weak(max_ns, nanoseconds)) {}
+}
+
+void Statistics::add_enabled(const Counter &counter, long long value) {
+    get_state().counters[static_cast<int>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+StatisticsSnapshot Statistics::get_snapshot() {
+    StatisticsState &state = get_state();
+    StatisticsSnapshot snapshot{};
+    for (int i = 0; i < STATISTICS_PHASE_COUNT; ++i) {
+        snapshot.phases[i] = {state.calls[i], state.total_ns[i], state.max_ns[i]};
+    }
+    for (int i = 0; i < STATISTICS_COUNTER_COUNT; ++i) {
+        snapshot.counters[i] = state.counters[i];
+    }
+    return snapshot;
+}
+
+std::string Statistics::get_name(const Phase &phase) {
+    switch (phase) {
+        case Phase::PARSE:
+            return "parse";
+        case Phase::COPY:
+            return "copy";
+        case Phase::FACTOR:
+            return "factor";
+        case Phase::PIVOT_SEARCH:
+            return "pivot_search";
+        case Phase::SUBSTITUTION:
+            return "substitution";
+        case Phase::OUTPUT:
+            return "output";
+    }
+    return "unknown";
+}
+
+std::string Statistics::get_name(const Counter &counter) {
+    switch (counter) {
+        case Counter::ALLOCATIONS:
+            return "allocations";
+        case Counter::SYSTEM_ALLOCATIONS:
+            return "system_allocations";
+        case Counter::BYTES_ALLOCATED:
+            return "bytes_allocated";
+        case Counter::BYTES_COPIED:
+            return "bytes_copied";
+        case Counter::ROW_SWAPS:
+            return "row_swaps";
+    }
+    return "unknown";
+}
+
+bool Statistics::parse_argument(const std::string &argument) {
+    const std::string prefix = "--stats=";
+    if (argument.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    std::string format = argument.substr(prefix.size());
+    if (format == "json") {
+        FORMAT = StatisticsFormat::JSON;
+    } else if (format == "text") {
+        FORMAT = StatisticsFormat::TEXT;
+    } else {
+        throw std::domain_error("Unknown statistics format " + format + ", use json or text.");
+    }
+    set_enabled(true);
+    return true;
+}
+
+void Statistics::print(std::ostream &ostream, const StatisticsSnapshot &snapshot) {
+    if (FORMAT == StatisticsFormat::JSON) {
+        print_json(ostream, snapshot);
+    } else if (FORMAT == StatisticsFormat::TEXT) {
+        print_text(ostream, snapshot);
+    }
+}
+
+void Statistics::print_json(std::ostream &ostream, const StatisticsSnapshot &snapshot) {
+    ostream << "{\"phases\": {";
+    for (int i = 0; i < STATISTICS_PHASE_COUNT; ++i) {
+        const PhaseStatistics &phase = snapshot.phases[i];
+        ostream << (i == 0 ? "" : ", ") << "\"" << get_name(static_cast<Phase>(i)) << "\": {\"calls\": "
+                << phase.calls << ", \"total_ns\": " << phase.total_ns << ", \"max_ns\": " << phase.max_ns << "}";
+    }
+    ostream << "}, \"counters\": {";
+    for (int i = 0; i < STATISTICS_COUNTER_COUNT; ++i) {
+        ostream << (i == 0 ? "" : ", ") << "\"" << get_name(static_cast<Counter>(i)) << "\": "
+                << snapshot.counters[i];
+    }
+    ostream << "}}" << std::endl;
+}
+
+void Statistics::print_text(std::ostream &ostream, const StatisticsSnapshot &snapshot) {
+    std::streamsize precision = ostream.precision();
+    ostream << "phase\tcalls\ttotal_us\tmax_us" << std::endl;
+    ostream << std::fixed << std::setprecision(3);
+    for (int i = 0; i < STATISTICS_PHASE_COUNT; ++i) {
+        const PhaseStatistics &phase = snapshot.phases[i];
+        ostream << get_name(static_cast<Phase>(i)) << "\t" << phase.calls << "\t" << phase.total_ns / 1e3
+                << "\t" << phase.max_ns / 1e3 << std::endl;
+    }
+    ostream << std::defaultfloat << std::setprecision(precision);
+    for (int i = 0; i < STATISTICS_COUNTER_COUNT; ++i) {
+        ostream << get_name(static_cast<Counter>(i)) << "\t" << snapshot.counters[i] << std::endl;
+    }
+}
@@ -0,0 +1,210 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_STATISTICS_HPP
+#define LINEAR_SYSTEM_SOLVER_STATISTICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+/**
+ * Constant representing number of the measured phases (values of Phase).
+ */
+#define STATISTICS_PHASE_COUNT 6
+
+/**
+ * Constant representing number of the counters (values of Counter).
+ */
+#define STATISTICS_COUNTER_COUNT 5
+
+/**
+ * Enumeration for the measured phases of the solve. Phases can nest, the copy of the matrix
+ * done while parsing is counted in both phases.
+ */
+enum class Phase {
+    PARSE = 0,
+    COPY = 1,
+    FACTOR = 2,
+    PIVOT_SEARCH = 3,
+    SUBSTITUTION = 4, // one call for each substitution task
+    OUTPUT = 5
+};
+
+/**
+ * Enumeration for the counted events.
+ */
+enum class Counter {
+    ALLOCATIONS = 0, // buffers requested from BufferPool
+    SYSTEM_ALLOCATIONS = 1, // buffers BufferPool had to allocate from the system
+    BYTES_ALLOCATED = 2,
+    BYTES_COPIED = 3,
+    ROW_SWAPS = 4
+};
+
+/**
+ * Enumeration for the formats the statistics are printed in.
+ */
+enum class StatisticsFormat {
+    NONE,
+    TEXT,
+    JSON
+};
+
+/**
+ * Struct representing measured time of one phase.
+ */
+struct PhaseStatistics {
+    long long calls;
+    long long total_ns;
+    long long max_ns;
+};
+
+/**
+ * Struct representing copy of all statistics at one moment.
+ */
+struct StatisticsSnapshot {
+    PhaseStatistics phases[STATISTICS_PHASE_COUNT];
+    long long counters[STATISTICS_COUNTER_COUNT];
+};
+
+/**
+ * Class responsible for collecting the timings of the phases and the counters of the whole program.
+ * <p>
+ * The statistics are global and safe to update from many threads. When they are disabled (default),
+ * the timers and counters only check one flag, so they can stay in the hot paths.
+ */
+class Statistics {
+private:
+    static std::atomic<bool> ENABLED;
+
+    /**
+     * Adds the value to the counter, called only when the statistics are enabled.
+     */
+    static void add_enabled(const Counter &counter, long long value);
+
+public:
+    /**
+     * Format the statistics are printed in after each solve, NONE if they are not printed.
+     */
+    static StatisticsFormat FORMAT;
+
+    /**
+     * @return true if the timers and counters record
+     */
+    static bool is_enabled() {
+        return ENABLED.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @param enabled true to start recording, false to stop it, recorded values are kept
+     */
+    static void set_enabled(bool enabled);
+
+    /**
+     * Sets all timings and counters to zero.
+     */
+    static void reset();
+
+    /**
+     * Adds the time of one call of the phase.
+     *
+     * @param phase measured phase
+     * @param nanoseconds duration of the call
+     */
+    static void record(const Phase &phase, long long nanoseconds);
+
+    /**
+     * Adds the value to the counter if the statistics are enabled.
+     *
+     * @param counter counter to be increased
+     * @param value value to be added
+     */
+    static void add(const Counter &counter, long long value = 1) {
+        if (is_enabled()) {
+            add_enabled(counter, value);
+        }
+    }
+
+    /**
+     * @return StatisticsSnapshot with current values of all timings and counters
+     */
+    static StatisticsSnapshot get_snapshot();
+
+    /**
+     * @param phase phase to get name of
+     * @return name of the phase used in the output
+     */
+    static std::string get_name(const Phase &phase);
+
+    /**
+     * @param counter counter to get name of
+     * @return name of the counter used in the output
+     */
+    static std::string get_name(const Counter &counter);
+
+    /**
+     * Parses the command line argument --stats=FORMAT (json or text), sets FORMAT and enables the statistics.
+     *
+     * @param argument the argument
+     * @return true if the argument was --stats, throws std::domain_error for unknown format
+     */
+    static bool parse_argument(const std::string &argument);
+
+    /**
+     * Prints the snapshot in the FORMAT, nothing is printed for NONE.
+     *
+     * @param ostream output stream to write to
+     * @param snapshot statistics to be printed
+     */
+    static void print(std::ostream &ostream, const StatisticsSnapshot &snapshot);
+
+    /**
+     * Prints the snapshot as one JSON object on one line, the times are in nanoseconds.
+     *
+     * @param ostream output stream to write to
+     * @param snapshot statistics to be printed
+     */
+    static void print_json(std::ostream &ostream, const StatisticsSnapshot &snapshot);
+
+    /**
+     * Prints the snapshot as table, the times are in microseconds.
+     *
+     * @param ostream output stream to write to
+     * @param snapshot statistics to be printed
+     */
+    static void print_text(std::ostream &ostream, const StatisticsSnapshot &snapshot);
+};
+
+/**
+ * Class responsible for measuring one call of the phase, the time from the construction to the destruction
+ * is recorded. Nothing is measured if the statistics are disabled at the construction.
+ */
+class ScopedTimer {
+private:
+    Phase phase;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(const Phase &phase) : phase(phase), active(Statistics::is_enabled()) {
+        if (active) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    ~ScopedTimer() {
+        if (active) {
+            auto duration = std::chrono::steady_clock::now() - start;
+            Statistics::record(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+    }
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_STATISTICS_HPP
@@ -3,219 +3,532 @@
 //
 
 #include "system_solver.hpp"
-#include "command.hpp"
+#include "thread_pool.hpp"
+#include "gemm.hpp"
+#include "sparse_lu_decomposition.hpp"
+#include "mixed_precision_solver.hpp"
+#include "fixed_matrix.hpp"
+#include "statistics.hpp"
 #include <algorithm>
-#include <stack>
 #include <chrono>
-#include <future>
-
-void SystemSolver::shuffle_zero_rows(Matrix &matrix) {
-    for (int y = matrix.height - 1; y >= 0; --y) {
-        if (matrix.get_field(0, 0) == 0) {
-            std::vector<double> temp_first_row = matrix.get_row(0);
-            matrix.set_row(0, matrix.get_row(y));
-            matrix.set_row(y, temp_first_row);
-        } else {
-            break;
-        }
+#include <cmath>
+#include <memory>
+
+LUDecomposition SystemSolver::decompose_lu(const Matrix &matrix, const SolverContext &context) {
+    return LUDecomposer::decompose(matrix, context.thread_count);
+}
+
+SolveResult SystemSolver::solve_with_method(const Matrix &matrix, const SolverContext &context) {
+    std::unique_ptr<ResultSink> sink = ResultSink::create(OutputLevel::QUIET, std::cout);
+    return solve_with_method(*sink, matrix, context);
+}
+
+SolveResult SystemSolver::solve_with_method(ResultSink &sink, const Matrix &matrix, const SolverContext &context) {
+    if (context.method == SolverMethod::ITERATIVE) {
+        return solve_iterative(sink, matrix, context);
+    } else if (context.method == SolverMethod::QR) {
+        return solve_qr(sink, matrix, context);
+    } else if (context.method == SolverMethod::MIXED_PRECISION) {
+        return solve_mixed_precision(sink, matrix, context);
     }
+    return solve(sink, matrix, context);
 }
 
-std::pair<Matrix, Matrix> SystemSolver::decompose_lu(const Matrix &matrix) {
-    Matrix matrix_cpy = matrix;
-    shuffle_zero_rows(matrix_cpy);
+SolveResult SystemSolver::solve_with_method(ResultSink &sink, const SparseMatrix &matrix,
+                                            const SolverContext &context) {
+    if (context.method == SolverMethod::DIRECT) {
+        return solve(sink, matrix, context);
+    } else if (context.method == SolverMethod::ITERATIVE) {
+        return solve_iterative(sink, matrix, context);
+    }
+    return solve_with_method(sink, matrix.to_dense(), context);
+}
 
-    int n = matrix_cpy.height;
-    // upper triangular matrix
-    Matrix matrix_U = matrix_cpy;
-    // lower triangular matrix (square)
-    Matrix matrix_L = MatrixCreator::get_identity(n);
-    // permutation matrix (square)
-    Matrix matrix_P = MatrixCreator::get_identity(n);
-    int pivot_row_index = 0;
+SolveResult SystemSolver::solve(ResultSink &sink, const Matrix &matrix, const SolverContext &context) {
+    if (matrix.size() >= SPARSE_SIZE_THRESHOLD) {
+        size_t non_zeros = std::count_if(matrix.data, matrix.data + matrix.size(), [](double e) { return e != 0; });
+        if (non_zeros < SPARSE_DENSITY_THRESHOLD * matrix.size()) {
+            return solve(sink, SparseMatrix(matrix), context);
+        }
+    }
 
-    for (int i = 0; i < matrix_cpy.width; ++i) {
-        if (pivot_row_index < n) {
-            int current_pivot = pivot_row_index;
+    // capture time on start
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ostream *details = sink.get_details();
+
+    if (details) {
+        ScopedTimer timer(Phase::OUTPUT);
+        *details << "Solving matrix:" << std::endl << matrix;
+    } else if (FixedSizeSolver::is_supported(matrix)) {
+        // small regular systems are solved by the unrolled kernels, the singular ones go on with the elimination
+        SolveResult result;
+        if (FixedSizeSolver::solve(matrix, result.particular)) {
+            result.rank = matrix.height;
+            result.set_solution(std::move(result.particular));
+            auto end = std::chrono::high_resolution_clock::now();
+            result.timings.factor_ms = to_fractional_ms(end - start);
+            sink.write_result(result);
+            result.timings.total_ms = to_fractional_ms(std::chrono::high_resolution_clock::now() - start);
+            sink.write_time(to_ms(end - start).count());
+            return result;
+        }
+    }
 
-            if (matrix_U.get_field(i, pivot_row_index) == 0) {
+    // the decomposition knows where its pivots are, U does not have to be searched for them
+    LUDecomposition lu = decompose_lu(matrix, context);
+    auto factored = std::chrono::high_resolution_clock::now();
+    SolveResult result;
+    if (details) {
+        Matrix matrix_U = lu.get_upper();
+        matrix_U.augmented = true;
+        {
+            ScopedTimer timer(Phase::OUTPUT);
+            *details << "Upper triangular matrix:" << std::endl << matrix_U;
+            *details << "Pivots are on columns:" << std::endl << lu.echelon.pivots_columns;
+            *details << "Pivots are on rows:" << std::endl << lu.echelon.pivots_rows;
+        }
+        factored = std::chrono::high_resolution_clock::now();
+        result = solve_echelon(matrix_U, lu.echelon, context);
+    } else {
+        // rows of U in the compact factors are right of their pivots, the substitution does not read the rest
+        result = solve_echelon(lu.factors, lu.echelon, context);
+    }
+    auto substituted = std::chrono::high_resolution_clock::now();
+    result.timings.factor_ms = to_fractional_ms(factored - start);
+    result.timings.substitution_ms = to_fractional_ms(substituted - factored);
+    sink.write_result(result);
 
-                for (int k = pivot_row_index + 1; k < n && current_pivot == pivot_row_index; ++k) {
-                    if (matrix_U.get_field(i, k) != 0) {
-                        current_pivot = k;
-                    }
-                }
+    // capture time on end and print the time result
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
+}
 
-                if (current_pivot != pivot_row_index) {
-                    Matrix S = MatrixCreator::get_identity(n);
+template<typename T>
+BasicSolveResult<T> SystemSolver::solve_with_method(const BasicMatrix<T> &matrix, const SolverContext &context) {
+    std::unique_ptr<ResultSink> sink = ResultSink::create(OutputLevel::QUIET, std::cout);
+    return solve_with_method(*sink, matrix, context);
+}
 
-                    S.foreach_field([&pivot_row_index, &current_pivot, &S](int x, int y, double e) {
-                        return (y == pivot_row_index) ?
-                               S.get_field(x, current_pivot) :
-                               ((y == current_pivot) ? S.get_field(x, pivot_row_index) : e);
-                    });
+template<typename T>
+BasicSolveResult<T> SystemSolver::solve_with_method(ResultSink &sink, const BasicMatrix<T> &matrix,
+                                                    const SolverContext &context) {
+    if (context.method != SolverMethod::DIRECT) {
+        sink.write_message("Only the elimination supports elements of type "
+                           + ScalarTypes::get_name(ScalarTraits<T>::get_type()) + ", solving with it.");
+    }
+    return solve(sink, matrix, context);
+}
 
-                    matrix_U = S * matrix_U;
-                    matrix_L = S * (matrix_L - MatrixCreator::get_identity(n)) + MatrixCreator::get_identity(n);
-                    matrix_P = matrix_P * S;
-                }
-            } else {
-                Matrix L = MatrixCreator::get_identity(n);
+template<typename T>
+BasicSolveResult<T> SystemSolver::solve(ResultSink &sink, const BasicMatrix<T> &matrix,
+                                        const SolverContext &context) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ostream *details = sink.get_details();
 
-                L.foreach_field([&pivot_row_index, &matrix_U, &i](int x, int y, double e) {
-                    return (x == pivot_row_index && y >= pivot_row_index + 1) ?
-                           -(matrix_U.get_field(i, y) / matrix_U.get_field(i, pivot_row_index)) : e;
-                });
+    if (details) {
+        ScopedTimer timer(Phase::OUTPUT);
+        *details << "Solving matrix:" << std::endl << matrix;
+    }
 
-                matrix_U = L * matrix_U;
-                matrix_L = matrix_L * L;
-                pivot_row_index++;
-            }
+    BasicLUDecomposition<T> lu = LUDecomposer::decompose(matrix);
+    auto factored = std::chrono::high_resolution_clock::now();
+    BasicSolveResult<T> result;
+    if (details) {
+        BasicMatrix<T> matrix_U = lu.get_upper();
+        matrix_U.augmented = true;
+        {
+            ScopedTimer timer(Phase::OUTPUT);
+            *details << "Upper triangular matrix:" << std::endl << matrix_U;
+            *details << "Pivots are on columns:" << std::endl << lu.echelon.pivots_columns;
+            *details << "Pivots are on rows:" << std::endl << lu.echelon.pivots_rows;
         }
+        factored = std::chrono::high_resolution_clock::now();
+        result = solve_echelon(matrix_U, lu.echelon, context);
+    } else {
+        result = solve_echelon(lu.factors, lu.echelon, context);
     }
+    auto substituted = std::chrono::high_resolution_clock::now();
+    result.timings.factor_ms = to_fractional_ms(factored - start);
+    result.timings.substitution_ms = to_fractional_ms(substituted - factored);
+    sink.write_result(result);
 
-    matrix_L.foreach_field([](int x, int y, double e) {
-        return (x == y) ? e : -e;
-    });
-
-    return std::make_pair(matrix_L, matrix_U);
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
 }
 
-void SystemSolver::solve(std::ostream &ostream, const Matrix &matrix) {
-    // capture time on start
+SolveResult SystemSolver::solve(ResultSink &sink, const SparseMatrix &matrix, const SolverContext &context) {
     auto start = std::chrono::high_resolution_clock::now();
+    std::ostream *details = sink.get_details();
+
+    if (details) {
+        ScopedTimer timer(Phase::OUTPUT);
+        *details << "Solving sparse matrix with " << matrix.non_zeros() << " non-zero elements:" << std::endl
+                 << matrix;
+    }
+
+    SparseLUDecomposition lu = SparseLUDecomposer::decompose(matrix);
+    lu.factor_U.augmented = true;
+
+    if (details) {
+        ScopedTimer timer(Phase::OUTPUT);
+        *details << "Upper triangular matrix:" << std::endl << lu.factor_U;
+        *details << "Pivots are on columns:" << std::endl << lu.echelon.pivots_columns;
+        *details << "Pivots are on rows:" << std::endl << lu.echelon.pivots_rows;
+    }
+
+    auto factored = std::chrono::high_resolution_clock::now();
+    SolveResult result = solve_echelon(lu.factor_U, lu.echelon, context);
+    auto substituted = std::chrono::high_resolution_clock::now();
+    result.timings.factor_ms = to_fractional_ms(factored - start);
+    result.timings.substitution_ms = to_fractional_ms(substituted - factored);
+    sink.write_result(result);
 
-    ostream << "Solving matrix:" << std::endl << matrix;
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
+}
 
-    Matrix matrix_U = decompose_lu(matrix).second;
-    matrix_U.augmented = true;
+SolveResult SystemSolver::solve_iterative(ResultSink &sink, const Matrix &matrix, const SolverContext &context) {
+    return solve_iterative_matrix(sink, matrix, context);
+}
 
-    ostream << "Upper triangular matrix:" << std::endl << matrix_U;
+SolveResult SystemSolver::solve_iterative(ResultSink &sink, const SparseMatrix &matrix,
+                                          const SolverContext &context) {
+    return solve_iterative_matrix(sink, matrix, context);
+}
 
-    // find pivot indexes
-    std::pair<std::vector<double>, std::vector<double>> pivot_indexes = get_pivot_indexes(matrix_U);
-    std::vector<double> pivots_column_indexes = pivot_indexes.first;
-    std::vector<double> pivots_row_indexes = pivot_indexes.second;
+template<typename MatrixType>
+SolveResult SystemSolver::solve_iterative_matrix(ResultSink &sink, const MatrixType &matrix,
+                                                 const SolverContext &context) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ostream *details = sink.get_details();
+    const IterativeSettings &settings = context.iterative;
 
-    ostream << "Pivots are on columns:" << std::endl << pivots_column_indexes;
-    ostream << "Pivots are on rows:" << std::endl << pivots_row_indexes;
+    if (details) {
+        *details << "Solving matrix with " << IterativeSolver::get_method_name(settings.method) << " method and "
+                 << IterativeSolver::get_preconditioner_name(settings.preconditioner) << " preconditioner:"
+                 << std::endl << matrix;
+    }
 
-    bool solution_exists =
-            std::find(pivots_column_indexes.begin(), pivots_column_indexes.end(), matrix_U.width - 1) ==
-            pivots_column_indexes.end();
+    IterativeResult iterative = IterativeSolver::solve(matrix, settings);
 
-    if (!solution_exists) {
-        ostream << "Given linear system has no solution." << std::endl;
+    if (iterative.converged) {
+        sink.write_message("Converged after " + std::to_string(iterative.iterations) + " iterations.");
     } else {
-        ostream << "Solution of the linear system:" << std::endl;
-
-        std::vector<double> vector_p;
-        std::vector<std::vector<double>> kernel;
-        int rank = pivots_column_indexes.size();
-        int defect = matrix_U.width - 1 - rank;
-        std::vector<double> vector_b = matrix_U.get_column(matrix_U.width - 1);
-
-        if (!CommandInterpreter::USING_MULTIPLE_THREADS) {
-            // find particular solution
-            vector_p = backward_substitution(matrix_U, vector_b, pivots_column_indexes, pivots_row_indexes);
-
-            // find kernel if needed (defect > 0)
-            for (int j = 0; j < defect; ++j) {
-                std::vector<double> kernel_basis_vector =
-                        backward_substitution(matrix_U, std::vector<double>(matrix_U.height, 0.0),
-                                              pivots_column_indexes, pivots_row_indexes, j);
-                kernel.push_back(kernel_basis_vector);
-            }
-        } else {
-            // find particular solution
-            auto vector_p_fut =
-                    std::async(std::launch::async, &backward_substitution, matrix_U, vector_b,
-                               pivots_column_indexes, pivots_row_indexes, -1);
-
-            // find kernel if needed (defect > 0)
-            std::vector<std::future<std::vector<double>>> kernel_fut;
-            kernel_fut.reserve(defect);
-            for (int j = 0; j < defect; ++j) {
-                kernel_fut.emplace_back(
-                        std::async(std::launch::async, &backward_substitution, matrix_U,
-                                   std::vector<double>(matrix_U.height, 0.0),
-                                   pivots_column_indexes, pivots_row_indexes, j));
-            }
+        sink.write_message("Did not converge in " + std::to_string(iterative.iterations) + " iterations.");
+    }
+    if (details) {
+        *details << "Relative residual history:" << std::endl << iterative.residual_history;
+    }
 
-            // get all results from futures
-            vector_p = vector_p_fut.get();
-            for (std::future<std::vector<double>> &k : kernel_fut) {
-                kernel.push_back(k.get());
-            }
-        }
+    SolveResult result;
+    result.set_solution(std::move(iterative.solution));
+    if (!iterative.converged) {
+        result.status = SolveStatus::NOT_CONVERGED;
+    }
+    sink.write_result(result);
 
-        // print the solution
-        if (!kernel.empty()) {
-            ostream << "Particular solution is:" << std::endl;
-            ostream << vector_p;
-            ostream << "Basis of the kernel is:" << std::endl;
-            for (const auto &i : kernel) {
-                ostream << i;
-            }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
+}
+
+SolveResult SystemSolver::solve_qr(ResultSink &sink, const Matrix &matrix, const SolverContext &context) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ostream *details = sink.get_details();
+
+    if (details) {
+        ScopedTimer timer(Phase::OUTPUT);
+        *details << "Solving matrix with QR decomposition with column pivoting:" << std::endl << matrix;
+    }
+
+    QRSolution solution = QRDecomposer::solve(matrix, context.thread_count);
+
+    if (details) {
+        *details << "Rank of the matrix is " << solution.rank << "." << std::endl;
+    }
+    SolveResult result;
+    result.rank = solution.rank;
+    if (solution.solution_exists) {
+        result.set_solution(std::move(solution.particular), std::move(solution.kernel));
+    }
+    sink.write_result(result);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
+}
+
+SolveResult SystemSolver::solve_mixed_precision(ResultSink &sink, const Matrix &matrix,
+                                                const SolverContext &context) {
+    if (!MixedPrecisionSolver::is_supported(matrix)) {
+        sink.write_message("Mixed precision needs square matrix of the system, solving in double precision.");
+        return solve(sink, matrix, context);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ostream *details = sink.get_details();
+
+    if (details) {
+        *details << "Solving matrix with mixed precision LU:" << std::endl << matrix;
+    }
+
+    SolveResult result;
+    try {
+        RefinementResult refinement = MixedPrecisionSolver::solve(matrix, context.thread_count);
+        if (refinement.used_fallback) {
+            sink.write_message("Refinement stalled after " + std::to_string(refinement.refinement_steps) +
+                               " steps, solved in double precision.");
         } else {
-            ostream << "Unique solution is:" << std::endl;
-            ostream << vector_p;
+            sink.write_message("Refinement converged after " + std::to_string(refinement.refinement_steps) +
+                               " steps.");
         }
+        result.rank = matrix.height;
+        result.set_solution(std::move(refinement.solution));
+    } catch (std::domain_error &e) {
+        // singular matrix, the elimination finds the kernel or tells there is no solution
+        sink.write_message("Matrix of the system is singular, solving with elimination.");
+        return solve(sink, matrix, context);
     }
+    sink.write_result(result);
 
-    // capture time on end and print the time result
     auto end = std::chrono::high_resolution_clock::now();
-    ostream << "Needed " << to_ms(end - start).count() << " ms to finish." << std::endl;
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
 }
 
-std::vector<double>
-SystemSolver::backward_substitution(const Matrix &matrix_U, const std::vector<double> &result_vector,
-                                    const std::vector<double> &pivots_column_indexes,
-                                    const std::vector<double> &pivots_row_indexes,
-                                    const int &j) {
+SolveResult SystemSolver::solve_out_of_core(ResultSink &sink, const std::string &binary_path,
+                                            const OutOfCoreSettings &settings) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ostream *details = sink.get_details();
 
-    int rank = pivots_column_indexes.size();
-    int defect = matrix_U.width - 1 - rank;
-    std::stack<double, std::vector<double>> rows_indexes = std::stack<double, std::vector<double>>(pivots_row_indexes);
-    std::vector<double> e(defect, 0.0);
-    if (j > -1) {
-        e[j] = 1;
+    if (details) {
+        *details << "Solving system from " << binary_path << " out of core:" << std::endl;
+    }
+    OutOfCoreResult out_of_core = OutOfCoreSolver::solve(binary_path, settings);
+    if (details) {
+        *details << "Used " << out_of_core.tile_rows << " x " << out_of_core.tile_columns << " tiles of size "
+                 << out_of_core.tile_size << ", read " << (out_of_core.bytes_read >> 20u) << " MB and written "
+                 << (out_of_core.bytes_written >> 20u) << " MB." << std::endl;
     }
-    std::vector<double> vector_x(matrix_U.width - 1);
-    int last_non_used_e_row = e.size() - 1;
 
-    for (int i = matrix_U.width - 2; i >= 0; i--) {
+    SolveResult result;
+    result.rank = out_of_core.solution.size();
+    result.set_solution(std::move(out_of_core.solution));
+    sink.write_result(result);
 
-        if (std::find(pivots_column_indexes.begin(), pivots_column_indexes.end(), i) ==
-            pivots_column_indexes.end()) {
-            vector_x[i] = e[last_non_used_e_row--];
-            continue;
-        }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
+}
 
-        double sum = 0;
-        for (int k = vector_x.size() - 1; k >= i; k--) {
-            sum += (matrix_U.get_field(k, rows_indexes.top()) * vector_x[k]);
-        }
+template<typename MatrixType>
+BasicSolveResult<typename MatrixType::value_type>
+SystemSolver::solve_echelon(const MatrixType &matrix_U, const EchelonStructure &echelon,
+                            const SolverContext &context) {
+    typedef typename MatrixType::value_type T;
+    BasicSolveResult<T> result;
+    if (!echelon.has_solution()) {
+        // pivot in vector b is not part of the rank of A
+        result.rank = echelon.rank() - 1;
+        return result;
+    }
+    result.rank = echelon.rank();
 
-        vector_x[i] = (result_vector[rows_indexes.top()] - sum) / matrix_U.get_field(i, rows_indexes.top());
-        rows_indexes.pop();
+    const int rank = echelon.rank();
+    const int defect = echelon.defect();
+
+    // column 0 of the solutions is particular solution, column j + 1 is j-th kernel basis vector (defect > 0)
+    BasicMatrix<T> solutions(defect + 1, matrix_U.width - 1, false);
+    BasicMatrix<T> rhs(defect + 1, rank, false);
+    for (int k = 0; k < rank; ++k) {
+        rhs.field(0, k) = matrix_U.get_field(matrix_U.width - 1, k);
+    }
+    for (int j = 0; j < defect; ++j) {
+        solutions.field(j + 1, echelon.free_columns[j]) = 1;
     }
 
-    return vector_x;
+    auto substitute = [&](int begin, int end) {
+        backward_substitution(matrix_U, echelon, rhs, solutions, begin, end);
+    };
+
+    // one right-hand side needs about width * rank operations, small systems stay on the calling thread
+    long long task_work = static_cast<long long>(matrix_U.width) * std::max(rank, 1);
+    if (context.thread_count <= 1 || (defect + 1) * task_work < PARALLEL_WORK_THRESHOLD) {
+        substitute(0, defect + 1);
+    } else {
+        // the calling thread takes part in the computation as well
+        int grain = std::max(1LL, PARALLEL_WORK_THRESHOLD / task_work);
+        ThreadPool::get_shared(context.thread_count - 1)->parallel_for(0, defect + 1, grain, substitute);
+    }
+
+    std::vector<std::vector<T>> kernel;
+    kernel.reserve(defect);
+    for (int j = 0; j < defect; ++j) {
+        kernel.push_back(solutions.get_column(j + 1));
+    }
+    result.set_solution(solutions.get_column(0), std::move(kernel));
+    return result;
 }
 
-std::pair<std::vector<double>, std::vector<double>> SystemSolver::get_pivot_indexes(const Matrix &matrix_U) {
-    std::vector<double> pivots_column_indexes;
-    std::vector<double> pivots_row_indexes;
-    for (int x = 0; x < matrix_U.width; ++x) {
-        for (int y = matrix_U.height - 1; y >= 0; --y) {
-            if (std::find(pivots_row_indexes.begin(), pivots_row_indexes.end(), y) == pivots_row_indexes.end() &&
-                matrix_U.get_field(x, y) != 0) {
-                pivots_column_indexes.push_back(x);
-                pivots_row_indexes.push_back(y);
-                break;
+Factorization SystemSolver::factor(const Matrix &matrix, const SolverContext &context) {
+    Matrix matrix_A = matrix.augmented ? matrix.get_matrix_A() : matrix;
+    double max_abs_A = 0;
+    for (size_t i = 0; i < matrix_A.size(); ++i) {
+        max_abs_A = std::max(max_abs_A, std::abs(matrix_A.data[i]));
+    }
+    return Factorization(decompose_lu(matrix_A, context), max_abs_A);
+}
+
+SolveResult SystemSolver::solve(ResultSink &sink, const Factorization &factorization,
+                                const std::vector<double> &vector_b) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Solution solution = factorization.solve(vector_b);
+    SolveResult result;
+    result.rank = factorization.get_rank();
+    if (solution.exists) {
+        result.set_solution(std::move(solution.particular_solution), factorization.get_kernel());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timings.substitution_ms = to_fractional_ms(end - start);
+    sink.write_result(result);
+
+    end = std::chrono::high_resolution_clock::now();
+    result.timings.total_ms = to_fractional_ms(end - start);
+    sink.write_time(to_ms(end - start).count());
+    return result;
+}
+
+void SystemSolver::backward_substitution(const Matrix &matrix_U, const EchelonStructure &echelon, Matrix &rhs,
+                                         Matrix &solutions, const int &first_column, const int &last_column) {
+    ScopedTimer timer(Phase::SUBSTITUTION);
+    const std::vector<int> &pivots_columns = echelon.pivots_columns;
+    const int rank = echelon.rank();
+    const int rhs_count = last_column - first_column;
+    if (rhs_count <= 0) return;
+
+    for (int block_end = rank; block_end > 0; block_end -= SUBSTITUTION_BLOCK_SIZE) {
+        const int block_begin = std::max(0, block_end - SUBSTITUTION_BLOCK_SIZE);
+        const int column_begin = pivots_columns[block_begin];
+        // the last block owns also the non pivot columns behind the last pivot
+        const int column_end = block_end < rank ? pivots_columns[block_end] : solutions.height;
+
+        // solve the diagonal block, columns behind it are already accounted in rhs
+        for (int k = block_end - 1; k >= block_begin; --k) {
+            const double *row_U = &matrix_U.field(0, k);
+            double *row_x = &solutions.field(first_column, pivots_columns[k]);
+            double *row_rhs = &rhs.field(first_column, k);
+            for (int x = pivots_columns[k] + 1; x < column_end; ++x) {
+                const double u = row_U[x];
+                if (u == 0) continue;
+                const double *solved = &solutions.field(first_column, x);
+                for (int c = 0; c < rhs_count; ++c) {
+                    row_rhs[c] -= u * solved[c];
+                }
+            }
+            const double pivot = row_U[pivots_columns[k]];
+            for (int c = 0; c < rhs_count; ++c) {
+                row_x[c] = row_rhs[c] / pivot;
+            }
+        }
+
+        // update the rows above the block at once
+        if (block_begin > 0) {
+            GemmEngine::multiply_add(block_begin, rhs_count, column_end - column_begin, -1.0,
+                                     &matrix_U.field(column_begin, 0), matrix_U.width,
+                                     &solutions.field(first_column, column_begin), solutions.width,
+                                     &rhs.field(first_column, 0), rhs.width);
+        }
+    }
+}
+
+void SystemSolver::backward_substitution(const SparseMatrix &matrix_U, const EchelonStructure &echelon,
+                                         Matrix &rhs, Matrix &solutions, const int &first_column,
+                                         const int &last_column) {
+    ScopedTimer timer(Phase::SUBSTITUTION);
+    const int rhs_count = last_column - first_column;
+    if (rhs_count <= 0) return;
+
+    for (int k = echelon.rank() - 1; k >= 0; --k) {
+        double *row_rhs = &rhs.field(first_column, k);
+        // elements of the row are sorted, the first one is the pivot
+        const int first = matrix_U.offsets[k];
+        for (int i = first + 1; i < matrix_U.offsets[k + 1] && matrix_U.indexes[i] < solutions.height; ++i) {
+            const double u = matrix_U.values[i];
+            const double *solved = &solutions.field(first_column, matrix_U.indexes[i]);
+            for (int c = 0; c < rhs_count; ++c) {
+                row_rhs[c] -= u * solved[c];
             }
         }
+        double *row_x = &solutions.field(first_column, echelon.pivots_columns[k]);
+        for (int c = 0; c < rhs_count; ++c) {
+            row_x[c] = row_rhs[c] / matrix_U.values[first];
+        }
+    }
+}
+
+template<typename T>
+void SystemSolver::backward_substitution(const BasicMatrix<T> &matrix_U, const EchelonStructure &echelon,
+                                         BasicMatrix<T> &rhs, BasicMatrix<T> &solutions, const int &first_column,
+                                         const int &last_column) {
+    ScopedTimer timer(Phase::SUBSTITUTION);
+    const std::vector<int> &pivots_columns = echelon.pivots_columns;
+    const int rhs_count = last_column - first_column;
+    if (rhs_count <= 0) return;
+
+    for (int k = echelon.rank() - 1; k >= 0; --k) {
+        const T *row_U = &matrix_U.field(0, k);
+        T *row_rhs = &rhs.field(first_column, k);
+        for (int x = pivots_columns[k] + 1; x < solutions.height; ++x) {
+            const T u = row_U[x];
+            if (u == T(0)) continue;
+            ScalarKernels::subtract_scaled(row_rhs, &solutions.field(first_column, x), u, rhs_count);
+        }
+        T *row_x = &solutions.field(first_column, pivots_columns[k]);
+        const T pivot = row_U[pivots_columns[k]];
+        for (int c = 0; c < rhs_count; ++c) {
+            row_x[c] = row_rhs[c] / pivot;
+        }
     }
-    return std::make_pair(pivots_column_indexes, pivots_row_indexes);
 }
+
+template BasicSolveResult<float> SystemSolver::solve_with_method<float>(const BasicMatrix<float> &,
+                                                                        const SolverContext &);
+
+template BasicSolveResult<long double>
+SystemSolver::solve_with_method<long double>(const BasicMatrix<long double> &, const SolverContext &);
+
+template BasicSolveResult<std::complex<double>>
+SystemSolver::solve_with_method<std::complex<double>>(const BasicMatrix<std::complex<double>> &,
+                                                      const SolverContext &);
+
+template BasicSolveResult<float> SystemSolver::solve_with_method<float>(ResultSink &, const BasicMatrix<float> &,
+                                                                        const SolverContext &);
+
+template BasicSolveResult<long double>
+SystemSolver::solve_with_method<long double>(ResultSink &, const BasicMatrix<long double> &,
+                                             const SolverContext &);
+
+template BasicSolveResult<std::complex<double>>
+SystemSolver::solve_with_method<std::complex<double>>(ResultSink &, const BasicMatrix<std::complex<double>> &,
+                                                      const SolverContext &);
+
+template BasicSolveResult<float> SystemSolver::solve<float>(ResultSink &, const BasicMatrix<float> &,
+                                                            const SolverContext &);
+
+template BasicSolveResult<long double> SystemSolver::solve<long double>(ResultSink &, const BasicMatrix<long double> &,
+                                                                        const SolverContext &);
+
+template BasicSolveResult<std::complex<double>>
+SystemSolver::solve<std::complex<double>>(ResultSink &, const BasicMatrix<std::complex<double>> &,
+                                          const SolverContext &);
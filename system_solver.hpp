@@ -8,58 +8,309 @@
 #include <vector>
 
 #include "matrix.hpp"
+#include "lu_decomposition.hpp"
+#include "echelon_structure.hpp"
+#include "factorization.hpp"
+#include "sparse_matrix.hpp"
+#include "iterative_solver.hpp"
+#include "out_of_core.hpp"
+#include "qr_decomposition.hpp"
+#include "result_sink.hpp"
+#include "solve_result.hpp"
+#include "solver_context.hpp"
+
+/**
+ * Constant representing number of operations under which the solver does not split the work between threads.
+ */
+#define PARALLEL_WORK_THRESHOLD 32768LL
+
+/**
+ * Constant representing number of pivot rows processed together by the blocked backward substitution.
+ */
+#define SUBSTITUTION_BLOCK_SIZE 64
+
+/**
+ * Constant representing density (ratio of non-zero elements) under which the system is solved as sparse.
+ */
+#define SPARSE_DENSITY_THRESHOLD 0.05
+
+/**
+ * Constant representing number of elements under which the system is always solved as dense.
+ */
+#define SPARSE_SIZE_THRESHOLD 4096
 
 /**
  * Class responsible for solving the system of linear equations.
  */
 class SystemSolver {
 private:
+    friend class Factorization;
+
+    friend class Benchmark;
+
     /**
-     * Shuffles the given matrix, so it has rows starting with 0 at the bottom.
+     * Performs LU decomposition with partial pivoting for the given matrix.
      *
-     * @param matrix matrix to be shuffled
+     * @param matrix matrix to be decomposed
+     * @param context settings of the solve, the decomposition uses its number of threads
+     * @return LUDecomposition compact factors with the row permutation and pivot columns
      */
-    static void shuffle_zero_rows(Matrix &matrix);
+    static LUDecomposition decompose_lu(const Matrix &matrix, const SolverContext &context);
 
     /**
-     * Performs LU decomposition for the given matrix.
+     * Solves U * X = R for the given columns of X with blocked backward substitution.
+     * <p>
+     * Pivot rows are processed in blocks, the block is solved directly and the rows above it are updated
+     * with one matrix multiplication. Non pivot variables are not computed, their rows of X have to be set before.
      *
-     * @param matrix matrix to be decomposed
-     * @return std::pair of lower triangular matrix (first) and upper triangular matrix (second)
+     * @param matrix_U upper triangular (row echelon) matrix, k-th pivot has to be on k-th row,
+     * columns behind the last unknown (vector b of augmented matrix) are ignored
+     * @param echelon positions of the pivots in matrix_U
+     * @param rhs matrix R, row k holds right-hand sides of k-th pivot row, it is overwritten during the computation
+     * @param solutions matrix X with one row for each unknown and the same width as rhs
+     * @param first_column first column of X to be computed
+     * @param last_column column after the last column of X to be computed
+     */
+    static void backward_substitution(const Matrix &matrix_U, const EchelonStructure &echelon, Matrix &rhs,
+                                      Matrix &solutions, const int &first_column, const int &last_column);
+
+    /**
+     * Solves U * X = R for the given columns of X with backward substitution over the sparse rows of U.
+     * Non pivot variables are not computed, their rows of X have to be set before.
+     *
+     * @param matrix_U upper triangular (row echelon) matrix in CSR format, k-th pivot has to be on k-th row,
+     * columns behind the last unknown (vector b of augmented matrix) are ignored
+     * @param echelon positions of the pivots in matrix_U
+     * @param rhs matrix R, row k holds right-hand sides of k-th pivot row, it is overwritten during the computation
+     * @param solutions matrix X with one row for each unknown and the same width as rhs
+     * @param first_column first column of X to be computed
+     * @param last_column column after the last column of X to be computed
+     */
+    static void backward_substitution(const SparseMatrix &matrix_U, const EchelonStructure &echelon,
+                                      Matrix &rhs, Matrix &solutions, const int &first_column,
+                                      const int &last_column);
+
+    /**
+     * Solves U * X = R for the given columns of X of the other scalar types with backward substitution,
+     * GemmEngine multiplies only doubles, so the pivot rows are processed one by one.
+     * Non pivot variables are not computed, their rows of X have to be set before.
+     *
+     * @tparam T type of the elements
+     * @param matrix_U upper triangular (row echelon) matrix, k-th pivot has to be on k-th row,
+     * columns behind the last unknown (vector b of augmented matrix) are ignored
+     * @param echelon positions of the pivots in matrix_U
+     * @param rhs matrix R, row k holds right-hand sides of k-th pivot row, it is overwritten during the computation
+     * @param solutions matrix X with one row for each unknown and the same width as rhs
+     * @param first_column first column of X to be computed
+     * @param last_column column after the last column of X to be computed
      */
-    static std::pair<Matrix, Matrix> decompose_lu(const Matrix &matrix);
+    template<typename T>
+    static void backward_substitution(const BasicMatrix<T> &matrix_U, const EchelonStructure &echelon,
+                                      BasicMatrix<T> &rhs, BasicMatrix<T> &solutions, const int &first_column,
+                                      const int &last_column);
 
     /**
-     * Gets the vector x from Ax = b with using backward substitution.
+     * Solves the given square augmented matrix with the iterative method of the context
+     * and writes the convergence and the solution to the sink.
      *
-     * @param matrix_U upper triangular matrix
-     * @param result_vector vector of the desired solution
-     * @param pivots_column_indexes column indexes of pivots in matrix_U
-     * @param pivots_row_indexes row indexes of pivots in matrix_U
-     * @param j used for finding kernel basis, determines on which non pivot field 1 is inserted
-     * @return searched vector x
+     * @tparam MatrixType Matrix or SparseMatrix
+     * @param sink sink the details and the result are written to
+     * @param matrix square augmented matrix of the linear system
+     * @param context settings of the solve with the iterative method, preconditioner, tolerance and iteration limits
+     * @return SolveResult of the system, the status is NOT_CONVERGED if the method did not converge
      */
-    static std::vector<double> backward_substitution(const Matrix &matrix_U, const std::vector<double> &result_vector,
-                                                     const std::vector<double> &pivots_column_indexes,
-                                                     const std::vector<double> &pivots_row_indexes,
-                                                     const int &j = -1);
+    template<typename MatrixType>
+    static SolveResult solve_iterative_matrix(ResultSink &sink, const MatrixType &matrix, const SolverContext &context);
 
     /**
-     * Gets pair of column and row indexes of the pivots in the given upper triangular matrix.
+     * Finds the particular solution and kernel basis from the row echelon augmented matrix.
      *
-     * @param matrix_U upper triangular matrix to find pivot indexes in
-     * @return std::pair of pivot column indexes (first) and pivot row indexes (second)
+     * @tparam MatrixType BasicMatrix of any scalar type or SparseMatrix in CSR format
+     * @param matrix_U upper triangular (row echelon) augmented matrix, k-th pivot has to be on k-th row,
+     * only the elements right of the pivots are read, so the compact LU factors can be passed as well
+     * @param echelon positions of the pivots in matrix_U, the kernel basis vectors get 1 on its free columns
+     * @param context settings of the solve, the substitution uses its number of threads
+     * @return SolveResult with the status, the rank, the particular solution and the kernel basis
      */
-    static std::pair<std::vector<double>, std::vector<double>> get_pivot_indexes(const Matrix &matrix_U);
+    template<typename MatrixType>
+    static BasicSolveResult<typename MatrixType::value_type> solve_echelon(const MatrixType &matrix_U, const EchelonStructure &echelon,
+                                     const SolverContext &context);
 
 public:
     /**
-     * Solves the given linear system's augmented matrix and prints the solution to the output stream.
+     * Solves the given linear system's augmented matrix with the method of the context without any output.
+     * This is the entry point of the library, the timings of the result are filled.
+     *
+     * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return SolveResult of the system
+     */
+    static SolveResult solve_with_method(const Matrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given linear system's augmented matrix with the method of the context
+     * and writes the solution to the sink.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return SolveResult of the system
+     */
+    static SolveResult solve_with_method(ResultSink &sink, const Matrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given sparse linear system's augmented matrix with the method of the context and writes
+     * the solution to the sink. The elimination and the iterative methods work on the sparse matrix directly,
+     * the other methods solve its dense copy.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented sparse matrix of the linear system
+     * @param context settings of the solve
+     * @return SolveResult of the system
+     */
+    static SolveResult solve_with_method(ResultSink &sink, const SparseMatrix &matrix,
+                                         const SolverContext &context);
+
+    /**
+     * Solves the given linear system's augmented matrix of the other scalar type without any output.
+     * Instantiated for float, long double and std::complex<double>.
      *
-     * @param ostream output stream to write to
+     * @tparam T type of the elements
      * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return BasicSolveResult of the system
+     */
+    template<typename T>
+    static BasicSolveResult<T> solve_with_method(const BasicMatrix<T> &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given linear system's augmented matrix of the other scalar type and writes the solution
+     * to the sink. Only the elimination is implemented for these types, the other methods write a message
+     * and fall back to it. Instantiated for float, long double and std::complex<double>.
+     *
+     * @tparam T type of the elements
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return BasicSolveResult of the system
+     */
+    template<typename T>
+    static BasicSolveResult<T> solve_with_method(ResultSink &sink, const BasicMatrix<T> &matrix,
+                                                 const SolverContext &context);
+
+    /**
+     * Factorizes matrix A of the linear system, so the system can be solved for many vectors b.
+     *
+     * @param matrix matrix A of the linear system, vector b is dropped if the matrix is augmented
+     * @param context settings of the solve, the decomposition uses its number of threads
+     * @return Factorization of the matrix A
+     */
+    static Factorization factor(const Matrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the factorized linear system for the given vector b and writes the solution to the sink.
+     *
+     * @param sink sink the result is written to
+     * @param factorization factorized matrix A of the linear system
+     * @param vector_b right-hand side of the system
+     * @return SolveResult of the system
+     */
+    static SolveResult solve(ResultSink &sink, const Factorization &factorization,
+                             const std::vector<double> &vector_b);
+
+    /**
+     * Solves the given linear system's augmented matrix and writes the solution to the sink.
+     * Large systems with density under SPARSE_DENSITY_THRESHOLD are solved as sparse.
+     * Matrix U is extracted from the factors only if the sink prints the details.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return SolveResult of the system
+     */
+    static SolveResult solve(ResultSink &sink, const Matrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given linear system's augmented matrix of the other scalar type by the elimination
+     * and writes the solution to the sink. The matrix is always decomposed by decompose_in_place, whose row updates
+     * are vectorized for float and std::complex<double>. Instantiated for float, long double
+     * and std::complex<double>.
+     *
+     * @tparam T type of the elements
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return BasicSolveResult of the system
+     */
+    template<typename T>
+    static BasicSolveResult<T> solve(ResultSink &sink, const BasicMatrix<T> &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given square linear system's augmented matrix with iterative method
+     * and writes the solution to the sink.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix square augmented matrix of the linear system
+     * @param context settings of the solve with the iterative method, preconditioner, tolerance and iteration limits
+     * @return SolveResult of the system, the status is NOT_CONVERGED if the method did not converge
+     */
+    static SolveResult solve_iterative(ResultSink &sink, const Matrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given square sparse linear system's augmented matrix with iterative method
+     * and writes the solution to the sink. The matrix stays sparse, the iterations use only its products.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix square augmented sparse matrix of the linear system
+     * @param context settings of the solve with the iterative method, preconditioner, tolerance and iteration limits
+     * @return SolveResult of the system, the status is NOT_CONVERGED if the method did not converge
+     */
+    static SolveResult solve_iterative(ResultSink &sink, const SparseMatrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given linear system's augmented matrix with QR decomposition with column pivoting
+     * and writes the rank and the solution to the sink. The particular solution has the smallest norm
+     * and the basis of the kernel is orthonormal.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return SolveResult of the system
+     */
+    static SolveResult solve_qr(ResultSink &sink, const Matrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the given square linear system's augmented matrix with mixed precision LU and iterative refinement
+     * and writes the solution to the sink. Other systems are solved by solve.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented matrix of the linear system
+     * @param context settings of the solve
+     * @return SolveResult of the system
+     */
+    static SolveResult solve_mixed_precision(ResultSink &sink, const Matrix &matrix, const SolverContext &context);
+
+    /**
+     * Solves the square regular system from the dense binary file with the out-of-core solver, the matrix
+     * is never loaded to the memory as a whole. Writes the solution to the sink.
+     *
+     * @param sink sink the details and the result are written to
+     * @param binary_path path to the dense binary file with the augmented matrix
+     * @param settings memory budget and path to the scratch file
+     * @return SolveResult of the system
+     */
+    static SolveResult solve_out_of_core(ResultSink &sink, const std::string &binary_path,
+                                         const OutOfCoreSettings &settings);
+
+    /**
+     * Solves the given sparse linear system's augmented matrix and writes the solution to the sink.
+     *
+     * @param sink sink the details and the result are written to
+     * @param matrix augmented sparse matrix of the linear system
+     * @param context settings of the solve
+     * @return SolveResult of the system
      */
-    static void solve(std::ostream &ostream, const Matrix &matrix);
+    static SolveResult solve(ResultSink &sink, const SparseMatrix &matrix, const SolverContext &context);
 };
 
 #endif //LINEAR_SYSTEM_SOLVER_SYSTEM_SOLVER_HPP
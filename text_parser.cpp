@@ -0,0 +1,437 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "text_parser.hpp"
+#include "utils.hpp"
+#include "statistics.hpp"
+
+namespace {
+    /**
+     * Powers of ten exactly representable in double.
+     */
+    const double POWERS_OF_TEN[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const uint64_t MAX_EXACT_MANTISSA = 1ULL << 53u;
+
+    /**
+     * Converts mantissa * 10^exponent in long double with 64-bit mantissa. Mantissas up to 19 digits and powers
+     * of ten up to 10^27 are exact there, so the only error is the rounding of the one operation. Rounding
+     * the result to double gives the correctly rounded value unless the long double result lies next to
+     * the midpoint of two doubles (the lowest 11 of the 64 bits are 0x400), such values return false.
+     */
+    bool convert_extended(uint64_t mantissa, int exponent, double &value) {
+#if LDBL_MANT_DIG == 64
+        static const long double POWERS[] = {
+                1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L, 1e11L, 1e12L, 1e13L,
+                1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+        };
+        if (exponent < -27 || exponent > 27) {
+            return false;
+        }
+        long double result = static_cast<long double>(mantissa);
+        result = exponent < 0 ? result / POWERS[-exponent] : result * POWERS[exponent];
+        int binary_exponent;
+        auto bits = static_cast<uint64_t>(std::ldexp(std::frexp(result, &binary_exponent), 64));
+        unsigned low_bits = bits & 0x7FFu;
+        if (low_bits >= 0x3FFu && low_bits <= 0x401u) {
+            return false;
+        }
+        value = static_cast<double>(result);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    inline bool is_digit(char c) {
+        return static_cast<unsigned>(c - '0') < 10u;
+    }
+
+    inline bool is_blank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline bool is_separator(char c) {
+        return is_blank(c) || c == '\n';
+    }
+
+    inline void skip_blanks(const char *&position, const char *end) {
+        while (position != end && is_blank(*position)) {
+            ++position;
+        }
+    }
+
+    /**
+     * Converts the whole token with strtod, the token is copied since the mapped file is not null terminated.
+     */
+    bool parse_slow(const char *&position, const char *end, double &value) {
+        const char *token_end = position;
+        while (token_end != end && !is_separator(*token_end)) {
+            ++token_end;
+        }
+        std::string token(position, token_end);
+        char *parsed_end;
+        value = std::strtod(token.c_str(), &parsed_end);
+        if (token.empty() || parsed_end != token.c_str() + token.size()) {
+            return false;
+        }
+        position = token_end;
+        return true;
+    }
+
+    int parse_dimension(const char *&position, const char *end, int line) {
+        skip_blanks(position, end);
+        long long value = 0;
+        const char *start = position;
+        while (position != end && is_digit(*position) && value <= 1LL << 31) {
+            value = value * 10 + (*position - '0');
+            ++position;
+        }
+        if (position == start || value < 1 || value > 1LL << 30 || (position != end && !is_separator(*position))) {
+            throw std::domain_error("Invalid matrix dimensions on line " + std::to_string(line) + ".");
+        }
+        return static_cast<int>(value);
+    }
+
+    /**
+     * Struct representing the first line of the file.
+     */
+    struct Header {
+        int width;
+        int height;
+        bool typed;
+        ScalarType type;
+    };
+
+    /**
+     * Parses the header and moves the position to the end of its line.
+     */
+    Header parse_header(const char *&position, const char *end, int &line) {
+        // skip empty lines before the header
+        skip_blanks(position, end);
+        while (position != end && *position == '\n') {
+            ++position;
+            ++line;
+            skip_blanks(position, end);
+        }
+        Header header{};
+        header.width = parse_dimension(position, end, line);
+        header.height = parse_dimension(position, end, line);
+        skip_blanks(position, end);
+        if (position != end && *position != '\n') {
+            const char *name_end = position;
+            while (name_end != end && !is_separator(*name_end)) {
+                ++name_end;
+            }
+            try {
+                header.type = ScalarTypes::parse_name(std::string(position, name_end));
+            } catch (std::domain_error &) {
+                throw std::domain_error("Unexpected characters after the dimensions on line "
+                                        + std::to_string(line) + ".");
+            }
+            header.typed = true;
+            position = name_end;
+            skip_blanks(position, end);
+            if (position != end && *position != '\n') {
+                throw std::domain_error("Unexpected characters after the scalar type on line "
+                                        + std::to_string(line) + ".");
+            }
+        }
+        return header;
+    }
+
+    const char *find_token_end(const char *position, const char *end) {
+        while (position != end && !is_separator(*position)) {
+            ++position;
+        }
+        return position;
+    }
+
+    /**
+     * Converts the whole string with strtod, the empty string and the trailing characters are rejected.
+     */
+    bool parse_part(const std::string &text, double &value) {
+        char *parsed_end;
+        value = std::strtod(text.c_str(), &parsed_end);
+        return !text.empty() && parsed_end == text.c_str() + text.size();
+    }
+
+    /**
+     * Parses one complex number, the forms are "a", "a+bi", "a-bi", "bi", "i" and "(a,b)".
+     */
+    bool parse_complex(const std::string &token, std::complex<double> &value) {
+        double real = 0;
+        double imaginary = 0;
+        if (token.size() > 2 && token.front() == '(' && token.back() == ')') {
+            size_t comma = token.find(',');
+            if (comma == std::string::npos || !parse_part(token.substr(1, comma - 1), real)
+                || !parse_part(token.substr(comma + 1, token.size() - comma - 2), imaginary)) {
+                return false;
+            }
+        } else if (!token.empty() && token.back() == 'i') {
+            // the imaginary part starts at the last sign which is not the sign of the exponent
+            size_t split = 0;
+            for (size_t i = token.size() - 1; i > 0; --i) {
+                if ((token[i] == '+' || token[i] == '-') && token[i - 1] != 'e' && token[i - 1] != 'E') {
+                    split = i;
+                    break;
+                }
+            }
+            if (split > 0 && !parse_part(token.substr(0, split), real)) {
+                return false;
+            }
+            std::string part = token.substr(split, token.size() - split - 1);
+            if (part.empty() || part == "+" || part == "-") {
+                part += "1";
+            }
+            if (!parse_part(part, imaginary)) {
+                return false;
+            }
+        } else if (!parse_part(token, real)) {
+            return false;
+        }
+        value = std::complex<double>(real, imaginary);
+        return true;
+    }
+
+    bool read_number(const char *&position, const char *end, double &value) {
+        return TextMatrixParser::parse_double(position, end, value);
+    }
+
+    bool read_number(const char *&position, const char *end, float &value) {
+        double parsed;
+        if (!TextMatrixParser::parse_double(position, end, parsed)) {
+            return false;
+        }
+        value = static_cast<float>(parsed);
+        return true;
+    }
+
+    bool read_number(const char *&position, const char *end, long double &value) {
+        const char *token_end = find_token_end(position, end);
+        std::string token(position, token_end);
+        char *parsed_end;
+        value = std::strtold(token.c_str(), &parsed_end);
+        if (token.empty() || parsed_end != token.c_str() + token.size()) {
+            return false;
+        }
+        position = token_end;
+        return true;
+    }
+
+    bool read_number(const char *&position, const char *end, std::complex<double> &value) {
+        const char *token_end = find_token_end(position, end);
+        if (!parse_complex(std::string(position, token_end), value)) {
+            return false;
+        }
+        position = token_end;
+        return true;
+    }
+}
+
+double ParseStats::get_throughput() const {
+    return microseconds > 0 ? static_cast<double>(bytes) / microseconds : 0;
+}
+
+bool TextMatrixParser::parse_double(const char *&position, const char *end, double &value) {
+    const char *p = position;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    for (; p != end && is_digit(*p); ++p) {
+        has_digits = true;
+        if (significant_digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            significant_digits += mantissa != 0;
+        } else {
+            ++exponent; // the digit does not fit, only its order is kept
+            significant_digits++;
+        }
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && is_digit(*p); ++p) {
+            has_digits = true;
+            if (significant_digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                significant_digits += mantissa != 0;
+                --exponent;
+            } else {
+                significant_digits++;
+            }
+        }
+    }
+    if (has_digits && p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative_exponent = false;
+        if (p != end && (*p == '-' || *p == '+')) {
+            negative_exponent = *p == '-';
+            ++p;
+        }
+        if (p == end || !is_digit(*p)) {
+            return parse_slow(position, end, value);
+        }
+        int explicit_exponent = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            if (explicit_exponent < 100000) {
+                explicit_exponent = explicit_exponent * 10 + (*p - '0');
+            }
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (!has_digits || (p != end && !is_separator(*p)) || significant_digits > 19) {
+        return parse_slow(position, end, value);
+    }
+    double result;
+    if (mantissa <= MAX_EXACT_MANTISSA && exponent >= -22 && exponent <= 22) {
+        // exact conversion, both the mantissa and the power of ten are exact doubles
+        result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+    } else if (!convert_extended(mantissa, exponent, result)) {
+        return parse_slow(position, end, value);
+    }
+    value = negative ? -result : result;
+    position = p;
+    return true;
+}
+
+Matrix TextMatrixParser::parse(const char *begin, const char *end) {
+    return parse_as<double>(begin, end);
+}
+
+template<typename T>
+BasicMatrix<T> TextMatrixParser::parse_as(const char *begin, const char *end) {
+    ScopedTimer timer(Phase::PARSE);
+    const char *position = begin;
+    int line = 1;
+
+    Header header = parse_header(position, end, line);
+    if (header.typed && header.type != ScalarTraits<T>::get_type()) {
+        throw std::domain_error("File holds elements of type " + ScalarTypes::get_name(header.type) + ", expected "
+                                + ScalarTypes::get_name(ScalarTraits<T>::get_type()) + ".");
+    }
+    const int width = header.width;
+    const int height = header.height;
+
+    BasicMatrix<T> matrix(width, height, true);
+
+    for (int y = 0; y < height; ++y) {
+        // move to the next non-empty line
+        skip_blanks(position, end);
+        while (position != end && *position == '\n') {
+            ++position;
+            ++line;
+            skip_blanks(position, end);
+        }
+        if (position == end) {
+            throw std::domain_error("File has " + std::to_string(y) + " rows, header says "
+                                    + std::to_string(height) + ".");
+        }
+
+        T *row = matrix.data + static_cast<size_t>(width) * y;
+        int count = 0;
+        while (position != end && *position != '\n') {
+            if (count == width) {
+                throw std::domain_error("Line " + std::to_string(line) + " has more than "
+                                        + std::to_string(width) + " values.");
+            }
+            if (!read_number(position, end, row[count])) {
+                throw std::domain_error("Invalid number on line " + std::to_string(line) + ".");
+            }
+            ++count;
+            skip_blanks(position, end);
+        }
+        if (count < width) {
+            throw std::domain_error("Line " + std::to_string(line) + " has " + std::to_string(count)
+                                    + " values, expected " + std::to_string(width) + ".");
+        }
+    }
+
+    // only whitespace can follow the last row
+    while (position != end && is_separator(*position)) {
+        ++position;
+    }
+    if (position != end) {
+        throw std::domain_error("File has more rows than the header says.");
+    }
+
+    return matrix;
+}
+
+Matrix TextMatrixParser::parse_file(const std::string &path, ParseStats &stats) {
+    return parse_file_as<double>(path, stats);
+}
+
+template<typename T>
+BasicMatrix<T> TextMatrixParser::parse_file_as(const std::string &path, ParseStats &stats) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    MappedFile file(path);
+    BasicMatrix<T> matrix = parse_as<T>(file.get_data(), file.get_data() + file.get_size());
+
+    stats.bytes = file.get_size();
+    stats.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start).count();
+    return matrix;
+}
+
+template<typename T>
+bool TextMatrixParser::parse_number(const char *&position, const char *end, T &value) {
+    return read_number(position, end, value);
+}
+
+ScalarType TextMatrixParser::read_scalar_type(const char *begin, const char *end, ScalarType default_type) {
+    int line = 1;
+    Header header = parse_header(begin, end, line);
+    return header.typed ? header.type : default_type;
+}
+
+ScalarType TextMatrixParser::read_scalar_type(const std::string &path, ScalarType default_type) {
+    MappedFile file(path);
+    return read_scalar_type(file.get_data(), file.get_data() + file.get_size(), default_type);
+}
+
+template BasicMatrix<float> TextMatrixParser::parse_as<float>(const char *, const char *);
+
+template BasicMatrix<double> TextMatrixParser::parse_as<double>(const char *, const char *);
+
+template BasicMatrix<long double> TextMatrixParser::parse_as<long double>(const char *, const char *);
+
+template BasicMatrix<std::complex<double>>
+TextMatrixParser::parse_as<std::complex<double>>(const char *, const char *);
+
+template BasicMatrix<float> TextMatrixParser::parse_file_as<float>(const std::string &, ParseStats &);
+
+template BasicMatrix<double> TextMatrixParser::parse_file_as<double>(const std::string &, ParseStats &);
+
+template BasicMatrix<long double> TextMatrixParser::parse_file_as<long double>(const std::string &, ParseStats &);
+
+template BasicMatrix<std::complex<double>>
+TextMatrixParser::parse_file_as<std::complex<double>>(const std::string &, ParseStats &);
+
+template bool TextMatrixParser::parse_number<float>(const char *&, const char *, float &);
+
+template bool TextMatrixParser::parse_number<double>(const char *&, const char *, double &);
+
+template bool TextMatrixParser::parse_number<long double>(const char *&, const char *, long double &);
+
+template bool TextMatrixParser::parse_number<std::complex<double>>(const char *&, const char *,
+                                                                  std::complex<double> &);
@@ -0,0 +1,128 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_TEXT_PARSER_HPP
+#define LINEAR_SYSTEM_SOLVER_TEXT_PARSER_HPP
+
+#include <string>
+
+#include "matrix.hpp"
+#include "scalar_type.hpp"
+
+/**
+ * Struct representing statistics of one parsed file.
+ */
+struct ParseStats {
+    size_t bytes = 0;
+    long long microseconds = 0;
+
+    /**
+     * @return parse throughput in megabytes per second
+     */
+    double get_throughput() const;
+};
+
+/**
+ * Class responsible for parsing matrices from the txt file format.
+ * <p>
+ * The file is mapped to the memory and scanned once, the numbers are converted by hand-written parser
+ * and written straight into the matrix data. Numbers with at most 19 significant digits and small exponent
+ * are converted by one multiplication or division by power of ten in double or extended precision, the rest
+ * (long mantissas, large exponents, results on the rounding midpoint, inf and nan) falls back to strtod,
+ * so every number is rounded correctly.
+ * <p>
+ * The header can name the scalar type after the dimensions (e.g. "3 2 complex"). Float values are parsed as double
+ * and rounded, long double values are converted by strtold. Complex values are written as "a", "a+bi", "a-bi", "bi"
+ * or "(a,b)" without spaces.
+ */
+class TextMatrixParser {
+public:
+    /**
+     * Parses the matrix from the text in memory. The first line holds width, height and optionally the scalar type,
+     * each other line holds one row with width values. Empty lines are skipped.
+     *
+     * @param begin first character of the text
+     * @param end character after the last character of the text
+     * @return augmented Matrix, throws std::domain_error with the line number if the text is malformed
+     * or names other type than double
+     */
+    static Matrix parse(const char *begin, const char *end);
+
+    /**
+     * Parses the matrix with elements of the type T from the text in memory, same as parse.
+     *
+     * @tparam T type of the elements
+     * @param begin first character of the text
+     * @param end character after the last character of the text
+     * @return augmented BasicMatrix, throws std::domain_error with the line number if the text is malformed
+     * or names other type
+     */
+    template<typename T>
+    static BasicMatrix<T> parse_as(const char *begin, const char *end);
+
+    /**
+     * Maps the file to the memory and parses the matrix from it.
+     *
+     * @param path path to the file
+     * @param stats statistics to fill in
+     * @return augmented Matrix, throws std::domain_error if the file cannot be read or is malformed
+     */
+    static Matrix parse_file(const std::string &path, ParseStats &stats);
+
+    /**
+     * Maps the file to the memory and parses the matrix with elements of the type T from it.
+     *
+     * @tparam T type of the elements
+     * @param path path to the file
+     * @param stats statistics to fill in
+     * @return augmented BasicMatrix, throws std::domain_error if the file cannot be read, is malformed
+     * or names other type
+     */
+    template<typename T>
+    static BasicMatrix<T> parse_file_as(const std::string &path, ParseStats &stats);
+
+    /**
+     * Reads the scalar type from the header of the text.
+     *
+     * @param begin first character of the text
+     * @param end character after the last character of the text
+     * @param default_type type of the text which does not name it
+     * @return ScalarType named in the header or the default type, throws std::domain_error for malformed header
+     */
+    static ScalarType read_scalar_type(const char *begin, const char *end, ScalarType default_type);
+
+    /**
+     * Reads the scalar type from the header of the file.
+     *
+     * @param path path to the file
+     * @param default_type type of the file which does not name it
+     * @return ScalarType named in the header or the default type, throws std::domain_error if the file cannot
+     * be read or has malformed header
+     */
+    static ScalarType read_scalar_type(const std::string &path, ScalarType default_type);
+
+    /**
+     * Parses one number from the text.
+     *
+     * @param position first character of the number, moved behind the number
+     * @param end character after the last character of the text
+     * @param value parsed number
+     * @return false if there is no valid number on the position
+     */
+    static bool parse_double(const char *&position, const char *end, double &value);
+
+    /**
+     * Parses one number of the type T from the text in the same form as in the files.
+     *
+     * @tparam T type of the number
+     * @param position first character of the number, moved behind the number
+     * @param end character after the last character of the text
+     * @param value parsed number
+     * @return false if there is no valid number on the position
+     */
+    template<typename T>
+    static bool parse_number(const char *&position, const char *end, T &value);
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_TEXT_PARSER_HPP
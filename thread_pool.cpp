@@ -0,0 +1,128 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#include <map>
+
+#include "thread_pool.hpp"
+
+namespace {
+    /**
+     * Index of the worker running on the current thread, -1 for threads outside of any pool.
+     */
+    thread_local int current_worker_index = -1;
+
+    /**
+     * Pool running on the current thread, nullptr for threads outside of any pool.
+     */
+    thread_local const ThreadPool *current_pool = nullptr;
+}
+
+ThreadPool::ThreadPool(int worker_count) {
+    worker_count = std::max(worker_count, 1);
+    for (int i = 0; i < worker_count; ++i) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    workers.reserve(worker_count);
+    for (int i = 0; i < worker_count; ++i) {
+        workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    sleep_condition.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::get_worker_count() const {
+    return workers.size();
+}
+
+void ThreadPool::push_task(std::function<void()> task) {
+    int index = (current_pool == this) ?
+                current_worker_index :
+                static_cast<int>(next_queue++ % queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        pending_tasks++;
+    }
+    sleep_condition.notify_one();
+}
+
+bool ThreadPool::take_task(int worker_index, std::function<void()> &task) {
+    if (worker_index >= 0) {
+        WorkerQueue &own = *queues[worker_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending_tasks--;
+            return true;
+        }
+    }
+    int count = queues.size();
+    int start = worker_index >= 0 ? worker_index + 1 : 0;
+    for (int i = 0; i < count; ++i) {
+        WorkerQueue &victim = *queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending_tasks--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::run_pending_task() {
+    std::function<void()> task;
+    if (!take_task(current_pool == this ? current_worker_index : -1, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::worker_loop(int worker_index) {
+    current_worker_index = worker_index;
+    current_pool = this;
+    while (true) {
+        std::function<void()> task;
+        if (take_task(worker_index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleep_condition.wait(lock, [this]() { return stopping || pending_tasks > 0; });
+        if (stopping && pending_tasks == 0) {
+            return;
+        }
+    }
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::get_shared(int worker_count) {
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<ThreadPool>> pools;
+    worker_count = std::max(worker_count, 1);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<ThreadPool> &pool = pools[worker_count];
+    if (!pool) {
+        pool = std::make_shared<ThreadPool>(worker_count);
+    }
+    return pool;
+}
+
+int ThreadPool::get_hardware_threads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
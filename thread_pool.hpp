@@ -0,0 +1,185 @@
+//
+// Created by tomanm10 on 17.10.2026.
+//
+
+#ifndef LINEAR_SYSTEM_SOLVER_THREAD_POOL_HPP
+#define LINEAR_SYSTEM_SOLVER_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+/**
+ * Class representing persistent pool of worker threads with work stealing.
+ * <p>
+ * Every worker has its own task queue. Worker takes tasks from the back of its own queue and when the queue
+ * is empty, it steals tasks from the front of the queues of other workers. Tasks submitted from outside
+ * of the pool are distributed among the queues round-robin.
+ */
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_condition;
+    std::atomic<int> pending_tasks{0};
+    std::atomic<unsigned> next_queue{0};
+    bool stopping = false;
+
+    /**
+     * Main loop of the worker thread.
+     *
+     * @param worker_index index of the worker and its queue
+     */
+    void worker_loop(int worker_index);
+
+    /**
+     * Takes one task from the queue of the given worker or steals it from other queues.
+     *
+     * @param worker_index index of the queue to take from first, -1 for thread outside of the pool
+     * @param task task taken from the queue
+     * @return true if some task was taken, false otherwise
+     */
+    bool take_task(int worker_index, std::function<void()> &task);
+
+    /**
+     * Puts the task into one of the queues and wakes up sleeping worker.
+     *
+     * @param task task to be executed by the pool
+     */
+    void push_task(std::function<void()> task);
+
+public:
+    /**
+     * Starts the given number of workers.
+     *
+     * @param worker_count number of worker threads, at least one is started
+     */
+    explicit ThreadPool(int worker_count);
+
+    /**
+     * Finishes all queued tasks and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &rhs) = delete;
+
+    ThreadPool &operator=(const ThreadPool &rhs) = delete;
+
+    /**
+     * @return number of worker threads in the pool
+     */
+    int get_worker_count() const;
+
+    /**
+     * Executes one queued task on the calling thread, if there is any.
+     * Used by threads waiting for results, so the waiting does not block the pool.
+     *
+     * @return true if some task was executed, false otherwise
+     */
+    bool run_pending_task();
+
+    /**
+     * Submits task to be executed by the pool.
+     *
+     * @tparam F callable without parameters
+     * @param task task to be executed
+     * @return std::future with the result of the task
+     */
+    template<typename F>
+    auto submit(F &&task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        push_task([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    /**
+     * Calls body(chunk_begin, chunk_end) for chunks covering the range [begin, end) in parallel.
+     * The calling thread processes chunks as well and the function returns when all chunks are done.
+     *
+     * @tparam F callable with two int parameters
+     * @param begin first index of the range
+     * @param end index after the last index of the range
+     * @param grain minimal number of indexes in one chunk, so small tasks are grouped together
+     * @param body function processing one chunk
+     */
+    template<typename F>
+    void parallel_for(int begin, int end, int grain, F &&body) {
+        if (end <= begin) return;
+        int count = end - begin;
+        int chunk = std::max(std::max(grain, 1), count / (4 * get_worker_count()));
+        int chunks = (count + chunk - 1) / chunk;
+        if (chunks == 1) {
+            body(begin, end);
+            return;
+        }
+
+        struct State {
+            std::atomic<int> next_chunk{0};
+            std::atomic<int> done_chunks{0};
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr exception;
+        };
+        auto state = std::make_shared<State>();
+        std::function<void(int, int)> chunk_body = body;
+
+        auto process_chunks = [state, chunk_body, begin, end, chunk, chunks]() {
+            int c;
+            while ((c = state->next_chunk++) < chunks) {
+                try {
+                    chunk_body(begin + c * chunk, std::min(end, begin + (c + 1) * chunk));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->exception) state->exception = std::current_exception();
+                }
+                if (++state->done_chunks == chunks) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->done.notify_all();
+                }
+            }
+        };
+
+        int helpers = std::min(chunks - 1, get_worker_count());
+        for (int i = 0; i < helpers; ++i) {
+            push_task(process_chunks);
+        }
+        process_chunks();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&state, chunks]() { return state->done_chunks == chunks; });
+        if (state->exception) {
+            std::rethrow_exception(state->exception);
+        }
+    }
+
+    /**
+     * Gets pool shared by the whole program, the pool lives across solves. One pool is kept for each requested
+     * number of workers, so solves with different numbers of threads can alternate without starting new threads.
+     *
+     * @param worker_count requested number of worker threads
+     * @return shared pool
+     */
+    static std::shared_ptr<ThreadPool> get_shared(int worker_count);
+
+    /**
+     * @return number of threads the hardware can run concurrently (at least 1)
+     */
+    static int get_hardware_threads();
+};
+
+#endif //LINEAR_SYSTEM_SOLVER_THREAD_POOL_HPP
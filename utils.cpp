@@ -3,11 +3,21 @@
 //
 
 #include <dirent.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <stdexcept>
 #include <algorithm>
 
 #include "utils.hpp"
 
 std::ifstream FileReader::choose_file(std::ostream &ostream, std::istream &istream) {
+    return open_file(choose_file_path(ostream, istream));
+}
+
+std::string FileReader::choose_file_path(std::ostream &ostream, std::istream &istream) {
     std::string chosen_file;
     bool is_read = false;
     while (!is_read) {
@@ -18,33 +28,88 @@ std::ifstream FileReader::choose_file(std::ostream &ostream, std::istream &istre
             is_read = true;
         }
     }
-    return read_file(chosen_file);
+    return get_path(chosen_file);
 }
 
 std::vector<std::string> FileReader::get_files() {
+    return list_files(INPUTS_DIR);
+}
+
+void FileReader::print_files(std::ostream &ostream) {
+    ostream << "Files to choose from (write the file name with .txt as well):" << std::endl;
+    for (auto &file : get_files()) {
+        ostream << file << " ";
+    }
+    ostream << std::endl;
+}
+
+std::string FileReader::get_path(const std::string &file_name) {
+    return INPUTS_DIR + file_name;
+}
+
+std::ifstream FileReader::open_file(const std::string &path) {
+    std::ifstream infile(path);
+    return infile;
+}
+
+bool FileReader::is_directory(const std::string &path) {
+    struct stat info{};
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+std::vector<std::string> FileReader::list_files(const std::string &directory) {
     std::vector<std::string> files;
-    DIR* dirp = opendir(INPUTS_DIR);
-    struct dirent * dp;
+    DIR *dirp = opendir(directory.c_str());
+    if (dirp == nullptr) {
+        return files;
+    }
+    struct dirent *dp;
     while ((dp = readdir(dirp)) != nullptr) {
         std::string file(dp->d_name);
-        if (file.substr(0, 1) != ".") {
+        if (file.substr(0, 1) != "." && !is_directory(directory + "/" + file)) {
             files.push_back(file);
         }
     }
     closedir(dirp);
 
+    std::sort(files.begin(), files.end());
     return files;
 }
 
-void FileReader::print_files(std::ostream &ostream) {
-    ostream << "Files to choose from (write the file name with .txt as well):" << std::endl;
-    for (auto &file : get_files()) {
-        ostream << file << " ";
+void FileReader::create_directory(const std::string &directory) {
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::domain_error("Failed to create directory " + directory + ".");
     }
-    ostream << std::endl;
 }
 
-std::ifstream FileReader::read_file(std::string &file_name) {
-    std::ifstream infile(INPUTS_DIR + file_name);
-    return infile;
+MappedFile::MappedFile(const std::string &path, bool copy_on_write) : data(nullptr), size(0) {
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::domain_error("Failed to open file " + path + ".");
+    }
+    struct stat info{};
+    if (fstat(descriptor, &info) != 0) {
+        close(descriptor);
+        throw std::domain_error("Failed to open file " + path + ".");
+    }
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0) {
+        int protection = copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *mapping = mmap(nullptr, size, protection, MAP_PRIVATE, descriptor, 0);
+        if (mapping == MAP_FAILED) {
+            close(descriptor);
+            throw std::domain_error("Failed to map file " + path + ".");
+        }
+        // the parsers read the file once from the beginning to the end, the mapped matrices are accessed
+        // in any order, so the kernel only starts reading them ahead in the background
+        madvise(mapping, size, copy_on_write ? MADV_WILLNEED : MADV_SEQUENTIAL);
+        data = static_cast<char *>(mapping);
+    }
+    close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        munmap(data, size);
+    }
 }
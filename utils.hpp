@@ -31,12 +31,10 @@ private:
     static void print_files(std::ostream &ostream);
 
     /**
-     * Opens the file with given file name and returns it as an input stream.
-     *
-     * @param file_name name of the file to be opened
-     * @return input stream from the file with the given name
+     * @param file_name name of the file in directory set by constant INPUTS_DIR
+     * @return path to the file
      */
-    static std::ifstream read_file(std::string &file_name);
+    static std::string get_path(const std::string &file_name);
 
 public:
     /**
@@ -47,6 +45,89 @@ public:
      * @return input stream from file that user chose
      */
     static std::ifstream choose_file(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Lets user choose file the same way as choose_file.
+     *
+     * @param ostream output stream to write information to
+     * @param istream input stream to read from
+     * @return path to the file that user chose
+     */
+    static std::string choose_file_path(std::ostream &ostream, std::istream &istream);
+
+    /**
+     * Opens the file on the given path, which is not limited to the directory INPUTS_DIR.
+     *
+     * @param path path to the file
+     * @return input stream from the file on the given path
+     */
+    static std::ifstream open_file(const std::string &path);
+
+    /**
+     * @param path path to check
+     * @return true if the path points to a directory
+     */
+    static bool is_directory(const std::string &path);
+
+    /**
+     * @param directory path to the directory
+     * @return sorted names of the regular files in the directory, hidden files are skipped
+     */
+    static std::vector<std::string> list_files(const std::string &directory);
+
+    /**
+     * Creates the directory if it does not exist yet.
+     *
+     * @param directory path to the directory, throws std::domain_error if it cannot be created
+     */
+    static void create_directory(const std::string &directory);
+};
+
+/**
+ * Class representing memory mapping of the whole file, the mapping is removed in the destructor.
+ */
+class MappedFile {
+private:
+    char *data;
+    size_t size;
+
+public:
+    /**
+     * Maps the file on the given path, throws std::domain_error if the file cannot be opened or mapped.
+     * <p>
+     * Copy-on-write mapping can be written to, the kernel copies the written pages and the file stays unchanged.
+     *
+     * @param path path to the file
+     * @param copy_on_write true for private writable mapping, false for read-only mapping
+     */
+    explicit MappedFile(const std::string &path, bool copy_on_write = false);
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile();
+
+    /**
+     * @return pointer to the first byte of the file, nullptr for empty file
+     */
+    const char *get_data() const {
+        return data;
+    }
+
+    /**
+     * @return pointer to the first byte of the file, can be written to only in the copy-on-write mapping
+     */
+    char *get_data() {
+        return data;
+    }
+
+    /**
+     * @return size of the file in bytes
+     */
+    size_t get_size() const {
+        return size;
+    }
 };
 
 template <typename TimePoint>
@@ -54,4 +135,9 @@ std::chrono::milliseconds to_ms(TimePoint tp) {
     return std::chrono::duration_cast<std::chrono::milliseconds>(tp);
 }
 
+template <typename Duration>
+double to_fractional_ms(Duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
 #endif //LINEAR_SYSTEM_SOLVER_UTILS_HPP